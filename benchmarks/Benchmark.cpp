@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include <cstdio>
+
+namespace TW::Benchmark {
+
+std::vector<Case>& registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+int runAll(const std::string& filter) {
+    std::printf("%-40s %12s %16s %12s\n", "benchmark", "param", "time/run (us)", "runs");
+    for (const auto& item : registry()) {
+        if (!filter.empty() && item.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        for (auto param : item.params) {
+            State state(param);
+            item.function(state);
+            std::printf("%-40s %12zu %16.2f %12zu\n", item.name.c_str(), param, state.nanosPerRun / 1000.0, state.iterations);
+        }
+    }
+    return 0;
+}
+
+} // namespace TW::Benchmark
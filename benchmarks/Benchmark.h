@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace TW::Benchmark {
+
+/// Timing state passed to a benchmark body, one instance per parameter value.
+class State {
+public:
+    /// Benchmark parameter, e.g. number of inputs.
+    const std::size_t param;
+
+    explicit State(std::size_t param) : param(param) {}
+
+    /// Runs `body` repeatedly for at least `minDuration`, and records the average time of one run.
+    /// Setup done before calling `measure` is not timed.
+    template <typename F>
+    void measure(F&& body, std::chrono::milliseconds minDuration = std::chrono::milliseconds(200)) {
+        using Clock = std::chrono::steady_clock;
+        std::size_t runs = 0;
+        const auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        do {
+            body();
+            ++runs;
+            elapsed = Clock::now() - start;
+        } while (elapsed < minDuration);
+        iterations = runs;
+        nanosPerRun = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(runs);
+    }
+
+    std::size_t iterations = 0;
+    double nanosPerRun = 0;
+};
+
+using Function = std::function<void(State&)>;
+
+struct Case {
+    std::string name;
+    std::vector<std::size_t> params;
+    Function function;
+};
+
+/// All registered benchmarks.
+std::vector<Case>& registry();
+
+/// Registers a benchmark at static initialization time, see `TW_BENCHMARK`.
+struct Registrar {
+    Registrar(std::string name, std::vector<std::size_t> params, Function function) {
+        registry().push_back(Case{std::move(name), std::move(params), std::move(function)});
+    }
+};
+
+/// Runs all benchmarks whose name contains `filter`, and prints the results.
+int runAll(const std::string& filter);
+
+} // namespace TW::Benchmark
+
+#define TW_BENCHMARK_CONCAT_(a, b) a##b
+#define TW_BENCHMARK_CONCAT(a, b) TW_BENCHMARK_CONCAT_(a, b)
+
+/// Defines a benchmark run once for every parameter value, e.g.
+/// `TW_BENCHMARK(BitcoinSign, {1, 10, 100}) { ...; state.measure([&] { ... }); }`
+#define TW_BENCHMARK(name, ...)                                                              \
+    static void TW_BENCHMARK_CONCAT(benchmark_, name)(TW::Benchmark::State & state);         \
+    static const TW::Benchmark::Registrar TW_BENCHMARK_CONCAT(registrar_, name)(             \
+        #name, std::vector<std::size_t> __VA_ARGS__, TW_BENCHMARK_CONCAT(benchmark_, name)); \
+    static void TW_BENCHMARK_CONCAT(benchmark_, name)(TW::Benchmark::State & state)
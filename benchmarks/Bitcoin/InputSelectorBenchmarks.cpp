@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Bitcoin/InputSelector.h"
+#include "Bitcoin/UTXO.h"
+
+#include <cassert>
+#include <random>
+
+namespace TW::Bitcoin {
+
+namespace {
+
+/// `count` UTXOs with pseudo-random amounts between 1'000 and 1'000'000 satoshis.
+UTXOs buildRandomUTXOs(std::size_t count) {
+    std::mt19937_64 random(count);
+    std::uniform_int_distribution<Amount> amounts(1'000, 1'000'000);
+    UTXOs utxos;
+    for (auto i = 0ul; i < count; ++i) {
+        UTXO utxo;
+        utxo.amount = amounts(random);
+        utxos.push_back(utxo);
+    }
+    return utxos;
+}
+
+} // namespace
+
+TW_BENCHMARK(BitcoinInputSelectorSelect, {10, 1'000, 10'000, 100'000}) {
+    const auto utxos = buildRandomUTXOs(state.param);
+    const auto targetValue = static_cast<uint64_t>(InputSelector<UTXO>::sum(utxos) / 3);
+    auto selector = InputSelector<UTXO>(utxos);
+    state.measure([&] {
+        [[maybe_unused]] const auto selected = selector.select(targetValue, 10);
+        assert(!selected.empty());
+    });
+}
+
+TW_BENCHMARK(BitcoinInputSelectorSelectSimple, {10, 1'000, 10'000, 100'000}) {
+    const auto utxos = buildRandomUTXOs(state.param);
+    const auto targetValue = static_cast<int64_t>(InputSelector<UTXO>::sum(utxos) / 3);
+    auto selector = InputSelector<UTXO>(utxos);
+    state.measure([&] {
+        [[maybe_unused]] const auto selected = selector.selectSimple(targetValue, 10);
+        assert(!selected.empty());
+    });
+}
+
+TW_BENCHMARK(BitcoinInputSelectorBranchAndBound, {10, 1'000, 10'000, 100'000}) {
+    const auto utxos = buildRandomUTXOs(state.param);
+    const auto targetValue = static_cast<uint64_t>(InputSelector<UTXO>::sum(utxos) / 3);
+    auto selector = InputSelector<UTXO>(utxos);
+    state.measure([&] {
+        [[maybe_unused]] const auto selected = selector.selectBranchAndBound(targetValue, 10);
+    });
+}
+
+TW_BENCHMARK(BitcoinInputSelectorKnapsack, {10, 1'000, 10'000, 100'000}) {
+    const auto utxos = buildRandomUTXOs(state.param);
+    const auto targetValue = static_cast<uint64_t>(InputSelector<UTXO>::sum(utxos) / 3);
+    auto selector = InputSelector<UTXO>(utxos);
+    state.measure([&] {
+        [[maybe_unused]] const auto selected = selector.selectKnapsack(targetValue, 10);
+        assert(!selected.empty());
+    });
+}
+
+} // namespace TW::Bitcoin
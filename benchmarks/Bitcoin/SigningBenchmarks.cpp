@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Bitcoin/SigHashType.h"
+#include "Bitcoin/Transaction.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <cassert>
+
+namespace TW::Bitcoin {
+
+namespace {
+
+const auto benchmarkKey = PrivateKey(parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866"), TWCurveSECP256k1);
+
+/// Consolidation of `count` P2WPKH UTXOs of the same key into one output.
+SigningInput buildConsolidationInput(std::size_t count) {
+    SigningInput input;
+    input.hashType = hashTypeForCoin(TWCoinTypeBitcoin);
+    input.byteFee = 1;
+    input.useMaxAmount = true;
+    input.toAddress = "bc1qvrt7ukvhvmdny0a3j9k8l8jasx92lrqm30t2u2";
+    input.changeAddress = "bc1qvrt7ukvhvmdny0a3j9k8l8jasx92lrqm30t2u2";
+    input.coinType = TWCoinTypeBitcoin;
+    input.privateKeys.push_back(benchmarkKey);
+
+    const auto pubKeyHash = Hash::sha256ripemd(benchmarkKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes.data(), PublicKey::secp256k1Size);
+    const auto script = Script::buildPayToWitnessPublicKeyHash(pubKeyHash);
+    for (auto i = 0ul; i < count; ++i) {
+        UTXO utxo;
+        utxo.outPoint = OutPoint(Hash::sha256(std::to_string(i)), static_cast<uint32_t>(i % 4));
+        utxo.script = script;
+        utxo.amount = 100'000;
+        input.utxos.push_back(utxo);
+    }
+    input.amount = static_cast<Amount>(count) * 100'000;
+    return input;
+}
+
+/// Unsigned transaction with `count` inputs, for isolating the sighash computation.
+Transaction buildUnsignedTransaction(std::size_t count) {
+    auto transaction = Transaction(2, 0);
+    for (auto i = 0ul; i < count; ++i) {
+        transaction.inputs.emplace_back(OutPoint(Hash::sha256(std::to_string(i)), 0), Script(), UINT32_MAX);
+    }
+    transaction.outputs.emplace_back(100'000, Script::buildPayToWitnessPublicKeyHash(Data(20, 1)));
+    return transaction;
+}
+
+} // namespace
+
+TW_BENCHMARK(BitcoinSignP2WPKHConsolidation, {1, 10, 100, 500, 1000}) {
+    const auto input = buildConsolidationInput(state.param);
+    state.measure([&] {
+        [[maybe_unused]] auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(input);
+        assert(result);
+    });
+}
+
+TW_BENCHMARK(BitcoinPlanP2WPKHConsolidation, {1, 10, 100, 500, 1000}) {
+    const auto input = buildConsolidationInput(state.param);
+    state.measure([&] {
+        [[maybe_unused]] auto plan = TransactionBuilder::plan(input);
+        assert(plan.error == Common::Proto::OK);
+    });
+}
+
+TW_BENCHMARK(BitcoinSighashWitnessV0, {1, 10, 100, 500, 1000}) {
+    const auto transaction = buildUnsignedTransaction(state.param);
+    const auto scriptCode = Script::buildPayToPublicKeyHash(Data(20, 2));
+    state.measure([&] {
+        for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+            transaction.getSignatureHash(scriptCode, i, TWBitcoinSigHashTypeAll, 100'000, WITNESS_V0);
+        }
+    });
+}
+
+TW_BENCHMARK(BitcoinSighashWitnessV0Precomputed, {1, 10, 100, 500, 1000}) {
+    const auto scriptCode = Script::buildPayToPublicKeyHash(Data(20, 2));
+    auto transaction = buildUnsignedTransaction(state.param);
+    state.measure([&] {
+        transaction.precomputeSighash();
+        for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+            transaction.getSignatureHash(scriptCode, i, TWBitcoinSigHashTypeAll, 100'000, WITNESS_V0);
+        }
+    });
+}
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Cardano/Transaction.h"
+#include "Cbor.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace TW::Cardano {
+
+namespace {
+
+/// Transaction with `count` inputs, and `count` outputs each carrying two tokens.
+Transaction buildTransaction(std::size_t count) {
+    auto transaction = Transaction();
+    for (auto i = 0ul; i < count; ++i) {
+        transaction.inputs.emplace_back(Hash::sha256(std::to_string(i)), i);
+        const auto policyId = hex(subData(Hash::sha256(std::to_string(i)), 0, 28));
+        const auto tokens = TokenBundle({
+            TokenAmount(policyId, data("SUNDAE"), 1'000'000),
+            TokenAmount(policyId, data("MIN"), 2'000'000),
+        });
+        transaction.outputs.emplace_back(Data(57, static_cast<byte>(i)), 2'000'000, tokens);
+    }
+    transaction.fee = 170'000;
+    transaction.ttl = 53'333'345;
+    transaction.withdrawals.push_back(Withdrawal{Data(29, 0xe1), 5'000'000});
+    return transaction;
+}
+
+/// The value-semantics `Cbor::Encode` tree the transaction body was built with before `Cbor::Writer`.
+Data encodeWithTree(const Transaction& transaction) {
+    std::vector<Cbor::Encode> inputs;
+    for (const auto& i : transaction.inputs) {
+        inputs.emplace_back(Cbor::Encode::array({Cbor::Encode::bytes(i.txHash), Cbor::Encode::uint(i.outputIndex)}));
+    }
+    std::vector<Cbor::Encode> outputs;
+    for (const auto& o : transaction.outputs) {
+        std::map<Cbor::Encode, Cbor::Encode> tokensMap;
+        for (const auto& policy : o.tokenBundle.getPolicyIds()) {
+            std::map<Cbor::Encode, Cbor::Encode> subTokensMap;
+            for (const auto& token : o.tokenBundle.getByPolicyId(policy)) {
+                subTokensMap.emplace(Cbor::Encode::bytes(token.assetName), Cbor::Encode::uint(uint64_t(token.amount)));
+            }
+            tokensMap.emplace(Cbor::Encode::bytes(parse_hex(policy)), Cbor::Encode::map(subTokensMap));
+        }
+        outputs.emplace_back(Cbor::Encode::array({
+            Cbor::Encode::bytes(o.address),
+            Cbor::Encode::array({Cbor::Encode::uint(o.amount), Cbor::Encode::map(tokensMap)}),
+        }));
+    }
+    std::map<Cbor::Encode, Cbor::Encode> withdrawals;
+    for (const auto& w : transaction.withdrawals) {
+        withdrawals.emplace(Cbor::Encode::bytes(w.stakingKey), Cbor::Encode::uint(w.amount));
+    }
+    return Cbor::Encode::map({
+        std::make_pair(Cbor::Encode::uint(0), Cbor::Encode::array(inputs)),
+        std::make_pair(Cbor::Encode::uint(1), Cbor::Encode::array(outputs)),
+        std::make_pair(Cbor::Encode::uint(2), Cbor::Encode::uint(transaction.fee)),
+        std::make_pair(Cbor::Encode::uint(3), Cbor::Encode::uint(transaction.ttl)),
+        std::make_pair(Cbor::Encode::uint(5), Cbor::Encode::map(withdrawals)),
+    }).encoded();
+}
+
+} // namespace
+
+TW_BENCHMARK(CardanoEncodeTree, {1, 10, 100}) {
+    const auto transaction = buildTransaction(state.param);
+    state.measure([&] {
+        encodeWithTree(transaction);
+    });
+}
+
+TW_BENCHMARK(CardanoEncodeWriter, {1, 10, 100}) {
+    const auto transaction = buildTransaction(state.param);
+    state.measure([&] {
+        transaction.encode();
+    });
+}
+
+} // namespace TW::Cardano
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Decred/Transaction.h"
+#include "Hash.h"
+
+#include <string>
+
+namespace TW::Decred {
+
+namespace {
+
+/// Unsigned transaction with `count` inputs and two outputs.
+Transaction buildUnsignedTransaction(std::size_t count) {
+    auto transaction = Transaction();
+    for (auto i = 0ul; i < count; ++i) {
+        transaction.inputs.emplace_back(OutPoint(Hash::sha256(std::to_string(i)), 0, 0), Bitcoin::Script(), UINT32_MAX);
+    }
+    transaction.outputs.emplace_back(100'000, 0, Bitcoin::Script::buildPayToPublicKeyHash(Data(20, 1)));
+    transaction.outputs.emplace_back(50'000, 0, Bitcoin::Script::buildPayToPublicKeyHash(Data(20, 2)));
+    return transaction;
+}
+
+} // namespace
+
+TW_BENCHMARK(DecredSighashAll, {1, 100, 1000}) {
+    const auto transaction = buildUnsignedTransaction(state.param);
+    const auto prevOutScript = Bitcoin::Script::buildPayToPublicKeyHash(Data(20, 3));
+    state.measure([&] {
+        for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+            transaction.computeSignatureHash(prevOutScript, i, TWBitcoinSigHashTypeAll);
+        }
+    });
+}
+
+TW_BENCHMARK(DecredSighashAllPrecomputed, {1, 100, 1000}) {
+    auto transaction = buildUnsignedTransaction(state.param);
+    const auto prevOutScript = Bitcoin::Script::buildPayToPublicKeyHash(Data(20, 3));
+    state.measure([&] {
+        transaction.precomputeSighash();
+        for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+            transaction.computeSignatureHash(prevOutScript, i, TWBitcoinSigHashTypeAll);
+        }
+    });
+}
+
+} // namespace TW::Decred
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Everscale/CommonTON/BagOfCells.h"
+#include "Everscale/CommonTON/Cell.h"
+#include "Everscale/CommonTON/CellArena.h"
+
+#include <array>
+#include <vector>
+
+namespace TW::CommonTON {
+
+namespace {
+
+/// Not finalized tree of `count` distinct cells, each full of data and referencing up to 4 previous cells.
+Cell::Ref buildTree(std::size_t count) {
+    std::vector<Cell::Ref> cells;
+    for (auto i = 0ul; i < count; ++i) {
+        Cell::Refs references{};
+        uint8_t refCount = 0;
+        for (auto r = 1ul; r <= Cell::MAX_REFS && r <= i; ++r) {
+            references[refCount++] = cells[i - r];
+        }
+        Data data(126, static_cast<byte>(i));
+        data.push_back(static_cast<byte>(i >> 8));
+        cells.push_back(std::make_shared<Cell>(1016, std::move(data), refCount, std::move(references)));
+    }
+    return cells.back();
+}
+
+Data serializeTree(std::size_t count) {
+    auto root = buildTree(count);
+    root->finalize();
+    Data boc;
+    root->serialize(boc);
+    return boc;
+}
+
+Data serializeTreeWithIndex(std::size_t count) {
+    CellArena arena;
+    const std::array roots{arena.add(*buildTree(count))};
+    Data boc;
+    serializeBoc(arena, roots, boc, BocOptions{.indexIncluded = true, .hasCrc = true});
+    return boc;
+}
+
+} // namespace
+
+TW_BENCHMARK(EverscaleCellFinalize, {10, 100, 400}) {
+    state.measure([&] {
+        buildTree(state.param)->finalize();
+    });
+}
+
+TW_BENCHMARK(EverscaleCellArenaAdd, {10, 100, 400}) {
+    const auto root = buildTree(state.param);
+    state.measure([&] {
+        CellArena arena;
+        arena.add(*root);
+    });
+}
+
+TW_BENCHMARK(EverscaleCellDeserialize, {10, 100, 400}) {
+    const auto boc = serializeTree(state.param);
+    state.measure([&] {
+        Cell::deserialize(boc.data(), boc.size());
+    });
+}
+
+TW_BENCHMARK(EverscaleCellArenaDeserialize, {10, 100, 400}) {
+    const auto boc = serializeTree(state.param);
+    state.measure([&] {
+        CellArena arena;
+        arena.deserialize(boc.data(), boc.size());
+    });
+}
+
+/// Checks the CRC32C of the whole BOC, but only decodes the last cell, located through the index.
+TW_BENCHMARK(EverscaleBocReaderLoadCell, {10, 100, 400}) {
+    const auto boc = serializeTreeWithIndex(state.param);
+    state.measure([&] {
+        CellArena arena;
+        BocReader reader(boc, arena);
+        reader.load(reader.cellCount() - 1);
+    });
+}
+
+} // namespace TW::CommonTON
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Coin.h"
+#include "HDWallet.h"
+
+namespace TW {
+
+namespace {
+
+const auto benchmarkMnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+} // namespace
+
+TW_BENCHMARK(HDWalletDeriveAddressPerIndex, {10, 100, 1000}) {
+    const auto wallet = HDWallet(benchmarkMnemonic, "");
+    state.measure([&] {
+        for (uint32_t i = 0; i < state.param; ++i) {
+            const auto key = wallet.getKey(TWCoinTypeBitcoin, DerivationPath(TWPurposeBIP84, 0, 0, 0, i));
+            TW::deriveAddress(TWCoinTypeBitcoin, key);
+        }
+    });
+}
+
+TW_BENCHMARK(HDWalletDeriveAddressRange, {10, 100, 1000}) {
+    const auto wallet = HDWallet(benchmarkMnemonic, "");
+    state.measure([&] {
+        wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 0, 0, static_cast<uint32_t>(state.param));
+    });
+}
+
+} // namespace TW
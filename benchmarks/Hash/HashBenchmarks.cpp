@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Hash.h"
+
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+/// `count` distinct 33-byte inputs, the size of a compressed public key.
+std::vector<Data> benchmarkInputs(std::size_t count) {
+    std::vector<Data> inputs;
+    for (std::size_t i = 0; i < count; ++i) {
+        inputs.emplace_back(33, static_cast<byte>(i));
+    }
+    return inputs;
+}
+
+void benchmarkBatch(Benchmark::State& state, Hash::Hasher hasher, bool batched) {
+    const auto inputs = benchmarkInputs(state.param);
+    const std::vector<std::span<const byte>> spans(inputs.begin(), inputs.end());
+    Data out(inputs.size() * Hash::hashSize(hasher));
+    Hash::Digest<Hash::maxHashSize> digest;
+    state.measure([&] {
+        if (batched) {
+            Hash::batch(hasher, spans, out);
+            return;
+        }
+        for (const auto& input : inputs) {
+            Hash::hash(hasher, input, digest);
+        }
+    });
+}
+
+} // namespace
+
+TW_BENCHMARK(HashSha256ripemdOneByOne, {8, 1000}) {
+    benchmarkBatch(state, Hash::HasherSha256ripemd, false);
+}
+
+TW_BENCHMARK(HashSha256ripemdBatch, {8, 1000}) {
+    benchmarkBatch(state, Hash::HasherSha256ripemd, true);
+}
+
+TW_BENCHMARK(HashKeccak256OneByOne, {8, 1000}) {
+    benchmarkBatch(state, Hash::HasherKeccak256, false);
+}
+
+TW_BENCHMARK(HashKeccak256Batch, {8, 1000}) {
+    benchmarkBatch(state, Hash::HasherKeccak256, true);
+}
+
+} // namespace TW
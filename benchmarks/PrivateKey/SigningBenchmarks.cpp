@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Hash.h"
+#include "HexCoding.h"
+#include "SigningContext.h"
+
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+const auto benchmarkPrivateKey = "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5";
+
+/// `count` distinct 32-byte digests.
+std::vector<Data> benchmarkDigests(std::size_t count) {
+    std::vector<Data> digests;
+    for (std::size_t i = 0; i < count; ++i) {
+        digests.push_back(Hash::sha256(Data(1, static_cast<byte>(i))));
+    }
+    return digests;
+}
+
+void benchmarkSign(Benchmark::State& state, TWCurve curve, bool withContext) {
+    const auto privateKey = PrivateKey(parse_hex(benchmarkPrivateKey), curve);
+    const auto context = SigningContext(privateKey);
+    const auto digests = benchmarkDigests(state.param);
+    std::array<byte, SigningContext::maxSignatureSize> signature;
+    state.measure([&] {
+        for (const auto& digest : digests) {
+            if (withContext) {
+                context.sign(digest, signature);
+            } else {
+                privateKey.sign(digest);
+            }
+        }
+    });
+}
+
+} // namespace
+
+TW_BENCHMARK(SignSecp256k1PrivateKey, {100}) {
+    benchmarkSign(state, TWCurveSECP256k1, false);
+}
+
+TW_BENCHMARK(SignSecp256k1SigningContext, {100}) {
+    benchmarkSign(state, TWCurveSECP256k1, true);
+}
+
+TW_BENCHMARK(SignEd25519PrivateKey, {100}) {
+    benchmarkSign(state, TWCurveED25519, false);
+}
+
+TW_BENCHMARK(SignEd25519SigningContext, {100}) {
+    benchmarkSign(state, TWCurveED25519, true);
+}
+
+} // namespace TW
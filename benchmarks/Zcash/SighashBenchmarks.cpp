@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+#include "Hash.h"
+#include "Zcash/Transaction.h"
+
+#include <string>
+
+namespace TW::Zcash {
+
+namespace {
+
+/// Unsigned Sapling transaction with `count` inputs and two outputs.
+Transaction buildUnsignedTransaction(std::size_t count) {
+    auto transaction = Transaction();
+    transaction.branchId = SaplingBranchID;
+    for (auto i = 0ul; i < count; ++i) {
+        transaction.inputs.emplace_back(Bitcoin::OutPoint(Hash::sha256(std::to_string(i)), 0), Bitcoin::Script(), UINT32_MAX);
+    }
+    transaction.outputs.emplace_back(100'000, Bitcoin::Script::buildPayToPublicKeyHash(Data(20, 1)));
+    transaction.outputs.emplace_back(50'000, Bitcoin::Script::buildPayToPublicKeyHash(Data(20, 2)));
+    return transaction;
+}
+
+} // namespace
+
+TW_BENCHMARK(ZcashSighashAll, {1, 100, 1000}) {
+    const auto transaction = buildUnsignedTransaction(state.param);
+    const auto scriptCode = Bitcoin::Script::buildPayToPublicKeyHash(Data(20, 3));
+    state.measure([&] {
+        for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+            transaction.getSignatureHash(scriptCode, i, TWBitcoinSigHashTypeAll, 10'000, Bitcoin::BASE);
+        }
+    });
+}
+
+TW_BENCHMARK(ZcashSighashAllPrecomputed, {1, 100, 1000}) {
+    auto transaction = buildUnsignedTransaction(state.param);
+    const auto scriptCode = Bitcoin::Script::buildPayToPublicKeyHash(Data(20, 3));
+    state.measure([&] {
+        transaction.precomputeSighash();
+        for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+            transaction.getSignatureHash(scriptCode, i, TWBitcoinSigHashTypeAll, 10'000, Bitcoin::BASE);
+        }
+    });
+}
+
+} // namespace TW::Zcash
@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Benchmark.h"
+
+int main(int argc, char* argv[]) {
+    const std::string filter = argc > 1 ? argv[1] : "";
+    return TW::Benchmark::runAll(filter);
+}
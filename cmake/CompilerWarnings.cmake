@@ -8,6 +8,16 @@ macro(target_enable_asan target)
             $<$<AND:$<CONFIG:Debug>,$<CXX_COMPILER_ID:AppleClang>>:-fsanitize=address -fno-omit-frame-pointer>)
 endmacro()
 
+macro(target_enable_tsan target)
+    message("-- TSAN Enabled, Configuring...")
+    target_compile_options(${target} PUBLIC
+            $<$<AND:$<CONFIG:Debug>,$<CXX_COMPILER_ID:Clang>>:-fsanitize=thread -fno-omit-frame-pointer>
+            $<$<AND:$<CONFIG:Debug>,$<CXX_COMPILER_ID:AppleClang>>:-fsanitize=thread -fno-omit-frame-pointer>)
+    target_link_options(${target} PUBLIC
+            $<$<AND:$<CONFIG:Debug>,$<CXX_COMPILER_ID:Clang>>:-fsanitize=thread -fno-omit-frame-pointer>
+            $<$<AND:$<CONFIG:Debug>,$<CXX_COMPILER_ID:AppleClang>>:-fsanitize=thread -fno-omit-frame-pointer>)
+endmacro()
+
 macro(target_enable_coverage target)
     message(STATUS "Code coverage ON")
     # This option is used to compile and link code instrumented for coverage analysis.
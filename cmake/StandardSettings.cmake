@@ -29,8 +29,9 @@ option(TW_ENABLE_PVS_STUDIO "Enable static analysis with PVS-Studio." OFF)
 #
 # Runtime analyzers
 #
-# Currently supporting: Clang ASAN.
+# Currently supporting: Clang ASAN, Clang TSAN.
 option(TW_CLANG_ASAN "Enable ASAN dynamic address sanitizer" OFF)
+option(TW_CLANG_TSAN "Enable TSAN dynamic thread sanitizer" OFF)
 
 #
 # Specific platforms support
@@ -67,10 +68,12 @@ endif ()
 #
 option(TW_UNIT_TESTS "Enable the unit tests of the project" ON)
 option(TW_BUILD_EXAMPLES "Enable the examples builds of the project" ON)
+option(TW_BUILD_BENCHMARKS "Enable the benchmarks builds of the project" OFF)
 
 if (ANDROID OR IOS_PLATFORM OR TW_COMPILE_WASM OR TW_COMPILE_JAVA OR FLUTTER)
     set(TW_UNIT_TESTS OFF)
     set(TW_BUILD_EXAMPLES OFF)
+    set(TW_BUILD_BENCHMARKS OFF)
 endif()
 
 if (TW_UNIT_TESTS)
@@ -85,4 +88,8 @@ else()
     message(STATUS "Native examples skipped")
 endif()
 
+if (TW_BUILD_BENCHMARKS)
+    message(STATUS "Native benchmarks activated")
+endif()
+
 
@@ -8,6 +8,7 @@
 #include "TWCoinType.h"
 #include "TWCurve.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWDerivation.h"
 #include "TWDerivationPath.h"
 #include "TWHDVersion.h"
@@ -178,6 +179,23 @@ struct TWPrivateKey* _Nonnull TWHDWalletGetKeyByCurve(struct TWHDWallet* _Nonnul
 TW_EXPORT_METHOD
 struct TWPrivateKey* _Nonnull TWHDWalletGetDerivedKey(struct TWHDWallet* _Nonnull wallet, enum TWCoinType coin, uint32_t account, uint32_t change, uint32_t address);
 
+/// Generates the addresses for a range of bip44 address indices (without exposing intermediary private keys).
+/// For coins with public derivation (secp256k1, nist256p1 curves), the account key is derived only once.
+/// For coins with hardened derivation only (ed25519, curve25519 curves), change and address indices are hardened.
+///
+/// \see https://github.com/bitcoin/bips/blob/master/bip-0044.mediawiki
+///
+/// \param wallet non-null TWHDWallet
+/// \param coin a coin type
+/// \param account valid bip44 account
+/// \param change bip44 change, 0 for the external chain or 1 for the internal chain
+/// \param start first bip44 address index
+/// \param count number of addresses to generate
+/// \note Returned object needs to be deleted with \TWDataVectorDelete
+/// \return Non-null vector of UTF-8 encoded addresses, for indices [start, start+count); empty on invalid change or range
+TW_EXPORT_METHOD
+struct TWDataVector* _Nonnull TWHDWalletGetAddressRange(struct TWHDWallet* _Nonnull wallet, enum TWCoinType coin, uint32_t account, uint32_t change, uint32_t start, uint32_t count);
+
 /// Returns the extended private key (for default 0 account).
 ///
 /// \param wallet non-null TWHDWallet
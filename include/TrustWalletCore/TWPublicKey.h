@@ -6,6 +6,7 @@
 
 #include "TWBase.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWPublicKeyType.h"
 #include "TWString.h"
 
@@ -119,4 +120,27 @@ TWString *_Nonnull TWPublicKeyDescription(struct TWPublicKey *_Nonnull publicKey
 TW_EXPORT_STATIC_METHOD
 struct TWPublicKey *_Nullable TWPublicKeyRecover(TWData *_Nonnull signature, TWData *_Nonnull message);
 
+/// Verify many signatures at once, each against its own public key and message
+///
+/// \param publicKeys Non-null vector of public key data, all of the given type
+/// \param type type of the public keys
+/// \param signatures Non-null vector of signatures, one per public key
+/// \param messages Non-null vector of messages, one per public key
+/// \param asDER true if the signatures are DER encoded, see \TWPublicKeyVerifyAsDER
+/// \param threads number of threads to split the batch over, 0 to use one thread per core
+/// \return Non-null block of data with one byte per entry, 1 if the signature is valid and 0 otherwise.
+/// Empty if the vectors have different sizes.
+TW_EXPORT_STATIC_METHOD
+TWData *_Nonnull TWPublicKeyVerifyBatch(const struct TWDataVector *_Nonnull publicKeys, enum TWPublicKeyType type, const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull messages, bool asDER, uint32_t threads);
+
+/// Recover many public keys at once, see \TWPublicKeyRecover
+///
+/// \param signatures Non-null vector of signatures
+/// \param messages Non-null vector of messages, one per signature
+/// \param threads number of threads to split the batch over, 0 to use one thread per core
+/// \return Non-null vector with the uncompressed public key data of every entry, empty data where the public key can't be recovered.
+/// Empty if the vectors have different sizes.
+TW_EXPORT_STATIC_METHOD
+struct TWDataVector *_Nonnull TWPublicKeyRecoverBatch(const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull messages, uint32_t threads);
+
 TW_EXTERN_C_END
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWPrivateKey.h"
+#include "TWPublicKey.h"
+
+TW_EXTERN_C_BEGIN
+
+/// A Stark private key prepared for signing many StarkEx messages.
+/// The key is loaded and its public key derived once, instead of on every signature.
+TW_EXPORT_CLASS
+struct TWStarkExKeyContext;
+
+/// Prepares a Stark private key for repeated signing.
+///
+/// \param privateKey Non-null Stark private key
+/// \note Returned object needs to be deleted with \TWStarkExKeyContextDelete
+/// \return Null pointer if the key is not a valid Stark private key, pointer to the context otherwise
+TW_EXPORT_STATIC_METHOD
+struct TWStarkExKeyContext* _Nullable TWStarkExKeyContextCreate(const struct TWPrivateKey* _Nonnull privateKey);
+
+/// Deletes a context.
+///
+/// \param context Non-null pointer to the context to be deleted
+TW_EXPORT_METHOD
+void TWStarkExKeyContextDelete(struct TWStarkExKeyContext* _Nonnull context);
+
+/// The Stark public key of the context.
+///
+/// \param context Non-null pointer to a context
+/// \note Returned object needs to be deleted with \TWPublicKeyDelete
+/// \return Non-null pointer to the public key
+TW_EXPORT_PROPERTY
+struct TWPublicKey* _Nonnull TWStarkExKeyContextPublicKey(const struct TWStarkExKeyContext* _Nonnull context);
+
+TW_EXTERN_C_END
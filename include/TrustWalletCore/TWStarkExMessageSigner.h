@@ -8,6 +8,7 @@
 #include "TWData.h"
 #include "TWString.h"
 #include "TWPrivateKey.h"
+#include "TWStarkExKeyContext.h"
 
 TW_EXTERN_C_BEGIN
 
@@ -26,6 +27,14 @@ struct TWStarkExMessageSigner;
 TW_EXPORT_STATIC_METHOD
 TWString* _Nonnull TWStarkExMessageSignerSignMessage(const struct TWPrivateKey* _Nonnull privateKey, TWString* _Nonnull message);
 
+/// Sign a message, with a private key prepared for repeated signing.
+///
+/// \param context: the prepared private key used for signing
+/// \param message: A custom hex message which is input to the signing.
+/// \returns the signature, Hex-encoded. On invalid input empty string is returned. Returned object needs to be deleted after use.
+TW_EXPORT_STATIC_METHOD
+TWString* _Nonnull TWStarkExMessageSignerSignMessageWithContext(const struct TWStarkExKeyContext* _Nonnull context, TWString* _Nonnull message);
+
 /// Verify signature for a message.
 ///
 /// \param pubKey: pubKey that will verify and recover the message from the signature
@@ -12,6 +12,7 @@
 #include "TWPrivateKey.h"
 #include "TWStoredKeyEncryptionLevel.h"
 #include "TWStoredKeyEncryption.h"
+#include "TWStoredKeyUnlockSession.h"
 #include "TWString.h"
 
 TW_EXTERN_C_BEGIN
@@ -366,6 +367,58 @@ bool TWStoredKeyFixAddresses(struct TWStoredKey* _Nonnull key, TWData* _Nonnull
 TW_EXPORT_METHOD
 bool TWStoredKeyUpdateAddress(struct TWStoredKey* _Nonnull key, enum TWCoinType coin);
 
+/// Decrypts the private key, from an unlock session of the key.
+///
+/// \param key Non-null pointer to a stored key
+/// \param session Non-null pointer to an unlock session of the stored key
+/// \return Decrypted private key as a block of data if success, null pointer if the session has expired or is not one of the key
+TW_EXPORT_METHOD
+TWData* _Nullable TWStoredKeyDecryptPrivateKeyWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session);
+
+/// Decrypts the encoded private key, from an unlock session of the key.
+///
+/// \param key Non-null pointer to a stored key
+/// \param session Non-null pointer to an unlock session of the stored key
+/// \return Decrypted encoded private key as a string if success, null pointer if the session has expired or is not one of the key
+TW_EXPORT_METHOD
+TWString* _Nullable TWStoredKeyDecryptPrivateKeyEncodedWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session);
+
+/// Decrypts the mnemonic phrase, from an unlock session of the key.
+///
+/// \param key Non-null pointer to a stored key
+/// \param session Non-null pointer to an unlock session of the stored key
+/// \return Bip39 decrypted mnemonic if success, null pointer if the session has expired or is not one of the key
+TW_EXPORT_METHOD
+TWString* _Nullable TWStoredKeyDecryptMnemonicWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session);
+
+/// Returns the private key for a specific coin, from an unlock session of the key.
+///
+/// \param key Non-null pointer to a stored key
+/// \param coin Account coin type to be queried
+/// \param session Non-null pointer to an unlock session of the stored key
+/// \note Returned object needs to be deleted with \TWPrivateKeyDelete
+/// \return Null pointer on failure, pointer to the private key otherwise
+TW_EXPORT_METHOD
+struct TWPrivateKey* _Nullable TWStoredKeyPrivateKeyWithSession(struct TWStoredKey* _Nonnull key, enum TWCoinType coin, struct TWStoredKeyUnlockSession* _Nonnull session);
+
+/// Returns the HD Wallet for mnemonic phrase keys, from an unlock session of the key.
+///
+/// \param key Non-null pointer to a stored key
+/// \param session Non-null pointer to an unlock session of the stored key
+/// \note Returned object is a copy of the wallet of the session, owned by the caller: it is not wiped when the session
+/// ends, and needs to be deleted with \TWHDWalletDelete
+/// \return Null pointer on failure, pointer to the HDWallet otherwise
+TW_EXPORT_METHOD
+struct TWHDWallet* _Nullable TWStoredKeyWalletWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session);
+
+/// Fills in empty and invalid addresses, from an unlock session of the key.
+///
+/// \param key Non-null pointer to a stored key
+/// \param session Non-null pointer to an unlock session of the stored key
+/// \return `false` if the session has expired or is not one of the key, true otherwise.
+TW_EXPORT_METHOD
+bool TWStoredKeyFixAddressesWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session);
+
 /// Retrieve stored key encoding parameters, as JSON string.
 ///
 /// \param key Non-null pointer to a stored key
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWData.h"
+
+TW_EXTERN_C_BEGIN
+
+struct TWStoredKey;
+
+/// A stored key unlocked with its password for a limited time.
+/// Keeps the key derived from the password, so that the stored key can be decrypted repeatedly without rerunning the
+/// key derivation function (scrypt or PBKDF2). The derived key is wiped when the session is locked, deleted, or used or
+/// checked after it has expired.
+TW_EXPORT_CLASS
+struct TWStoredKeyUnlockSession;
+
+/// Unlocks a stored key with its password, for a limited time.
+///
+/// \param key Non-null pointer to a stored key
+/// \param password Non-null block of data, password of the stored key
+/// \param lifetimeSeconds Number of seconds the session can be used for
+/// \note Returned object needs to be deleted with \TWStoredKeyUnlockSessionDelete
+/// \return Null pointer if the password is incorrect, pointer to the session otherwise
+TW_EXPORT_STATIC_METHOD
+struct TWStoredKeyUnlockSession* _Nullable TWStoredKeyUnlockSessionCreate(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, uint32_t lifetimeSeconds);
+
+/// Deletes a session, wiping the derived key.
+///
+/// \param session Non-null pointer to the session to be deleted
+TW_EXPORT_METHOD
+void TWStoredKeyUnlockSessionDelete(struct TWStoredKeyUnlockSession* _Nonnull session);
+
+/// Whether the session has expired or has been locked. The derived key is wiped once the session has expired.
+///
+/// \param session Non-null pointer to a session
+/// \return true if the session cannot be used anymore, false otherwise
+TW_EXPORT_PROPERTY
+bool TWStoredKeyUnlockSessionIsExpired(struct TWStoredKeyUnlockSession* _Nonnull session);
+
+/// Whether the derived key is locked in memory against swapping.
+/// Locking is best effort: it is not supported on every platform, and fails beyond the locked memory limit of the process.
+///
+/// \param session Non-null pointer to a session
+/// \return true if the derived key is locked in memory, false otherwise or once the session has ended
+TW_EXPORT_PROPERTY
+bool TWStoredKeyUnlockSessionIsMemoryLocked(struct TWStoredKeyUnlockSession* _Nonnull session);
+
+/// Ends the session before it expires, wiping the derived key.
+///
+/// \param session Non-null pointer to a session
+TW_EXPORT_METHOD
+void TWStoredKeyUnlockSessionLock(struct TWStoredKeyUnlockSession* _Nonnull session);
+
+TW_EXTERN_C_END
@@ -28,7 +28,8 @@ namespace TW::Base58 {
         }
 
         // re-calculate the checksum, ensure it matches the included 4-byte checksum
-        auto hash = Hash::hash(hasher, result.data(), result.size() - 4);
+        Hash::Digest<Hash::maxHashSize> hash;
+        Hash::hash(hasher, result.data(), result.size() - 4, hash);
         if (!std::equal(hash.begin(), hash.begin() + 4, result.end() - 4)) {
             return {};
         }
@@ -46,8 +47,11 @@ namespace TW::Base58 {
 
     template <typename T>
     static inline std::string encodeCheck(const T& data, Rust::Base58Alphabet alphabet = Rust::Base58Alphabet::Bitcoin, Hash::Hasher hasher = Hash::HasherSha256d) {
-        auto hash = Hash::hash(hasher, data);
-        Data toBeEncoded(std::begin(data), std::end(data));
+        Hash::Digest<Hash::maxHashSize> hash;
+        Hash::hash(hasher, reinterpret_cast<const byte*>(data.data()), data.size(), hash);
+        Data toBeEncoded;
+        toBeEncoded.reserve(data.size() + 4);
+        toBeEncoded.insert(toBeEncoded.end(), std::begin(data), std::end(data));
         toBeEncoded.insert(toBeEncoded.end(), hash.begin(), hash.begin() + 4);
         return encode(toBeEncoded, alphabet);
     }
@@ -7,11 +7,95 @@
 #include "UTXO.h"
 
 #include <algorithm>
+#include <limits>
 #include <optional>
 #include <cassert>
+#include <random>
 
 namespace TW::Bitcoin {
 
+namespace {
+
+/// Fee components of a selection, for the branch and bound and knapsack searches.
+struct SelectionFees {
+    /// Transaction without inputs and without change
+    int64_t base;
+    /// Each input
+    int64_t input;
+    /// Each input, at the long-term fee rate
+    int64_t longTermInput;
+    /// Adding a change output
+    int64_t changeOutput;
+
+    SelectionFees(const FeeCalculator& feeCalculator, int64_t byteFee, int64_t longTermByteFee, int64_t numOutputs) noexcept
+        : base(feeCalculator.calculate(0, numOutputs, byteFee)),
+          input(feeCalculator.calculate(1, numOutputs, byteFee) - base),
+          longTermInput(input),
+          changeOutput(feeCalculator.calculate(0, numOutputs + 1, byteFee) - base) {
+        if (longTermByteFee > 0) {
+            longTermInput = feeCalculator.calculate(1, numOutputs, longTermByteFee) -
+                            feeCalculator.calculate(0, numOutputs, longTermByteFee);
+        }
+    }
+
+    /// Cost of a change output: adding it now, and spending it later.
+    int64_t costOfChange() const noexcept { return changeOutput + longTermInput; }
+
+    /// Waste of each input: what its fee exceeds the long-term fee by.
+    int64_t inputWaste() const noexcept { return input - longTermInput; }
+};
+
+/// Knapsack approximation (`ApproximateBestSubset` of Bitcoin Core): randomized passes over `values`, by decreasing value,
+/// for the subset with the smallest total of at least `target`. `total` is the sum of all values.
+/// Each value considered uses one of `iterations`. Returns the total of the best subset, marked in `best`.
+int64_t approximateBestSubset(const std::vector<int64_t>& values, int64_t total, int64_t target,
+                              size_t& iterations, std::mt19937_64& random, std::vector<char>& best) {
+    std::vector<char> included(values.size());
+    // Within a round values are only added, except the one reaching the target, which is removed right away.
+    // So a subset found in the round is the values included before it plus that one, and is only copied
+    // to `best` at the end of the round.
+    std::vector<size_t> includedAt(values.size());
+    size_t step = 0;
+    best.assign(values.size(), true);
+    auto bestValue = total;
+    while (iterations > 0 && bestValue != target) {
+        std::fill(included.begin(), included.end(), false);
+        int64_t value = 0;
+        bool reachedTarget = false;
+        std::optional<size_t> foundIndex;
+        // first pass: random values; second pass: all the others
+        for (auto pass = 0; pass < 2 && !reachedTarget; ++pass) {
+            for (auto i = 0ul; i < values.size() && iterations > 0; ++i, --iterations) {
+                if (included[i] || (pass == 0 && (random() & 1) == 0)) {
+                    continue;
+                }
+                value += values[i];
+                included[i] = true;
+                includedAt[i] = step++;
+                if (value >= target) {
+                    reachedTarget = true;
+                    if (value < bestValue) {
+                        bestValue = value;
+                        foundIndex = i;
+                    }
+                    // try a smaller value instead of this one
+                    value -= values[i];
+                    included[i] = false;
+                }
+            }
+        }
+        if (foundIndex.has_value()) {
+            const auto foundAt = includedAt[*foundIndex];
+            for (auto i = 0ul; i < values.size(); ++i) {
+                best[i] = i == *foundIndex || (included[i] && includedAt[i] < foundAt);
+            }
+        }
+    }
+    return bestValue;
+}
+
+} // namespace
+
 template <typename TypeWithAmount>
 uint64_t InputSelector<TypeWithAmount>::sum(const std::vector<TypeWithAmount>& amounts) noexcept {
     uint64_t sum = 0;
@@ -43,25 +127,6 @@ InputSelector<TypeWithAmount>::filterThreshold(const std::vector<TypeWithAmount>
     return filtered;
 }
 
-// Slice Array
-// [0,1,2,3,4,5,6,7,8,9].eachSlices(3)
-// >
-// [[0, 1, 2], [1, 2, 3], [2, 3, 4], [3, 4, 5], [4, 5, 6], [5, 6, 7], [6, 7, 8],
-// [7, 8, 9]]
-template <typename TypeWithAmount>
-static inline std::vector<std::vector<TypeWithAmount>>
-slice(const std::vector<TypeWithAmount>& inputs, size_t sliceSize) {
-    std::vector<std::vector<TypeWithAmount>> slices;
-    for (auto i = 0ul; i <= inputs.size() - sliceSize; ++i) {
-        slices.emplace_back();
-        slices[i].reserve(sliceSize);
-        for (auto j = i; j < i + sliceSize; j++) {
-            slices[i].push_back(inputs[j]);
-        }
-    }
-    return slices;
-}
-
 template <typename TypeWithAmount>
 std::vector<TypeWithAmount>
 InputSelector<TypeWithAmount>::select(uint64_t targetValue, uint64_t byteFee, uint64_t numOutputs) {
@@ -70,7 +135,7 @@ InputSelector<TypeWithAmount>::select(uint64_t targetValue, uint64_t byteFee, ui
         return {};
     }
 
-    // Get all possible utxo selections up to a maximum size, sort by total amount, increasing
+    // Consider contiguous windows of the utxos sorted by amount, increasing
     std::vector<TypeWithAmount> sorted = filterOutDust(_inputs, byteFee);
     std::sort(
         sorted.begin(),
@@ -87,16 +152,40 @@ InputSelector<TypeWithAmount>::select(uint64_t targetValue, uint64_t byteFee, ui
 
     // definitions for the following calculation
     const auto doubleTargetValue = targetValue * 2;
-
-    // Precompute maximum amount possible to obtain with given number of inputs
     const auto n = sorted.size();
-    std::vector<uint64_t> maxWithXInputs = std::vector<uint64_t>();
-    maxWithXInputs.push_back(0);
-    int64_t maxSum = 0;
+
+    // Prefix sums: the window of `count` inputs starting at `first` sums to prefix[first + count] - prefix[first].
+    // As amounts are sorted, the sum of a window never decreases when it slides to the right,
+    // and the maximum amount possible with `count` inputs is the sum of the last window.
+    std::vector<uint64_t> prefix(n + 1, 0);
     for (auto i = 0ul; i < n; ++i) {
-        maxSum += sorted[n - 1 - i].amount;
-        maxWithXInputs.push_back(maxSum);
+        prefix[i + 1] = prefix[i] + sorted[i].amount;
     }
+    const auto windowSum = [&prefix](size_t first, size_t count) -> uint64_t {
+        return prefix[first + count] - prefix[first];
+    };
+    const auto maxWithXInputs = [&prefix, n](size_t count) -> uint64_t {
+        return prefix[n] - prefix[n - count];
+    };
+
+    // First window of `count` inputs, starting from `first`, with a sum of at least `minimum`
+    // (binary search; returns the number of windows, `n - count + 1`, if there is none)
+    const auto firstWindowReaching = [&windowSum, n](size_t first, size_t count, uint64_t minimum) -> size_t {
+        auto last = n - count + 1;
+        while (first < last) {
+            const auto middle = first + (last - first) / 2;
+            if (windowSum(middle, count) < minimum) {
+                first = middle + 1;
+            } else {
+                last = middle;
+            }
+        }
+        return first;
+    };
+
+    const auto window = [&sorted](size_t first, size_t count) {
+        return std::vector<TypeWithAmount>(sorted.begin() + first, sorted.begin() + first + count);
+    };
 
     // difference from 2x targetValue
     auto distFrom2x = [doubleTargetValue](uint64_t val) -> uint64_t {
@@ -115,45 +204,35 @@ InputSelector<TypeWithAmount>::select(uint64_t targetValue, uint64_t byteFee, ui
     for (size_t numInputs = 1; numInputs <= n; ++numInputs) {
         const auto fee = feeCalculator.calculate(numInputs, numOutputs, byteFee);
         const auto targetWithFeeAndDust = targetValue + fee + dustThreshold;
-        if (maxWithXInputs[numInputs] < targetWithFeeAndDust) {
+        if (maxWithXInputs(numInputs) < targetWithFeeAndDust) {
             // no way to satisfy with only numInputs inputs, skip
             continue;
         }
-        auto slices = slice(sorted, static_cast<size_t>(numInputs));
-
-        slices.erase(
-            std::remove_if(slices.begin(), slices.end(),
-                           [targetWithFeeAndDust](const std::vector<TypeWithAmount>& slice) {
-                               return sum(slice) < targetWithFeeAndDust;
-                           }),
-            slices.end());
-        if (!slices.empty()) {
-            std::sort(slices.begin(), slices.end(),
-                      [distFrom2x](const std::vector<TypeWithAmount>& lhs,
-                                   const std::vector<TypeWithAmount>& rhs) {
-                          return distFrom2x(sum(lhs)) < distFrom2x(sum(rhs));
-                      });
-            return slices.front();
+        // Windows from `firstValid` on are big enough, the last one at least. Their distance from 2x
+        // decreases up to the first window reaching 2x, and increases after it, so the closest one is either
+        // that window or the one just before it. On a tie, the leftmost window wins.
+        const auto firstValid = firstWindowReaching(0, numInputs, targetWithFeeAndDust);
+        const auto above = firstWindowReaching(firstValid, numInputs, doubleTargetValue);
+        const auto end = n - numInputs + 1;
+        auto best = above;
+        if (above > firstValid) {
+            const auto belowSum = windowSum(above - 1, numInputs);
+            if (above == end || distFrom2x(belowSum) <= distFrom2x(windowSum(above, numInputs))) {
+                best = firstWindowReaching(firstValid, numInputs, belowSum);
+            }
         }
+        return window(best, numInputs);
     }
 
     // 2. If not, find a valid combination of outputs even if they produce dust change.
     for (size_t numInputs = 1; numInputs <= n; ++numInputs) {
         const auto fee = feeCalculator.calculate(numInputs, numOutputs, byteFee);
         const auto targetWithFee = targetValue + fee;
-        if (maxWithXInputs[numInputs] < targetWithFee) {
+        if (maxWithXInputs(numInputs) < targetWithFee) {
             // no way to satisfy with only numInputs inputs, skip
             continue;
         }
-        auto slices = slice(sorted, static_cast<size_t>(numInputs));
-        slices.erase(std::remove_if(slices.begin(), slices.end(),
-                                    [targetWithFee](const std::vector<TypeWithAmount>& slice) {
-                                        return sum(slice) < targetWithFee;
-                                    }),
-                     slices.end());
-        if (!slices.empty()) {
-            return slices.front();
-        }
+        return window(firstWindowReaching(0, numInputs, targetWithFee), numInputs);
     }
 
     // If we couldn't find a combination of inputs to cover estimated transaction fee and the target amount,
@@ -210,6 +289,196 @@ InputSelector<TypeWithAmount>::selectMaxAmount(int64_t byteFee) noexcept {
     return filterOutDust(_inputs, byteFee);
 }
 
+template <typename TypeWithAmount>
+std::vector<TypeWithAmount>
+InputSelector<TypeWithAmount>::spendableByAmount(int64_t byteFee, int64_t inputFee) {
+    auto spendable = filterThreshold(_inputs, std::max(static_cast<uint64_t>(dustCalculator->dustAmount(byteFee)),
+                                                       static_cast<uint64_t>(std::max(inputFee, int64_t(0))) + 1));
+    std::stable_sort(
+        spendable.begin(),
+        spendable.end(),
+        [](const TypeWithAmount& lhs, const TypeWithAmount& rhs) {
+            return lhs.amount > rhs.amount;
+        });
+    return spendable;
+}
+
+template <typename TypeWithAmount>
+std::vector<TypeWithAmount>
+InputSelector<TypeWithAmount>::selectBranchAndBound(uint64_t targetValue, int64_t byteFee, int64_t numOutputs,
+                                                    int64_t longTermByteFee, size_t maxIterations) {
+    // if target value is zero, no UTXOs are needed
+    if (targetValue == 0) {
+        return {};
+    }
+
+    const auto fees = SelectionFees(feeCalculator, byteFee, longTermByteFee, numOutputs);
+    const auto pool = spendableByAmount(byteFee, fees.input);
+    // amount less the fee to spend it, positive
+    const auto effectiveValue = [&pool, &fees](size_t index) -> int64_t {
+        return pool[index].amount - fees.input;
+    };
+    const auto target = static_cast<int64_t>(targetValue) + fees.base;
+    const auto costOfChange = fees.costOfChange();
+    const auto inputWaste = fees.inputWaste();
+
+    // value of the undecided inputs
+    int64_t available = 0;
+    for (auto i = 0ul; i < pool.size(); ++i) {
+        available += effectiveValue(i);
+    }
+    if (available < target) {
+        return {};
+    }
+
+    // Depth-first search, including the largest inputs first. `selection` holds the decision
+    // (included or not) for each of the first `selection.size()` inputs.
+    std::vector<bool> selection;
+    selection.reserve(pool.size());
+    std::vector<bool> best;
+    int64_t value = 0;
+    int64_t waste = 0;
+    auto bestWaste = std::numeric_limits<int64_t>::max();
+    for (auto iteration = 0ul; iteration < maxIterations; ++iteration) {
+        bool backtrack = false;
+        if (value + available < target ||
+            value > target + costOfChange ||
+            // more inputs only add waste when the fee rate is above the long-term one
+            (waste > bestWaste && inputWaste > 0)) {
+            backtrack = true;
+        } else if (value >= target) {
+            // in range, the excess goes to the fee
+            const auto excess = value - target;
+            if (waste + excess <= bestWaste) {
+                best = selection;
+                bestWaste = waste + excess;
+                if (bestWaste == 0 && inputWaste >= 0) {
+                    // waste cannot be negative
+                    break;
+                }
+            }
+            backtrack = true;
+        }
+
+        if (backtrack) {
+            // walk back to the last included input, and continue with the branch that omits it
+            while (!selection.empty() && !selection.back()) {
+                selection.pop_back();
+                available += effectiveValue(selection.size());
+            }
+            if (selection.empty()) {
+                // all branches searched
+                break;
+            }
+            selection.back() = false;
+            value -= effectiveValue(selection.size() - 1);
+            waste -= inputWaste;
+        } else {
+            const auto index = selection.size();
+            available -= effectiveValue(index);
+            if (!selection.empty() && !selection.back() && pool[index].amount == pool[index - 1].amount) {
+                // including it instead of the equal input just omitted would repeat the same branch
+                selection.push_back(false);
+            } else {
+                selection.push_back(true);
+                value += effectiveValue(index);
+                waste += inputWaste;
+            }
+        }
+    }
+
+    std::vector<TypeWithAmount> selected;
+    for (auto i = 0ul; i < best.size(); ++i) {
+        if (best[i]) {
+            selected.push_back(pool[i]);
+        }
+    }
+    return selected;
+}
+
+template <typename TypeWithAmount>
+std::vector<TypeWithAmount>
+InputSelector<TypeWithAmount>::selectKnapsack(uint64_t targetValue, int64_t byteFee, int64_t numOutputs,
+                                              int64_t longTermByteFee, size_t maxIterations) {
+    // if target value is zero, no UTXOs are needed
+    if (targetValue == 0) {
+        return {};
+    }
+
+    const auto fees = SelectionFees(feeCalculator, byteFee, longTermByteFee, numOutputs);
+    const auto pool = spendableByAmount(byteFee, fees.input);
+    const auto target = static_cast<int64_t>(targetValue) + fees.base;
+    // excess needed for a change output that is not dust
+    const auto minChange = fees.changeOutput + dustCalculator->dustAmount(byteFee);
+
+    // Inputs below `target + minChange` are combined; the smallest input above it is the alternative.
+    // `pool` is sorted by decreasing amount, so they are a suffix, and the alternative is just before it.
+    int64_t totalLower = 0;
+    auto firstLower = pool.size();
+    for (auto i = pool.size(); i > 0; --i) {
+        const auto value = pool[i - 1].amount - fees.input;
+        if (value == target) {
+            return {pool[i - 1]};
+        }
+        if (value >= target + minChange) {
+            break;
+        }
+        firstLower = i - 1;
+        totalLower += value;
+    }
+    const auto lowerInputs = std::vector<TypeWithAmount>(pool.begin() + firstLower, pool.end());
+    if (totalLower == target) {
+        return lowerInputs;
+    }
+    if (totalLower < target) {
+        if (firstLower == 0) {
+            return {};
+        }
+        return {pool[firstLower - 1]};
+    }
+
+    std::vector<int64_t> values;
+    values.reserve(lowerInputs.size());
+    for (const auto& input : lowerInputs) {
+        values.push_back(input.amount - fees.input);
+    }
+
+    const auto waste = [&fees, minChange](size_t count, int64_t excess) -> int64_t {
+        const auto lost = excess >= minChange ? fees.costOfChange() : excess;
+        return static_cast<int64_t>(count) * fees.inputWaste() + lost;
+    };
+    const auto subsetWaste = [&waste, target](const std::vector<char>& subset, int64_t value) {
+        return waste(static_cast<size_t>(std::count(subset.begin(), subset.end(), true)), value - target);
+    };
+
+    std::mt19937_64 random(static_cast<uint64_t>(target));
+    auto iterations = maxIterations;
+    std::vector<char> best;
+    const auto bestValue = approximateBestSubset(values, totalLower, target, iterations, random, best);
+    auto bestWaste = subsetWaste(best, bestValue);
+    if (bestValue != target && totalLower >= target + minChange) {
+        // no exact match, also aim for a change output that is not dust
+        std::vector<char> withChange;
+        const auto withChangeValue = approximateBestSubset(values, totalLower, target + minChange, iterations, random, withChange);
+        if (const auto withChangeWaste = subsetWaste(withChange, withChangeValue); withChangeWaste < bestWaste) {
+            best = std::move(withChange);
+            bestWaste = withChangeWaste;
+        }
+    }
+
+    if (firstLower > 0 && waste(1, pool[firstLower - 1].amount - fees.input - target) <= bestWaste) {
+        return {pool[firstLower - 1]};
+    }
+
+    std::vector<TypeWithAmount> selected;
+    for (auto i = 0ul; i < best.size(); ++i) {
+        if (best[i]) {
+            selected.push_back(lowerInputs[i]);
+        }
+    }
+    return selected;
+}
+
 // Explicitly instantiate
 template class Bitcoin::InputSelector<UTXO>;
 
@@ -37,6 +37,32 @@ public:
     /// Return indices. One output and no change is assumed.
     std::vector<TypeWithAmount> selectMaxAmount(int64_t byteFee) noexcept;
 
+    /// Default bound on the search steps of `selectBranchAndBound` and `selectKnapsack`.
+    static constexpr size_t defaultMaxIterations = 100'000;
+
+    /// Selects unspent transactions that cover the target value and the fee without a change output,
+    /// using a depth-first branch and bound search (as in Bitcoin Core).
+    /// A selection qualifies if its value, less the fee of its inputs, exceeds what is needed by at most
+    /// the cost of a change output (adding it now, and spending it later at `longTermByteFee`); the excess is left to the fee.
+    /// Of the qualifying selections found in `maxIterations` steps, the one with the least waste is returned.
+    /// `numOutputs` does not include a change output; a `longTermByteFee` of 0 means `byteFee`.
+    ///
+    /// \returns the list of selected inputs, empty if no changeless selection was found.
+    std::vector<TypeWithAmount> selectBranchAndBound(uint64_t targetValue, int64_t byteFee,
+                                                     int64_t numOutputs = 1, int64_t longTermByteFee = 0,
+                                                     size_t maxIterations = defaultMaxIterations);
+
+    /// Selects unspent transactions that cover the target value, the fee and a change output of at least the dust amount,
+    /// unless they match exactly, using the randomized knapsack approximation of Bitcoin Core with a fixed seed.
+    /// The best approximation found in `maxIterations` steps and the smallest single sufficient input are
+    /// compared by waste (input fees above the long-term ones, plus either the cost of change or the excess).
+    /// `numOutputs` does not include a change output; a `longTermByteFee` of 0 means `byteFee`.
+    ///
+    /// \returns the list of selected inputs, empty if all the inputs together are not enough.
+    std::vector<TypeWithAmount> selectKnapsack(uint64_t targetValue, int64_t byteFee,
+                                               int64_t numOutputs = 1, int64_t longTermByteFee = 0,
+                                               size_t maxIterations = defaultMaxIterations);
+
     /// Construct, using provided feeCalculator (see getFeeCalculator()) and dustCalculator (see getDustCalculator()).
     explicit InputSelector(const std::vector<TypeWithAmount>& inputs,
                            const FeeCalculator& feeCalculator,
@@ -62,6 +88,9 @@ public:
                                                        uint64_t minimumAmount) noexcept;
 
 private:
+    /// Inputs that are not dust and are worth more than the fee to spend them, by decreasing amount.
+    std::vector<TypeWithAmount> spendableByAmount(int64_t byteFee, int64_t inputFee);
+
     const std::vector<TypeWithAmount> _inputs;
     const FeeCalculator& feeCalculator;
     const DustCalculatorShared dustCalculator;
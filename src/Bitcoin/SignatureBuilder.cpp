@@ -28,10 +28,16 @@ Result<Transaction, Common::Proto::SigningError> SignatureBuilder<Transaction>::
         return Result<Transaction, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_input_utxos);
     }
 
+    indexKeyPairs();
+
     transactionToSign = _transaction;
     transactionToSign.inputs.clear();
     std::copy(std::begin(_transaction.inputs), std::end(_transaction.inputs),
               std::back_inserter(transactionToSign.inputs));
+    if (signingMode != SigningMode_SizeEstimationOnly) {
+        // prevouts, sequences and outputs stay the same while inputs are signed, hash them only once
+        transactionToSign.precomputeSighash();
+    }
 
     const auto hashSingle = hashTypeIsSingle(input.hashType);
     for (auto i = 0ul; i < plan.utxos.size(); i++) {
@@ -48,6 +54,8 @@ Result<Transaction, Common::Proto::SigningError> SignatureBuilder<Transaction>::
         }
     }
 
+    transactionToSign.sighashCache.reset();
+
     // save estimated size
     if ((input.byteFee > 0) && (plan.fee > 0)) {
         transactionToSign.previousEstimatedVirtualSize = static_cast<int>(plan.fee / input.byteFee);
@@ -316,18 +324,24 @@ Data SignatureBuilder<Transaction>::pushAll(const std::vector<Data>& results) {
 }
 
 template <typename Transaction>
-std::optional<KeyPair> SignatureBuilder<Transaction>::keyPairForPubKeyHash(const Data& hash) const {
+void SignatureBuilder<Transaction>::indexKeyPairs() {
+    keyPairsByPubKeyHash.clear();
     for (auto& key : input.privateKeys) {
         auto pubKeyExtended = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
         auto pubKey = pubKeyExtended.compressed();
-        if (Hash::sha256ripemd(pubKey.bytes.data(), pubKey.bytes.size()) == hash) {
-            return std::make_tuple(key, pubKey);
-        }
-        if (Hash::sha256ripemd(pubKeyExtended.bytes.data(), pubKeyExtended.bytes.size()) == hash) {
-            return std::make_tuple(key, pubKeyExtended);
-        }
+        // emplace keeps the first match, same as a linear scan over the keys would
+        keyPairsByPubKeyHash.emplace(Hash::sha256ripemd(pubKey.bytes.data(), pubKey.bytes.size()), std::make_tuple(key, pubKey));
+        keyPairsByPubKeyHash.emplace(Hash::sha256ripemd(pubKeyExtended.bytes.data(), pubKeyExtended.bytes.size()), std::make_tuple(key, pubKeyExtended));
+    }
+}
+
+template <typename Transaction>
+std::optional<KeyPair> SignatureBuilder<Transaction>::keyPairForPubKeyHash(const Data& hash) const {
+    auto it = keyPairsByPubKeyHash.find(hash);
+    if (it == keyPairsByPubKeyHash.end()) {
+        return {};
     }
-    return {};
+    return it->second;
 }
 
 template <typename Transaction>
@@ -15,10 +15,10 @@
 #include "../PublicKey.h"
 #include "../CoinEntry.h"
 
+#include <map>
 #include <utility>
 #include <vector>
 #include <optional>
-#include <utility>
 
 namespace TW::Bitcoin {
 
@@ -54,6 +54,10 @@ private:
     /// For SigningMode_External, signatures are provided here
     std::optional<SignaturePubkeyList> externalSignatures;
 
+    /// Available key pairs, indexed by the HASH160 of both their compressed and extended public key.
+    /// Built once per `sign()`, so that inputs do not derive the public key of every private key again.
+    std::map<Data, KeyPair> keyPairsByPubKeyHash;
+
 public:
     /// Initializes a transaction signer with signing input.
     /// estimationMode: is set, no real signing is performed, only as much as needed to get the almost-exact signed size 
@@ -86,6 +90,9 @@ private:
                          const Data& publicKeyHash, const std::optional<KeyPair>& key,
                          size_t index, Amount amount, uint32_t version);
 
+    /// Builds `keyPairsByPubKeyHash` from the input private keys.
+    void indexKeyPairs();
+
     /// Returns the private key for the given public key hash.
     std::optional<KeyPair> keyPairForPubKeyHash(const Data& hash) const;
 
@@ -47,6 +47,9 @@ SigningInput::SigningInput(const Proto::SigningInput& input) {
     }
 
     dustCalculator = getDustCalculator(input);
+    coinSelection = input.coin_selection();
+    coinSelectionMaxIterations = input.coin_selection_max_iterations();
+    longTermByteFee = input.long_term_byte_fee();
 }
 
 } // namespace TW::Bitcoin
@@ -83,6 +83,15 @@ public:
 
     DustCalculatorShared dustCalculator;
 
+    // Strategy to select the input UTXOs
+    Proto::CoinSelection coinSelection = Proto::DefaultCoinSelection;
+
+    // Bound on the search steps of the `BranchAndBound` and `Knapsack` coin selections, 0 means the default
+    uint32_t coinSelectionMaxIterations = 0;
+
+    // Long-term fee rate for the `BranchAndBound` and `Knapsack` coin selections, 0 means `byteFee`
+    Amount longTermByteFee = 0;
+
 public:
     SigningInput();
 
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "SizeEstimator.h"
+
+#include "OpCodes.h"
+#include "Script.h"
+#include "SigHashType.h"
+
+#include "../BinaryCoding.h"
+#include "../Hash.h"
+#include "../HexCoding.h"
+#include "../PublicKey.h"
+
+#include <set>
+
+namespace TW::Bitcoin {
+
+namespace {
+
+/// Signature placeholder of `SigningMode_SizeEstimationOnly`, a maximal DER signature with the sighash type
+constexpr size_t signatureSize = 72;
+/// Outpoint and sequence
+constexpr size_t inputFixedSize = 36 + 4;
+/// Version and lock time
+constexpr size_t transactionFixedSize = 4 + 4;
+/// Witness marker and flag
+constexpr size_t witnessHeaderSize = 2;
+
+/// Size of data pushed by `SignatureBuilder::pushAll`, for anything but single bytes
+size_t pushSize(size_t size) {
+    if (size == 0) {
+        return 1;
+    }
+    if (size < OP_PUSHDATA1) {
+        return 1 + size;
+    }
+    if (size <= 0xff) {
+        return 2 + size;
+    }
+    if (size <= 0xffff) {
+        return 3 + size;
+    }
+    return 5 + size;
+}
+
+/// Size of a length-prefixed script or witness item
+size_t prefixedSize(size_t size) {
+    return varIntSize(size) + size;
+}
+
+struct InputSize {
+    size_t scriptSig = 0;
+    size_t witnessItems = 0;
+    /// Encoded witness items, without their count
+    size_t witness = 0;
+
+    void pushScript(size_t size) { scriptSig += pushSize(size); }
+    void pushWitness(size_t size) {
+        ++witnessItems;
+        witness += prefixedSize(size);
+    }
+};
+
+class InputSizes {
+public:
+    explicit InputSizes(const SigningInput& input) : input(input) {}
+
+    /// Size of the script and witness spending `script`, see `SignatureBuilder::sign`
+    std::optional<InputSize> of(const Script& script) {
+        Data data;
+        InputSize size;
+        if (script.matchPayToPublicKeyHash(data)
+            || script.matchPayToPublicKeyHashReplay(data)
+            || script.matchPayToExchangePublicKeyHash(data)) {
+            size.pushScript(signatureSize);
+            size.pushScript(publicKeySize(data));
+            return size;
+        }
+        if (script.matchPayToScriptHash(data)) {
+            const auto redeemScript = scriptForScriptHash(data);
+            if (redeemScript.empty() || !addWitness(redeemScript, size)) {
+                return {};
+            }
+            size.pushScript(redeemScript.bytes.size());
+            return size;
+        }
+        if (!addWitness(script, size)) {
+            return {};
+        }
+        return size;
+    }
+
+private:
+    /// Adds the witness spending a P2WPKH or P2WSH multisig program
+    bool addWitness(const Script& program, InputSize& size) const {
+        Data data;
+        if (program.matchPayToWitnessPublicKeyHash(data)) {
+            size.pushWitness(signatureSize);
+            size.pushWitness(PublicKey::secp256k1Size);
+            return true;
+        }
+        if (!program.matchPayToWitnessScriptHash(data)) {
+            return false;
+        }
+        const auto witnessScript = scriptForScriptHash(Hash::ripemd(data));
+        std::vector<Data> keys;
+        int required = 0;
+        if (witnessScript.empty() || !witnessScript.matchMultisig(keys, required)) {
+            return false;
+        }
+        // CHECKMULTISIG dummy, then a signature for each of the first `required` keys
+        size.pushWitness(0);
+        for (auto i = 0ul; i < static_cast<size_t>(required); ++i) {
+            size.pushWitness(i < keys.size() ? signatureSize : 0);
+        }
+        size.pushWitness(witnessScript.bytes.size());
+        return true;
+    }
+
+    Script scriptForScriptHash(const Data& hash) const {
+        auto it = input.scripts.find(hex(hash));
+        if (it == input.scripts.end()) {
+            return {};
+        }
+        return it->second;
+    }
+
+    /// Size of the public key with hash `keyHash`: uncompressed only if it is the one of a private key
+    size_t publicKeySize(const Data& keyHash) {
+        if (!extendedKeyHashes.has_value()) {
+            extendedKeyHashes.emplace();
+            for (const auto& key : input.privateKeys) {
+                const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+                extendedKeyHashes->insert(Hash::sha256ripemd(publicKey.bytes.data(), publicKey.bytes.size()));
+            }
+        }
+        return extendedKeyHashes->count(keyHash) != 0 ? PublicKey::secp256k1ExtendedSize : PublicKey::secp256k1Size;
+    }
+
+    const SigningInput& input;
+    /// Computed on first use, as it takes a public key derivation per private key
+    std::optional<std::set<Data>> extendedKeyHashes;
+};
+
+} // namespace
+
+std::optional<uint64_t> SizeEstimator::virtualSize(const Transaction& transaction, const UTXOs& utxos, const SigningInput& input) {
+    InputSizes inputSizes(input);
+    const auto hashSingle = hashTypeIsSingle(input.hashType);
+
+    uint64_t size = transactionFixedSize + varIntSize(transaction.inputs.size()) + varIntSize(transaction.outputs.size());
+    for (const auto& output : transaction.outputs) {
+        size += sizeof(output.value) + prefixedSize(output.script.bytes.size());
+    }
+
+    uint64_t witnessSize = witnessHeaderSize;
+    bool hasWitness = false;
+    for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+        InputSize inputSize;
+        inputSize.scriptSig = transaction.inputs[i].script.bytes.size();
+        // as in `SignatureBuilder::sign`, inputs without a matching output are not signed with SIGHASH_SINGLE
+        if (i < utxos.size() && !(hashSingle && i >= transaction.outputs.size())) {
+            auto signedSize = inputSizes.of(utxos[i].script);
+            if (!signedSize.has_value()) {
+                return {};
+            }
+            inputSize = signedSize.value();
+        }
+        size += inputFixedSize + prefixedSize(inputSize.scriptSig);
+        witnessSize += varIntSize(inputSize.witnessItems) + inputSize.witness;
+        hasWitness = hasWitness || inputSize.witnessItems > 0;
+    }
+
+    if (!hasWitness) {
+        return size;
+    }
+    // witness bytes count for a quarter
+    return size + (witnessSize + 3) / 4;
+}
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "SigningInput.h"
+#include "Transaction.h"
+#include "UTXO.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace TW::Bitcoin {
+
+/// Computes the virtual size of a transaction from the script types of the spent UTXOs, without signing it.
+///
+/// Sizes are those of the transaction signed in `SigningMode_SizeEstimationOnly`, with 72-byte signature
+/// placeholders, for inputs spending P2PKH, P2WPKH, P2WSH multisig, P2SH-wrapped P2WPKH or P2WSH multisig outputs.
+/// P2TR outputs are not supported, as `SignatureBuilder` cannot sign them.
+/// Unlike size estimation by signing, public keys in witnesses are assumed to be compressed, as uncompressed ones
+/// are non-standard there, so private keys are only looked at for inputs spending P2PKH outputs.
+class SizeEstimator {
+public:
+    /// Returns the virtual size of `transaction`, as built by `TransactionBuilder::build` for `utxos`, once signed.
+    /// Returns nothing if a UTXO script or a redeem script is not supported, or a redeem script is missing.
+    static std::optional<uint64_t> virtualSize(const Transaction& transaction, const UTXOs& utxos, const SigningInput& input);
+};
+
+} // namespace TW::Bitcoin
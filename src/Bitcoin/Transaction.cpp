@@ -15,6 +15,25 @@
 
 namespace TW::Bitcoin {
 
+namespace {
+
+/// Hashes `data` into a stack buffer and appends the digest to `out`.
+void appendHash(Hash::Hasher hasher, const Data& data, Data& out) {
+    Hash::Digest<Hash::maxHashSize> digest;
+    const auto size = Hash::hash(hasher, data, digest);
+    out.insert(out.end(), digest.begin(), digest.begin() + size);
+}
+
+/// Hashes `data` into a stack buffer; only the returned digest is allocated.
+Data hashOf(Hash::Hasher hasher, const Data& data) {
+    Data result;
+    result.reserve(Hash::maxHashSize);
+    appendHash(hasher, data, result);
+    return result;
+}
+
+} // namespace
+
 Data Transaction::getPreImage(const Script& scriptCode, size_t index,
                               enum TWBitcoinSigHashType hashType, uint64_t amount) const {
     assert(index < inputs.size());
@@ -26,7 +45,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
+        auto hashPrevouts = sighashCache.has_value() ? sighashCache->hashPrevouts : getPrevoutHash();
         std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -35,7 +54,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 && !hashTypeIsSingle(hashType) &&
         !hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
+        auto hashSequence = sighashCache.has_value() ? sighashCache->hashSequence : getSequenceHash();
         std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -52,13 +71,12 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
     // Outputs (none/one/all, depending on flags)
     if (!hashTypeIsSingle(hashType) && !hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
+        auto hashOutputs = sighashCache.has_value() ? sighashCache->hashOutputs : getOutputsHash();
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else if (hashTypeIsSingle(hashType) && index < outputs.size()) {
         Data outputData;
         outputs[index].encode(outputData);
-        auto hashOutputs = Hash::hash(hasher, outputData);
-        copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
+        appendHash(hasher, outputData, data);
     } else {
         fill_n(back_inserter(data), 32, 0);
     }
@@ -78,8 +96,7 @@ Data Transaction::getPrevoutHash() const {
         auto& outpoint = reinterpret_cast<const OutPoint&>(input.previousOutput);
         outpoint.encode(data);
     }
-    auto hash = Hash::hash(hasher, data);
-    return hash;
+    return hashOf(hasher, data);
 }
 
 Data Transaction::getSequenceHash() const {
@@ -87,8 +104,7 @@ Data Transaction::getSequenceHash() const {
     for (auto& input : inputs) {
         encode32LE(input.sequence, data);
     }
-    auto hash = Hash::hash(hasher, data);
-    return hash;
+    return hashOf(hasher, data);
 }
 
 Data Transaction::getOutputsHash() const {
@@ -96,8 +112,11 @@ Data Transaction::getOutputsHash() const {
     for (auto& output : outputs) {
         output.encode(data);
     }
-    auto hash = Hash::hash(hasher, data);
-    return hash;
+    return hashOf(hasher, data);
+}
+
+void Transaction::precomputeSighash() {
+    sighashCache = SighashCache{getPrevoutHash(), getSequenceHash(), getOutputsHash()};
 }
 
 void Transaction::encode(Data& data, enum SegwitFormatMode segwitFormat) const {
@@ -166,8 +185,7 @@ Data Transaction::getSignatureHashWitnessV0(const Script& scriptCode, size_t ind
                                             enum TWBitcoinSigHashType hashType,
                                             uint64_t amount) const {
     auto preimage = getPreImage(scriptCode, index, hashType, amount);
-    auto hash = Hash::hash(hasher, preimage);
-    return hash;
+    return hashOf(hasher, preimage);
 }
 
 /// Generates the signature hash for for scripts other than witness scripts.
@@ -205,8 +223,7 @@ Data Transaction::getSignatureHashBase(const Script& scriptCode, size_t index,
     // Sighash type
     encode32LE(hashType, data);
 
-    auto hash = Hash::hash(hasher, data);
-    return hash;
+    return hashOf(hasher, data);
 }
 
 void Transaction::serializeInput(size_t subindex, const Script& scriptCode, size_t index,
@@ -29,6 +29,14 @@ class TransactionInputs: public std::vector<TransactionInput> {};
 template <typename TransactionOutput>
 class TransactionOutputs: public std::vector<TransactionOutput> {};
 
+/// BIP143 signature hash components that are shared by all inputs of a transaction.
+/// See https://github.com/bitcoin/bips/blob/master/bip-0143.mediawiki
+struct SighashCache {
+    Data hashPrevouts;
+    Data hashSequence;
+    Data hashOutputs;
+};
+
 struct Transaction {
 public:
     /// Transaction data format version (note, this is signed)
@@ -57,6 +65,10 @@ public:
     /// Used for diagnostics; store previously estimated virtual size (if any; size in bytes)
     int previousEstimatedVirtualSize = 0;
 
+    /// Precomputed witness v0 sighash components, see `precomputeSighash()`.
+    /// Must be reset if the prevouts, sequences or outputs are changed afterwards.
+    std::optional<SighashCache> sighashCache;
+
 public:
     Transaction() = default;
 
@@ -72,6 +84,10 @@ public:
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the sighash components shared by all inputs once, so that signing N inputs
+    /// does not rehash all the prevouts, sequences and outputs N times.
+    void precomputeSighash();
+
     enum SegwitFormatMode {
         NonSegwit,
         IfHasWitness,
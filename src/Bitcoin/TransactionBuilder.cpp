@@ -4,6 +4,7 @@
 
 #include "TransactionBuilder.h"
 #include "Script.h"
+#include "SizeEstimator.h"
 #include "TransactionSigner.h"
 #include "SignatureBuilder.h"
 
@@ -34,7 +35,7 @@ int64_t estimateSimpleFee(const FeeCalculator& feeCalculator, const TransactionP
     return feeCalculator.calculate(plan.utxos.size(), outputSize, byteFee);
 }
 
-/// Estimate encoded size by invoking sign(sizeOnly), get actual size
+/// Estimate encoded size from the script types of the inputs, or by invoking sign(sizeOnly) for other scripts
 int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionPlan& plan, int outputSize, const SigningInput& input) {
     TWPurpose coinPurpose = TW::purpose(static_cast<TWCoinType>(input.coinType));
     if (coinPurpose != TWPurposeBIP84) {
@@ -42,6 +43,15 @@ int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionP
         return estimateSimpleFee(feeCalculator, plan, outputSize, input.byteFee);
     }
 
+    auto unsignedTransaction = TransactionBuilder::build<Transaction>(plan, input);
+    if (!unsignedTransaction) {
+        // signing would fail as well; return default simple estimate
+        return estimateSimpleFee(feeCalculator, plan, outputSize, input.byteFee);
+    }
+    if (const auto virtualSize = SizeEstimator::virtualSize(unsignedTransaction.payload(), plan.utxos, input); virtualSize.has_value()) {
+        return input.byteFee * virtualSize.value();
+    }
+
     // duplicate input, with the current plan
     auto inputWithPlan = std::move(input);
     inputWithPlan.plan = plan;
@@ -112,12 +122,29 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
         auto extraOutputs = extraOutputCount(input);
         auto output_size = 2;
         UTXOs selectedInputs;
+        // Whether the selected inputs were chosen to need no change output
+        bool changeless = false;
         if (!maxAmount) {
             // Please note that there may not be a "change" output if the "change.amount" is less than "dust",
             // but we use a max amount of transaction outputs to simplify the algorithm, so the fee can be slightly bigger in rare cases.
             output_size = 2 + extraOutputs; // output + change
+            const auto maxIterations = input.coinSelectionMaxIterations > 0
+                ? static_cast<size_t>(input.coinSelectionMaxIterations)
+                : InputSelector<UTXO>::defaultMaxIterations;
             if (input.useMaxUtxo) {
                 selectedInputs = inputSelector.selectMaxAmount(input.byteFee);
+            } else if (input.coinSelection == Proto::BranchAndBound || input.coinSelection == Proto::Knapsack) {
+                if (input.coinSelection == Proto::BranchAndBound) {
+                    selectedInputs = inputSelector.selectBranchAndBound(totalAmount, input.byteFee, 1 + extraOutputs,
+                                                                        input.longTermByteFee, maxIterations);
+                    changeless = !selectedInputs.empty();
+                }
+                if (changeless) {
+                    output_size = 1 + extraOutputs; // output, no change
+                } else {
+                    selectedInputs = inputSelector.selectKnapsack(totalAmount, input.byteFee, 1 + extraOutputs,
+                                                                  input.longTermByteFee, maxIterations);
+                }
             } else if (input.utxos.size() <= SimpleModeLimit &&
                 input.utxos.size() <= MaxUtxosHardLimit) {
                 selectedInputs = inputSelector.select(totalAmount, input.byteFee, output_size);
@@ -158,10 +185,14 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
 
             // Compute fee.
             // must preliminary set change so that there is a second output
-            if (!maxAmount) {
+            if (!maxAmount && !changeless) {
                 plan.amount = input.amount;
                 plan.fee = 0;
                 plan.change = plan.availableAmount - totalAmount;
+            } else if (!maxAmount) {
+                plan.amount = input.amount;
+                plan.fee = 0;
+                plan.change = 0;
             } else {
                 plan.amount = plan.availableAmount;
                 plan.fee = 0;
@@ -210,8 +241,20 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
             }
 
             auto changeAmount = plan.availableAmount - totalSpendAmount;
-            // Compute change if it's not dust.
-            if (changeAmount >= dustThreshold) {
+            if (changeless) {
+                // The excess of a changeless selection goes to the fee, unless the fee of the actual transaction
+                // is lower than estimated by the selector by enough to pay for a change output that is not dust.
+                const auto changeOutputFee = feeCalculator.calculate(0, output_size + 1, input.byteFee) -
+                                             feeCalculator.calculate(0, output_size, input.byteFee);
+                if (changeAmount - changeOutputFee >= dustThreshold) {
+                    plan.change = changeAmount - changeOutputFee;
+                    plan.fee += changeOutputFee;
+                } else {
+                    plan.change = 0;
+                    plan.fee += changeAmount;
+                }
+            } else if (changeAmount >= dustThreshold) {
+                // Compute change if it's not dust.
                 plan.change = changeAmount;
             } else {
                 // Spend the change as tx fee if it's dust, otherwise the transaction won't be mined.
@@ -17,28 +17,33 @@ bool AddressV2::parseAndCheck(const std::string& addr, Data& root_out, Data& att
     if (base58decoded.empty()) {
         return false;
     }
-    auto elems = Cbor::Decode(base58decoded).getArrayElements();
-    if (elems.size() < 2) {
+    Cbor::Reader address(base58decoded);
+    const auto count = address.readArray();
+    if (count.has_value() && *count < 2) {
         return false;
     }
-    auto tag = elems[0].getTagValue();
+    auto tag = address.readTag();
     if (tag != PayloadTag) {
         return false;
     }
-    Data payload = elems[0].getTagElement().getBytes();
-    uint64_t crcPresent = (uint32_t)elems[1].getValue();
+    const auto payloadBytes = address.readBytes();
+    Data payload(payloadBytes.begin(), payloadBytes.end());
+    uint64_t crcPresent = (uint32_t)address.readValue();
     uint32_t crcComputed = TW::Crc::crc32(payload);
     if (crcPresent != crcComputed) {
         return false;
     }
     // parse payload, 3 elements
-    auto payloadElems = Cbor::Decode(payload).getArrayElements();
-    if (payloadElems.size() < 3) {
+    Cbor::Reader payloadElems(payload);
+    const auto payloadCount = payloadElems.readArray();
+    if (payloadCount.has_value() && *payloadCount < 3) {
         return false;
     }
-    root_out = payloadElems[0].getBytes();
-    attrs_out = payloadElems[1].encoded(); // map, but encoded as bytes
-    type_out = (byte)payloadElems[2].getValue();
+    const auto root = payloadElems.readBytes();
+    root_out.assign(root.begin(), root.end());
+    const auto attrs = payloadElems.skip(); // map, but encoded as bytes
+    attrs_out.assign(attrs.begin(), attrs.end());
+    type_out = (byte)payloadElems.readValue();
     return true;
 }
 
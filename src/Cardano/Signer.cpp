@@ -4,6 +4,7 @@
 
 #include "Signer.h"
 #include "AddressV3.h"
+#include "TxSizeModel.h"
 
 #include "Cbor.h"
 #include "HexCoding.h"
@@ -13,11 +14,11 @@
 #include <cassert>
 #include <cmath>
 #include <numeric>
+#include <set>
 #include <vector>
 
 namespace TW::Cardano {
 
-static const Data placeholderPrivateKey = parse_hex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
 static const auto PlaceholderFee = 170000;
 static const auto ExtraInputAmount = 500000;
 
@@ -118,79 +119,99 @@ Data deriveStakingPrivateKey(const Data& privateKeyData) {
     return stakingPrivKeyData;
 }
 
+bool hasLegacyUtxos(const Proto::SigningInput& input) {
+    return std::any_of(input.utxos().begin(), input.utxos().end(), [](const auto& utxo) { return AddressV2::isValid(utxo.address()); });
+}
+
+/// Collect the addresses that need a signature: every input UTXO address and the staking addresses in use.
+/// Addresses are in binary form (header and key hashes, see AddressV3::data), unique, in order of first appearance.
+Common::Proto::SigningError collectWitnessAddresses(std::vector<Data>& addresses, const Proto::SigningInput& input, const TransactionPlan& plan) {
+    addresses.clear();
+    std::set<Data> seen;
+    const auto add = [&](const std::string& address) {
+        auto binary = AddressV3(address).data();
+        if (seen.insert(binary).second) {
+            addresses.emplace_back(std::move(binary));
+        }
+    };
+    try {
+        for (auto& u : plan.utxos) {
+            add(u.address);
+        }
+        // Staking key is also an address that needs signature
+        if (input.has_register_staking_key()) {
+            add(input.register_staking_key().staking_address());
+        }
+        if (input.has_deregister_staking_key()) {
+            add(input.deregister_staking_key().staking_address());
+        }
+        if (input.has_delegate()) {
+            add(input.delegate().staking_address());
+        }
+        if (input.has_withdraw()) {
+            add(input.withdraw().staking_address());
+        }
+        if (input.has_vote_delegation()) {
+            add(input.vote_delegation().staking_address());
+        }
+    } catch (const std::exception&) {
+        return Common::Proto::Error_invalid_address;
+    }
+    return Common::Proto::OK;
+}
+
 Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Data, Data>>& signatures, const Proto::SigningInput& input, const TransactionPlan& plan, const Data& txId, bool sizeEstimationOnly) {
     signatures.clear();
-    // Private keys and corresponding addresses
-    std::map<std::string, Data> privateKeys;
     for (auto i = 0; i < input.private_key_size(); ++i) {
-        const auto privateKeyData = data(input.private_key(i));
-        if (!PrivateKey::isValid(privateKeyData)) {
+        if (!PrivateKey::isValid(data(input.private_key(i)))) {
             return Common::Proto::Error_invalid_private_key;
         }
+    }
+
+    std::vector<Data> addresses;
+    const auto addressError = collectWitnessAddresses(addresses, input, plan);
+    if (addressError != Common::Proto::OK) {
+        return addressError;
+    }
+
+    if (sizeEstimationOnly) {
+        // only the size matters, public keys and signatures have fixed sizes
+        signatures.assign(addresses.size(), std::make_pair(Data(PublicKey::cardanoKeySize), Data(64)));
+        return Common::Proto::OK;
+    }
+
+    // Private keys, by the binary form of their associated addresses
+    const bool withLegacy = hasLegacyUtxos(input);
+    std::map<Data, Data> privateKeys;
+    for (auto i = 0; i < input.private_key_size(); ++i) {
+        const auto privateKeyData = data(input.private_key(i));
 
         // Add this private key and associated address
         const auto privateKey = PrivateKey(privateKeyData, TWCurveED25519ExtendedCardano);
         const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519Cardano);
         const auto address = AddressV3(publicKey);
-        privateKeys[address.string()] = privateKeyData;
+        privateKeys[address.data()] = privateKeyData;
 
-        const auto legacyAddress = AddressV2(publicKey);
-        privateKeys[legacyAddress.string()] = privateKeyData;
+        if (withLegacy) {
+            privateKeys[AddressV2(publicKey).getCborData()] = privateKeyData;
+        }
 
         // Also add the derived staking private key (the 2nd half) and associated address; because staking keys also need signature
         const auto stakingPrivKeyData = deriveStakingPrivateKey(privateKeyData);
         if (!stakingPrivKeyData.empty()) {
-            privateKeys[address.getStakingAddress()] = stakingPrivKeyData;
-        }
-    }
-
-    // collect every unique input UTXO address, preserving order
-    std::vector<std::string> addresses;
-    for (auto& u : plan.utxos) {
-        if (!AddressV3::isValidLegacy(u.address)) {
-            return Common::Proto::Error_invalid_address;
-        }
-        addresses.emplace_back(u.address);
-    }
-    // Staking key is also an address that needs signature
-    if (input.has_register_staking_key()) {
-        addresses.emplace_back(input.register_staking_key().staking_address());
-    }
-    if (input.has_deregister_staking_key()) {
-        addresses.emplace_back(input.deregister_staking_key().staking_address());
-    }
-    if (input.has_delegate()) {
-        addresses.emplace_back(input.delegate().staking_address());
-    }
-    if (input.has_withdraw()) {
-        addresses.emplace_back(input.withdraw().staking_address());
-    }
-    if (input.has_vote_delegation()) {
-        addresses.emplace_back(input.vote_delegation().staking_address());
-    }
-    // discard duplicates (std::set, std::copy_if, std::unique does not work well here)
-    std::vector<std::string> addressesUnique;
-    for (auto& a: addresses) {
-        if (find(addressesUnique.begin(), addressesUnique.end(), a) == addressesUnique.end()) {
-            addressesUnique.emplace_back(a);
+            const auto stakingKeyHash = subData(address.bytes, AddressV3::HashSize, AddressV3::HashSize);
+            privateKeys[AddressV3::createReward(address.networkId, stakingKeyHash).data()] = stakingPrivKeyData;
         }
     }
 
     // create signature for each address
-    for (auto& a : addressesUnique) {
+    for (auto& a : addresses) {
         const auto privKeyFind = privateKeys.find(a);
-        Data privateKeyData;
-        if (privKeyFind != privateKeys.end()) {
-            privateKeyData = privKeyFind->second;
-        } else {
+        if (privKeyFind == privateKeys.end()) {
             // private key not found
-            if (sizeEstimationOnly) {
-                privateKeyData = placeholderPrivateKey;
-            } else {
-                return Common::Proto::Error_missing_private_key;
-            }
+            return Common::Proto::Error_missing_private_key;
         }
-        const auto privateKey = PrivateKey(privateKeyData, TWCurveED25519ExtendedCardano);
+        const auto privateKey = PrivateKey(privKeyFind->second, TWCurveED25519ExtendedCardano);
         const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519Cardano);
         const auto signature = privateKey.sign(txId);
         signatures.emplace_back(publicKey.bytes, signature);
@@ -199,48 +220,40 @@ Common::Proto::SigningError Signer::assembleSignatures(std::vector<std::pair<Dat
     return Common::Proto::OK;
 }
 
-Cbor::Encode cborizeSignatures(const std::vector<std::pair<Data, Data>>& signatures, const bool addByronSignatures) {
-    std::map<Cbor::Encode, Cbor::Encode> cborizeSigs;
-    // signatures as Cbor
-    // clang-format off
-    std::vector<Cbor::Encode> sigsShelly;
-    std::vector<Cbor::Encode> sigsByron;
+/// Part of `data` starting at `start`, at most `length` bytes, same bounds as `subData` but without a copy
+std::span<const byte> subSpan(const Data& data, size_t start, size_t length) {
+    if (start >= data.size()) {
+        return {};
+    }
+    return std::span<const byte>(data).subspan(start, std::min(length, data.size() - start));
+}
+
+void cborizeSignatures(Cbor::Writer& cbor, const std::vector<std::pair<Data, Data>>& signatures, const bool addByronSignatures) {
+    // signatures as Cbor, a map with fixed numbers as keys, written in ascending order
+    const bool hasByron = addByronSignatures && !signatures.empty();
+    cbor.map(hasByron ? 2 : 1);
 
-    for (auto& s : signatures) {
-        sigsShelly.emplace_back(Cbor::Encode::array({
+    cbor.uint(0).array(signatures.size());
+    for (const auto& s : signatures) {
+        cbor.array(2)
             // public key (first 32 bytes)
-            Cbor::Encode::bytes(subData(s.first, 0, 32)),
-            Cbor::Encode::bytes(s.second)
-        }));
-
-        if (addByronSignatures) {
-            sigsByron.emplace_back(Cbor::Encode::array({
-                // skey - public key (first 32 bytes)  
-                Cbor::Encode::bytes(subData(s.first, 0, 32)),
-                Cbor::Encode::bytes(s.second),
+            .bytes(subSpan(s.first, 0, 32))
+            .bytes(s.second);
+    }
+
+    if (hasByron) {
+        cbor.uint(2).array(signatures.size());
+        for (const auto& s : signatures) {
+            cbor.array(4)
+                // skey - public key (first 32 bytes)
+                .bytes(subSpan(s.first, 0, 32))
+                .bytes(s.second)
                 // vkey - public key (second 32 bytes started from 32)
-                Cbor::Encode::bytes(subData(s.first, 32, 32)),
+                .bytes(subSpan(s.first, 32, 32))
                 // payload
-                Cbor::Encode::bytes(parse_hex("A0"))
-            }));
+                .bytes(parse_hex("A0"));
         }
     }
-
-    cborizeSigs.emplace(
-        Cbor::Encode::uint(0),
-        Cbor::Encode::array(sigsShelly)
-    );
-
-    if (!sigsByron.empty()) {
-        cborizeSigs.emplace(
-            Cbor::Encode::uint(2),
-            Cbor::Encode::array(sigsByron)
-        );
-    }
-
-    // Cbor-encode txAux & signatures
-    return Cbor::Encode::map(cborizeSigs);
-    // clang-format on
 }
 
 Proto::SigningOutput Signer::signWithPlan() const {
@@ -284,28 +297,18 @@ Common::Proto::SigningError Signer::encodeTransaction(Data& encoded, Data& txId,
         return sigError;
     }
 
-    bool hasLegacyUtxos = false;
-    for (const auto& utxo : input.utxos()) {
-        if (AddressV2::isValid(utxo.address())) {
-            hasLegacyUtxos = true;
-            break;
-        }
-    }
-
-    const auto sigsCbor = cborizeSignatures(signatures, hasLegacyUtxos);
-
-    std::vector<Cbor::Encode> cbor;
-    cbor.emplace_back(Cbor::Encode::fromRaw(txAux.encode()));
-    cbor.emplace_back(sigsCbor);
+    // Cbor-encode txAux & signatures
+    Cbor::Writer cbor;
+    cbor.array(input.has_vote_delegation() ? 4 : 3);
+    txAux.encode(cbor);
+    cborizeSignatures(cbor, signatures, hasLegacyUtxos(input));
     // Add a spec version for the vote delegation message
     if (input.has_vote_delegation()) {
-        cbor.emplace_back(Cbor::Encode::version(21));
+        cbor.version(21);
     }
     // Add a null value for the auxiliary data
-    cbor.emplace_back(Cbor::Encode::null());
-
-    // Cbor-encode txAux & signatures
-    encoded = Cbor::Encode::array(cbor).encoded();
+    cbor.null();
+    encoded = cbor.release();
     return Common::Proto::OK;
 }
 
@@ -419,24 +422,30 @@ uint64_t sumUndeposits(const Proto::SigningInput& input) {
     return sum;
 }
 
-// Estimates size of transaction in bytes.
+// Estimates size of transaction in bytes, from a size model of the transaction; nothing is encoded or signed.
 uint64_t estimateTxSize(const Proto::SigningInput& input, Amount amount, const TokenBundle& requestedTokens, const std::vector<TxInput>& selectedInputs, const std::vector<TxOutput>& extraOutputs) {
-    auto inputs = std::vector<TxInput>();
-    for (auto i = 0; i < input.utxos_size(); ++i) {
-        inputs.emplace_back(TxInput::fromProto(input.utxos(i)));
-    }
     const auto deposits = sumDeposits(input);
     const uint64_t undeposits = sumUndeposits(input);
     const auto _simplePlan = simplePlan(amount, requestedTokens, selectedInputs, input.transfer_message().use_max_amount(), deposits, undeposits, extraOutputs);
 
-    Data encoded;
-    Data txId;
-    const auto encodeError = Signer::encodeTransaction(encoded, txId, input, _simplePlan, true);
-    if (encodeError != Common::Proto::OK) {
+    Transaction tx;
+    if (Signer::buildTransactionAux(tx, input, _simplePlan) != Common::Proto::OK) {
+        return 0;
+    }
+    for (auto i = 0; i < input.private_key_size(); ++i) {
+        if (!PrivateKey::isValid(data(input.private_key(i)))) {
+            return 0;
+        }
+    }
+    std::vector<Data> witnessAddresses;
+    if (collectWitnessAddresses(witnessAddresses, input, _simplePlan) != Common::Proto::OK) {
         return 0;
     }
 
-    return encoded.size();
+    auto model = TxSizeModel(tx);
+    model.setWitnesses(witnessAddresses.size(), hasLegacyUtxos(input));
+    model.setVoteDelegation(input.has_vote_delegation());
+    return model.size();
 }
 
 // Compute fee from tx size, with some over-estimation
@@ -611,27 +620,17 @@ Data Signer::encodeTransactionWithSig(const Proto::SigningInput &input, const Pu
     std::vector<std::pair<Data, Data>> signatures;
     signatures.emplace_back(publicKey.bytes, signature);
 
-    bool hasLegacyUtxos = false;
-    for (const auto& utxo : input.utxos()) {
-        if (AddressV2::isValid(utxo.address())) {
-            hasLegacyUtxos = true;
-            break;
-        }
-    }
-
-    const auto sigsCbor = cborizeSignatures(signatures, hasLegacyUtxos);
-
     // Cbor-encode txAux & signatures
-    const auto cbor = Cbor::Encode::array({
-        // txaux
-        Cbor::Encode::fromRaw(txAux.encode()),
-        // signatures
-        sigsCbor,
-        // aux data
-        Cbor::Encode::null(),
-    });
-
-    return cbor.encoded();
+    Cbor::Writer cbor;
+    cbor.array(3);
+    // txaux
+    txAux.encode(cbor);
+    // signatures
+    cborizeSignatures(cbor, signatures, hasLegacyUtxos(input));
+    // aux data
+    cbor.null();
+
+    return cbor.release();
 }
 
 Common::Proto::SigningError Signer::buildTx(Transaction& tx, const Proto::SigningInput& input) {
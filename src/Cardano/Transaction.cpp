@@ -6,6 +6,7 @@
 
 #include "Transaction.h"
 #include "AddressV3.h"
+#include "TxSizeModel.h"
 
 #include "Cbor.h"
 #include "Hash.h"
@@ -251,137 +252,302 @@ Proto::TransactionPlan TransactionPlan::toProto() const {
     return plan;
 }
 
-Cbor::Encode cborizeInputs(const std::vector<OutPoint>& inputs) {
-    // clang-format off
-    std::vector<Cbor::Encode> ii;
+void cborizeInputs(Cbor::Writer& cbor, const std::vector<OutPoint>& inputs) {
+    cbor.array(inputs.size());
     for (const auto& i : inputs) {
-        ii.emplace_back(Cbor::Encode::array({
-            Cbor::Encode::bytes(i.txHash),
-            Cbor::Encode::uint(i.outputIndex)
-        }));
+        cbor.array(2)
+            .bytes(i.txHash)
+            .uint(i.outputIndex);
     }
-    // clang-format on
-    return Cbor::Encode::array(ii);
 }
 
-Cbor::Encode cborizeOutputAmounts(const Amount& amount, const TokenBundle& tokenBundle) {
+void cborizeOutputAmounts(Cbor::Writer& cbor, const Amount& amount, const TokenBundle& tokenBundle) {
     if (tokenBundle.size() == 0) {
         // native amount only
-        return Cbor::Encode::uint(amount);
+        cbor.uint(amount);
+        return;
     }
     // native and token amounts
     // tokens: organized in two levels: by policyId and by assetName
-    const auto policyIds = tokenBundle.getPolicyIds();
-    std::map<Cbor::Encode, Cbor::Encode> tokensMap;
-    for (const auto& policy : policyIds) {
-        const auto& subTokens = tokenBundle.getByPolicyId(policy);
-        std::map<Cbor::Encode, Cbor::Encode> subTokensMap;
-        for (const auto& token : subTokens) {
-            subTokensMap.emplace(
-                Cbor::Encode::bytes(token.assetName),
-                Cbor::Encode::uint(uint64_t(token.amount)) // 64 bits
-            );
+    cbor.array(2).uint(amount);
+    cbor.beginMap();
+    for (const auto& policy : tokenBundle.getPolicyIds()) {
+        cbor.bytes(parse_hex(policy));
+        cbor.beginMap();
+        for (const auto& token : tokenBundle.getByPolicyId(policy)) {
+            cbor.bytes(token.assetName)
+                .uint(uint64_t(token.amount)); // 64 bits
         }
-        tokensMap.emplace(
-            Cbor::Encode::bytes(parse_hex(policy)),
-            Cbor::Encode::map(subTokensMap));
-    }
-    // clang-format off
-    return Cbor::Encode::array({
-        Cbor::Encode::uint(amount),
-        Cbor::Encode::map(tokensMap)
-    });
-    // clang-format on
+        cbor.endMap();
+    }
+    cbor.endMap();
 }
 
-Cbor::Encode cborizeOutput(const TxOutput& output) {
-    // clang-format off
-    return Cbor::Encode::array({
-        Cbor::Encode::bytes(output.address),
-        cborizeOutputAmounts(output.amount, output.tokenBundle)
-    });
-    // clang-format on
+void cborizeOutput(Cbor::Writer& cbor, const TxOutput& output) {
+    cbor.array(2).bytes(output.address);
+    cborizeOutputAmounts(cbor, output.amount, output.tokenBundle);
 }
 
-Cbor::Encode cborizeOutputs(const std::vector<TxOutput>& outputs) {
-    std::vector<Cbor::Encode> oo;
+void cborizeOutputs(Cbor::Writer& cbor, const std::vector<TxOutput>& outputs) {
+    cbor.array(outputs.size());
     for (const auto& o : outputs) {
-        oo.emplace_back(cborizeOutput(o));
+        cborizeOutput(cbor, o);
     }
-    return Cbor::Encode::array(oo);
 }
 
-Cbor::Encode cborizeCertificateKey(const CertificateKey& certKey) {
-    std::vector<Cbor::Encode> c;
-    c.emplace_back(Cbor::Encode::uint(static_cast<uint8_t>(certKey.type)));
-    c.emplace_back(Cbor::Encode::bytes(certKey.key));
-    return Cbor::Encode::array(c);
+void cborizeCertificateKey(Cbor::Writer& cbor, const CertificateKey& certKey) {
+    cbor.array(2)
+        .uint(static_cast<uint8_t>(certKey.type))
+        .bytes(certKey.key);
 }
 
-Cbor::Encode cborizeDRepKey(const DRepKey& drepKey) {
-    std::vector<Cbor::Encode> c;
-    c.emplace_back(Cbor::Encode::uint(static_cast<uint8_t>(drepKey.type)));
-    if (drepKey.type == DRepKey::KeyType::AddressKeyHash) {
-        c.emplace_back(Cbor::Encode::bytes(drepKey.key));
+void cborizeDRepKey(Cbor::Writer& cbor, const DRepKey& drepKey) {
+    const bool hasKey = drepKey.type == DRepKey::KeyType::AddressKeyHash;
+    cbor.array(hasKey ? 2 : 1).uint(static_cast<uint8_t>(drepKey.type));
+    if (hasKey) {
+        cbor.bytes(drepKey.key);
     }
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeCert(const Certificate& cert) {
-    std::vector<Cbor::Encode> c;
-    c.emplace_back(Cbor::Encode::uint(static_cast<uint8_t>(cert.type)));
-    c.emplace_back(cborizeCertificateKey(cert.certKey));
+void cborizeCert(Cbor::Writer& cbor, const Certificate& cert) {
+    cbor.array(2 + (cert.poolId.empty() ? 0 : 1) + (cert.drepKey.has_value() ? 1 : 0))
+        .uint(static_cast<uint8_t>(cert.type));
+    cborizeCertificateKey(cbor, cert.certKey);
     if (!cert.poolId.empty()) {
-        c.emplace_back(Cbor::Encode::bytes(cert.poolId));
+        cbor.bytes(cert.poolId);
     }
     if (cert.drepKey.has_value()) {
-        c.emplace_back(cborizeDRepKey(cert.drepKey.value()));
+        cborizeDRepKey(cbor, cert.drepKey.value());
     }
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeCerts(const std::vector<Certificate>& certs) {
-    std::vector<Cbor::Encode> c;
+void cborizeCerts(Cbor::Writer& cbor, const std::vector<Certificate>& certs) {
+    cbor.array(certs.size());
     for (const auto& i : certs) {
-        c.emplace_back(cborizeCert(i));
+        cborizeCert(cbor, i);
     }
-    return Cbor::Encode::array(c);
 }
 
-Cbor::Encode cborizeWithdrawals(const std::vector<Withdrawal>& withdrawals) {
-    std::map<Cbor::Encode, Cbor::Encode> mapElems;
+void cborizeWithdrawals(Cbor::Writer& cbor, const std::vector<Withdrawal>& withdrawals) {
+    cbor.beginMap();
     for (const auto& w : withdrawals) {
-        mapElems.emplace(Cbor::Encode::bytes(w.stakingKey), Cbor::Encode::uint(w.amount));
+        cbor.bytes(w.stakingKey).uint(w.amount);
     }
-    return Cbor::Encode::map(mapElems);
+    cbor.endMap();
 }
 
-Data Transaction::encode() const {
-    const auto ii = cborizeInputs(inputs);
-    const auto oo = cborizeOutputs(outputs);
-
-    // Encode elements in a map, with fixed numbers as keys
-    std::map<Cbor::Encode, Cbor::Encode> mapElems = {
-        std::make_pair(Cbor::Encode::uint(0), ii),
-        std::make_pair(Cbor::Encode::uint(1), oo),
-        std::make_pair(Cbor::Encode::uint(2), Cbor::Encode::uint(fee)),
-        std::make_pair(Cbor::Encode::uint(3), Cbor::Encode::uint(ttl)),
-    };
+void Transaction::encode(Cbor::Writer& cbor) const {
+    // Encode elements in a map, with fixed numbers as keys, written in ascending (canonical) order
+    cbor.map(4 + (certificates.empty() ? 0 : 1) + (withdrawals.empty() ? 0 : 1));
+    cbor.uint(0);
+    cborizeInputs(cbor, inputs);
+    cbor.uint(1);
+    cborizeOutputs(cbor, outputs);
+    cbor.uint(2).uint(fee);
+    cbor.uint(3).uint(ttl);
 
     if (!certificates.empty()) {
-        mapElems.emplace(Cbor::Encode::uint(4), cborizeCerts(certificates));
+        cbor.uint(4);
+        cborizeCerts(cbor, certificates);
     }
     if (!withdrawals.empty()) {
-        mapElems.emplace(Cbor::Encode::uint(5), cborizeWithdrawals(withdrawals));
+        cbor.uint(5);
+        cborizeWithdrawals(cbor, withdrawals);
     }
 
-    Cbor::Encode encode = Cbor::Encode::map(mapElems);
-    return encode.encoded();
-
     // Note: following fields are not included:
     // 7 AUXILIARY_DATA_HASH, 8 VALIDITY_INTERVAL_START
 }
 
+Data Transaction::encode() const {
+    Cbor::Writer cbor;
+    encode(cbor);
+    return cbor.release();
+}
+
+/// Call `f` for every element of an array or map whose header has just been read, of definite or indefinite length
+template <typename F>
+void forEachElement(Cbor::Reader& cbor, std::optional<uint64_t> count, F f) {
+    for (uint64_t i = 0; count.has_value() ? i < *count : !cbor.readBreak(); ++i) {
+        f(i);
+    }
+}
+
+/// Inputs and certificates may be encoded as a set, with tag 258
+void skipSetTag(Cbor::Reader& cbor) {
+    if (cbor.peek().majorType == Cbor::Decode::MT_tag && cbor.readTag() != 258) {
+        throw std::invalid_argument("Unexpected CBOR tag");
+    }
+}
+
+std::vector<OutPoint> decodeInputs(Cbor::Reader& cbor) {
+    std::vector<OutPoint> inputs;
+    skipSetTag(cbor);
+    forEachElement(cbor, cbor.readArray(), [&](uint64_t) {
+        OutPoint input;
+        forEachElement(cbor, cbor.readArray(), [&](uint64_t i) {
+            if (i == 0) {
+                const auto txHash = cbor.readBytes();
+                input.txHash.assign(txHash.begin(), txHash.end());
+            } else if (i == 1) {
+                input.outputIndex = cbor.readValue();
+            } else {
+                cbor.skip();
+            }
+        });
+        inputs.push_back(std::move(input));
+    });
+    return inputs;
+}
+
+void decodeOutputAmounts(Cbor::Reader& cbor, TxOutput& output) {
+    if (cbor.peek().majorType == Cbor::Decode::MT_uint) {
+        // native amount only
+        output.amount = cbor.readValue();
+        return;
+    }
+    forEachElement(cbor, cbor.readArray(), [&](uint64_t i) {
+        if (i == 0) {
+            output.amount = cbor.readValue();
+        } else if (i == 1) {
+            // tokens: organized in two levels: by policyId and by assetName
+            forEachElement(cbor, cbor.readMap(), [&](uint64_t) {
+                const auto policyId = hex(cbor.readBytes());
+                forEachElement(cbor, cbor.readMap(), [&](uint64_t) {
+                    const auto assetName = cbor.readBytes();
+                    const auto amount = cbor.readValue();
+                    output.tokenBundle.add(TokenAmount(policyId, Data(assetName.begin(), assetName.end()), amount));
+                });
+            });
+        } else {
+            cbor.skip();
+        }
+    });
+}
+
+TxOutput decodeOutput(Cbor::Reader& cbor) {
+    TxOutput output;
+    const auto readAddress = [&] {
+        const auto address = cbor.readBytes();
+        output.address.assign(address.begin(), address.end());
+    };
+    if (cbor.peek().majorType == Cbor::Decode::MT_map) {
+        // post-Alonzo format, with field numbers as keys
+        forEachElement(cbor, cbor.readMap(), [&](uint64_t) {
+            const auto key = cbor.readValue();
+            if (key == 0) {
+                readAddress();
+            } else if (key == 1) {
+                decodeOutputAmounts(cbor, output);
+            } else {
+                cbor.skip();
+            }
+        });
+        return output;
+    }
+    forEachElement(cbor, cbor.readArray(), [&](uint64_t i) {
+        if (i == 0) {
+            readAddress();
+        } else if (i == 1) {
+            decodeOutputAmounts(cbor, output);
+        } else {
+            cbor.skip();
+        }
+    });
+    return output;
+}
+
+std::vector<TxOutput> decodeOutputs(Cbor::Reader& cbor) {
+    std::vector<TxOutput> outputs;
+    forEachElement(cbor, cbor.readArray(), [&](uint64_t) {
+        outputs.push_back(decodeOutput(cbor));
+    });
+    return outputs;
+}
+
+/// A [type, key] pair, as in CertificateKey and DRepKey
+std::pair<uint8_t, Data> decodeTypedKey(Cbor::Reader& cbor) {
+    std::pair<uint8_t, Data> typedKey;
+    forEachElement(cbor, cbor.readArray(), [&](uint64_t i) {
+        if (i == 0) {
+            typedKey.first = static_cast<uint8_t>(cbor.readValue());
+        } else if (i == 1) {
+            const auto key = cbor.readBytes();
+            typedKey.second.assign(key.begin(), key.end());
+        } else {
+            cbor.skip();
+        }
+    });
+    return typedKey;
+}
+
+std::vector<Certificate> decodeCerts(Cbor::Reader& cbor) {
+    std::vector<Certificate> certs;
+    skipSetTag(cbor);
+    forEachElement(cbor, cbor.readArray(), [&](uint64_t) {
+        Certificate cert{};
+        forEachElement(cbor, cbor.readArray(), [&](uint64_t i) {
+            if (i == 0) {
+                cert.type = static_cast<Certificate::CertificateType>(cbor.readValue());
+            } else if (i == 1) {
+                auto [type, key] = decodeTypedKey(cbor);
+                cert.certKey = CertificateKey{static_cast<CertificateKey::KeyType>(type), std::move(key)};
+            } else if (cbor.peek().majorType == Cbor::Decode::MT_bytes) {
+                const auto poolId = cbor.readBytes();
+                cert.poolId.assign(poolId.begin(), poolId.end());
+            } else if (cbor.peek().majorType == Cbor::Decode::MT_array) {
+                auto [type, key] = decodeTypedKey(cbor);
+                cert.drepKey = DRepKey{static_cast<DRepKey::KeyType>(type), std::move(key)};
+            } else {
+                cbor.skip();
+            }
+        });
+        certs.push_back(std::move(cert));
+    });
+    return certs;
+}
+
+std::vector<Withdrawal> decodeWithdrawals(Cbor::Reader& cbor) {
+    std::vector<Withdrawal> withdrawals;
+    forEachElement(cbor, cbor.readMap(), [&](uint64_t) {
+        const auto stakingKey = cbor.readBytes();
+        const auto amount = cbor.readValue();
+        withdrawals.push_back(Withdrawal{Data(stakingKey.begin(), stakingKey.end()), amount});
+    });
+    return withdrawals;
+}
+
+Transaction Transaction::decode(std::span<const byte> encoded) {
+    Transaction tx{};
+    Cbor::Reader cbor(encoded);
+    forEachElement(cbor, cbor.readMap(), [&](uint64_t) {
+        switch (cbor.readValue()) {
+        case 0:
+            tx.inputs = decodeInputs(cbor);
+            break;
+        case 1:
+            tx.outputs = decodeOutputs(cbor);
+            break;
+        case 2:
+            tx.fee = cbor.readValue();
+            break;
+        case 3:
+            tx.ttl = cbor.readValue();
+            break;
+        case 4:
+            tx.certificates = decodeCerts(cbor);
+            break;
+        case 5:
+            tx.withdrawals = decodeWithdrawals(cbor);
+            break;
+        default:
+            cbor.skip();
+            break;
+        }
+    });
+    return tx;
+}
+
 Data Transaction::getId() const {
     const auto encoded = encode();
     auto hash = Hash::blake2b(encoded, 32);
@@ -389,8 +555,7 @@ Data Transaction::getId() const {
 }
 
 /// https://github.com/Emurgo/cardano-serialization-lib/blob/78184e0a2c207c2f8bba57b0d3c437f4c808c125/rust/src/utils.rs#L1415
-std::optional<uint64_t> minAdaAmountHelper(const TxOutput& output, uint64_t coinsPerUtxoByte) noexcept {
-    const size_t outputSize = cborizeOutput(output).encoded().size();
+std::optional<uint64_t> minAdaAmountHelper(uint64_t outputSize, uint64_t coinsPerUtxoByte) noexcept {
     const auto outputSizeExtended = static_cast<uint64_t>(outputSize + 160);
     if (checkMulUnsignedOverflow(outputSizeExtended, coinsPerUtxoByte)) {
         return std::nullopt;
@@ -400,19 +565,20 @@ std::optional<uint64_t> minAdaAmountHelper(const TxOutput& output, uint64_t coin
 
 /// https://github.com/Emurgo/cardano-serialization-lib/blob/78184e0a2c207c2f8bba57b0d3c437f4c808c125/rust/src/utils.rs#L1388
 std::optional<uint64_t> TxOutput::minAdaAmount(uint64_t coinsPerUtxoByte) const noexcept {
-    // A copy of `this`.
-    TxOutput output(address, amount, tokenBundle);
+    // Only the size of the ADA amount changes between iterations, the token bundle is sized once.
+    const auto tokensSize = TxSizeModel::tokensSize(tokenBundle);
+    auto outputAmount = amount;
 
     while (true) {
-        const auto minAmount = minAdaAmountHelper(output, coinsPerUtxoByte);
+        const auto minAmount = minAdaAmountHelper(TxSizeModel::outputSize(address.size(), outputAmount, tokensSize), coinsPerUtxoByte);
         if (!minAmount) {
             return std::nullopt;
         }
-        if (output.amount >= *minAmount) {
+        if (outputAmount >= *minAmount) {
             return minAmount;
         }
         // Set the amount to `minAmount` and re-try again.
-        output.amount = *minAmount;
+        outputAmount = *minAmount;
     }
 }
 
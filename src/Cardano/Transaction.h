@@ -5,6 +5,7 @@
 #pragma once
 
 #include "AddressV3.h"
+#include "Cbor.h"
 
 #include "Data.h"
 #include "uint256.h"
@@ -196,6 +197,11 @@ public:
 
     // Encode into CBOR binary format
     Data encode() const;
+    // Encode into CBOR binary format, appending to an existing writer
+    void encode(Cbor::Writer& cbor) const;
+    // Decode a transaction body from CBOR binary format, throws on invalid input.
+    // Fields not represented here (e.g. auxiliary data hash, output datums) are skipped.
+    static Transaction decode(std::span<const byte> encoded);
 
     // Derive Transaction ID from hashed encoded data
     Data getId() const;
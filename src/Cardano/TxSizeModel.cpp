@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "TxSizeModel.h"
+
+#include "Cbor.h"
+
+namespace TW::Cardano {
+
+namespace {
+
+constexpr uint64_t headerSize(uint64_t value) {
+    return Cbor::Writer::headerSize(value);
+}
+
+uint64_t bytesSize(uint64_t length) {
+    return headerSize(length) + length;
+}
+
+uint64_t inputSize(const OutPoint& input) {
+    return 1 + bytesSize(input.txHash.size()) + headerSize(input.outputIndex);
+}
+
+uint64_t typedKeySize(bool hasKey, uint64_t keySize) {
+    return 1 + 1 + (hasKey ? bytesSize(keySize) : 0);
+}
+
+uint64_t certificateSize(const Certificate& cert) {
+    auto size = 1 + headerSize(cert.type) + typedKeySize(true, cert.certKey.key.size());
+    if (!cert.poolId.empty()) {
+        size += bytesSize(cert.poolId.size());
+    }
+    if (cert.drepKey.has_value()) {
+        size += typedKeySize(cert.drepKey->type == DRepKey::KeyType::AddressKeyHash, cert.drepKey->key.size());
+    }
+    return size;
+}
+
+uint64_t withdrawalSize(const Withdrawal& withdrawal) {
+    return bytesSize(withdrawal.stakingKey.size()) + headerSize(withdrawal.amount);
+}
+
+// Key witness: [public key (32 bytes), signature (64 bytes)]
+constexpr uint64_t vkeyWitnessSize = 1 + (2 + 32) + (2 + 64);
+// Bootstrap witness: [public key, signature, chain code (32 bytes), attributes (1 byte)]
+constexpr uint64_t bootstrapWitnessSize = 1 + (2 + 32) + (2 + 64) + (2 + 32) + (1 + 1);
+
+} // namespace
+
+uint64_t TxSizeModel::Section::size() const {
+    return headerSize(count) + bytes;
+}
+
+void TxSizeModel::Section::add(uint64_t itemSize) {
+    ++count;
+    bytes += itemSize;
+}
+
+TxSizeModel::TxSizeModel(const Transaction& tx) : _fee(tx.fee), _ttl(tx.ttl) {
+    for (const auto& i : tx.inputs) {
+        _inputs.add(inputSize(i));
+    }
+    for (const auto& o : tx.outputs) {
+        _outputs.add(outputSize(o));
+    }
+    for (const auto& c : tx.certificates) {
+        _certificates.add(certificateSize(c));
+    }
+    for (const auto& w : tx.withdrawals) {
+        _withdrawals.add(withdrawalSize(w));
+    }
+}
+
+void TxSizeModel::setWitnesses(std::size_t count, bool byron) {
+    _witnesses = count;
+    _byronWitnesses = byron;
+}
+
+uint64_t TxSizeModel::bodySize() const {
+    // map with fixed numbers as keys, each key 1 byte
+    uint64_t entries = 4;
+    uint64_t size = 1 + _inputs.size() + 1 + _outputs.size() + 1 + headerSize(_fee) + 1 + headerSize(_ttl);
+    if (_certificates.count > 0) {
+        ++entries;
+        size += 1 + _certificates.size();
+    }
+    if (_withdrawals.count > 0) {
+        ++entries;
+        size += 1 + _withdrawals.size();
+    }
+    return headerSize(entries) + size;
+}
+
+uint64_t TxSizeModel::size() const {
+    // witness set: map {0: key witnesses, 2: bootstrap witnesses}
+    const bool hasByron = _byronWitnesses && _witnesses > 0;
+    uint64_t witnessesSize = 1 + 1 + headerSize(_witnesses) + _witnesses * vkeyWitnessSize;
+    if (hasByron) {
+        witnessesSize += 1 + headerSize(_witnesses) + _witnesses * bootstrapWitnessSize;
+    }
+    // envelope: [body, witnesses, (version,) null]
+    return 1 + bodySize() + witnessesSize + (_voteDelegation ? 1 : 0) + 1;
+}
+
+uint64_t TxSizeModel::outputSize(const TxOutput& output) {
+    return outputSize(output.address.size(), output.amount, tokensSize(output.tokenBundle));
+}
+
+uint64_t TxSizeModel::outputSize(std::size_t addressSize, Amount amount, uint64_t tokensSize) {
+    // [address, amount] or [address, [amount, tokens]]
+    const auto amountsSize = tokensSize == 0 ? headerSize(amount) : 1 + headerSize(amount) + tokensSize;
+    return 1 + bytesSize(addressSize) + amountsSize;
+}
+
+uint64_t TxSizeModel::tokensSize(const TokenBundle& tokens) {
+    if (tokens.size() == 0) {
+        return 0;
+    }
+    // map by policyId, of maps by assetName
+    const auto policyIds = tokens.getPolicyIds();
+    uint64_t size = headerSize(policyIds.size());
+    for (const auto& policy : policyIds) {
+        const auto subTokens = tokens.getByPolicyId(policy);
+        size += bytesSize(policy.size() / 2) + headerSize(subTokens.size());
+        for (const auto& token : subTokens) {
+            size += bytesSize(token.assetName.size()) + headerSize(uint64_t(token.amount));
+        }
+    }
+    return size;
+}
+
+} // namespace TW::Cardano
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "Transaction.h"
+
+#include <cstdint>
+
+namespace TW::Cardano {
+
+/// Encoded size of a signed transaction, computed from the transaction body and the number of witnesses,
+/// so that fee estimation needs neither to encode nor to sign the transaction.
+/// Sizes match `Transaction::encode` and `Signer::encodeTransaction` byte for byte.
+class TxSizeModel {
+public:
+    TxSizeModel() = default;
+    /// Model of the transaction body `tx`, without witnesses
+    explicit TxSizeModel(const Transaction& tx);
+
+    void setFee(Amount fee) { _fee = fee; }
+    void setTtl(uint64_t ttl) { _ttl = ttl; }
+    /// Number of key witnesses (one per unique signing address); with `byron` each also has a bootstrap witness
+    void setWitnesses(std::size_t count, bool byron);
+    /// The vote delegation spec version is added to the envelope
+    void setVoteDelegation(bool voteDelegation) { _voteDelegation = voteDelegation; }
+
+    /// Size of the encoded transaction body
+    uint64_t bodySize() const;
+    /// Size of the encoded signed transaction: body, witnesses and auxiliary data
+    uint64_t size() const;
+
+    /// Size of an encoded output
+    static uint64_t outputSize(const TxOutput& output);
+    /// Size of an encoded output, with the size of its token bundle precomputed (see `tokensSize`)
+    static uint64_t outputSize(std::size_t addressSize, Amount amount, uint64_t tokensSize);
+    /// Size of the encoded token bundle of an output, without the ADA amount; 0 for no tokens
+    static uint64_t tokensSize(const TokenBundle& tokens);
+
+private:
+    /// A definite-length array or map: header for `count`, then `bytes` of content
+    struct Section {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+
+        uint64_t size() const;
+        void add(uint64_t itemSize);
+    };
+
+    Section _inputs;
+    Section _outputs;
+    Section _certificates;
+    Section _withdrawals;
+    Amount _fee = 0;
+    uint64_t _ttl = 0;
+    std::size_t _witnesses = 0;
+    bool _byronWitnesses = false;
+    bool _voteDelegation = false;
+};
+
+} // namespace TW::Cardano
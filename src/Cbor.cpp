@@ -6,6 +6,7 @@
 #include "HexCoding.h"
 #include "Numeric.h"
 
+#include <algorithm>
 #include <sstream>
 #include <cassert>
 
@@ -150,6 +151,176 @@ void Encode::appendIndefinite(byte majorType) {
 }
 
 
+Writer& Writer::uint(uint64_t value) {
+    appendValue(Decode::MT_uint, value);
+    return *this;
+}
+
+Writer& Writer::negInt(uint64_t value) {
+    if (value == 0) {
+        // special handling for -1, to avoid underflow, same as Encode
+        appendValue(Decode::MT_uint, 0);
+        return *this;
+    }
+    appendValue(Decode::MT_negint, value - 1);
+    return *this;
+}
+
+Writer& Writer::string(const std::string& str) {
+    appendValue(Decode::MT_string, str.size());
+    _data.insert(_data.end(), str.begin(), str.end());
+    return *this;
+}
+
+Writer& Writer::bytes(std::span<const byte> data) {
+    appendValue(Decode::MT_bytes, data.size());
+    _data.insert(_data.end(), data.begin(), data.end());
+    return *this;
+}
+
+Writer& Writer::array(uint64_t count) {
+    appendValue(Decode::MT_array, count);
+    return *this;
+}
+
+Writer& Writer::map(uint64_t count) {
+    appendValue(Decode::MT_map, count);
+    return *this;
+}
+
+Writer& Writer::beginMap() {
+    // the header is written on close, once the number of unique keys is known
+    _open.push_back(Open{OpenType::map, _data.size()});
+    return *this;
+}
+
+Writer& Writer::endMap() {
+    const auto start = _open.empty() ? 0 : _open.back().start;
+    close(OpenType::map);
+
+    struct Entry {
+        std::size_t key;
+        std::size_t value;
+        std::size_t end;
+    };
+    std::vector<Entry> entries;
+    Reader reader(std::span<const byte>(_data).subspan(start));
+    while (!reader.atEnd()) {
+        const auto key = start + reader.position();
+        reader.skip();
+        if (reader.atEnd()) {
+            throw invalid_argument("CBOR map key without value");
+        }
+        const auto value = start + reader.position();
+        reader.skip();
+        entries.push_back(Entry{key, value, start + reader.position()});
+    }
+
+    const auto keyOf = [this](const Entry& e) {
+        return std::span<const byte>(_data.data() + e.key, e.value - e.key);
+    };
+    const auto less = [&](const Entry& lhs, const Entry& rhs) {
+        const auto l = keyOf(lhs);
+        const auto r = keyOf(rhs);
+        return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end());
+    };
+    const auto equal = [&](const Entry& lhs, const Entry& rhs) {
+        const auto l = keyOf(lhs);
+        const auto r = keyOf(rhs);
+        return std::equal(l.begin(), l.end(), r.begin(), r.end());
+    };
+    // keep the first of duplicate keys, as std::map::emplace does
+    std::stable_sort(entries.begin(), entries.end(), less);
+    entries.erase(std::unique(entries.begin(), entries.end(), equal), entries.end());
+
+    const Data content(_data.begin() + static_cast<std::ptrdiff_t>(start), _data.end());
+    _data.resize(start);
+    appendValue(Decode::MT_map, entries.size());
+    for (const auto& e : entries) {
+        const auto first = content.begin() + static_cast<std::ptrdiff_t>(e.key - start);
+        _data.insert(_data.end(), first, first + static_cast<std::ptrdiff_t>(e.end - e.key));
+    }
+    return *this;
+}
+
+Writer& Writer::tag(uint64_t value) {
+    appendValue(Decode::MT_tag, value);
+    return *this;
+}
+
+Writer& Writer::null() {
+    appendValue(Decode::MT_special, 0x16);
+    return *this;
+}
+
+Writer& Writer::version(uint64_t value) {
+    appendValue(Decode::MT_special, value);
+    return *this;
+}
+
+Writer& Writer::beginIndefArray() {
+    _data.push_back((byte)((Decode::MT_array << 5) | 31));
+    _open.push_back(Open{OpenType::indefArray, _data.size()});
+    return *this;
+}
+
+Writer& Writer::endIndefArray() {
+    close(OpenType::indefArray);
+    // add closing break command
+    _data.push_back(0xFF);
+    return *this;
+}
+
+Writer& Writer::raw(std::span<const byte> encoded) {
+    _data.insert(_data.end(), encoded.begin(), encoded.end());
+    return *this;
+}
+
+const Data& Writer::encoded() const {
+    if (!_open.empty()) {
+        throw invalid_argument("CBOR Unclosed map or indefinite length building");
+    }
+    return _data;
+}
+
+Data Writer::release() {
+    encoded();
+    Data data = std::move(_data);
+    _data.clear();
+    return data;
+}
+
+void Writer::appendValue(byte majorType, uint64_t value) {
+    byte minorType = 0;
+    byte valueBytes = 0;
+    if (value < 24) {
+        minorType = (byte)value;
+    } else if (value <= 0xFF) {
+        minorType = 24;
+        valueBytes = 1;
+    } else if (value <= 0xFFFF) {
+        minorType = 25;
+        valueBytes = 2;
+    } else if (value <= 0xFFFFFFFF) {
+        minorType = 26;
+        valueBytes = 4;
+    } else {
+        minorType = 27;
+        valueBytes = 8;
+    }
+    _data.push_back((byte)((majorType << 5) | (minorType & 0x1F)));
+    for (auto i = valueBytes; i > 0; --i) {
+        _data.push_back((byte)(value >> (8 * (i - 1))));
+    }
+}
+
+void Writer::close(OpenType type) {
+    if (_open.empty() || _open.back().type != type) {
+        throw invalid_argument(type == OpenType::map ? "CBOR Not inside map" : "CBOR Not inside indefinite-length array");
+    }
+    _open.pop_back();
+}
+
 Decode::Decode(const Data& input)
 : data(std::make_shared<OrigDataRef>(input)) {
     // shared_ptr to original input data created
@@ -355,42 +526,10 @@ Decode Decode::getTagElement() const {
 
 bool Decode::isValid() const {
     try {
-        TypeDesc typeDesc = getTypeDesc();
-        switch (typeDesc.majorType) {
-            case MT_uint:
-            case MT_negint:
-            case MT_special:
-                return (typeDesc.byteCount <= subLen);
-
-            case MT_bytes:
-            case MT_string:
-                {
-                    auto len = (uint32_t)(typeDesc.byteCount + typeDesc.value);
-                    return (len <= subLen);
-                }
-
-            case MT_array:
-            case MT_map:
-                {
-                    uint32_t countMultiplier = (typeDesc.majorType == MT_map) ? 2 : 1;
-                    uint32_t len = getCompoundLength(countMultiplier);
-                    if (len > subLen) { return false; }
-                    auto count = typeDesc.isIndefiniteValue ? 0 : countMultiplier * typeDesc.value;
-                    uint32_t idx = typeDesc.byteCount;
-                    for (auto i = 0ul; i < count || typeDesc.isIndefiniteValue; ++i)
-                    {
-                        Decode nextElem = skipClone(idx);
-                        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) { break; }
-                        if (!nextElem.isValid()) { return false; }
-                        idx += nextElem.getTotalLen();
-                    }
-                    return true;
-                }
-
-            default:
-            case MT_tag:
-                return skipClone(typeDesc.byteCount).isValid();
-        }
+        // single linear pass, without materializing elements
+        Reader reader(std::span<const byte>(data->origData).subspan(subStart, subLen));
+        reader.skip();
+        return true;
     } catch (exception& ex) {
         return false;
     }
@@ -480,4 +619,187 @@ Data Decode::encoded() const
     return TW::data(data->origData.data() + subStart, subLen);
 }
 
+Reader::Header Reader::peek() const {
+    auto copy = *this;
+    return copy.readHeader();
+}
+
+uint64_t Reader::readValue() {
+    const auto header = readHeader();
+    if (header.majorType != Decode::MT_uint && header.majorType != Decode::MT_negint) {
+        throw invalid_argument("CBOR data type not a value-type");
+    }
+    return header.value;
+}
+
+std::span<const byte> Reader::readBytes() {
+    const auto header = readHeader();
+    if (header.majorType != Decode::MT_bytes && header.majorType != Decode::MT_string) {
+        throw invalid_argument("CBOR data type not bytes/string");
+    }
+    if (header.isIndefinite) {
+        throw invalid_argument("CBOR indefinite-length bytes/string not supported");
+    }
+    const auto start = _pos;
+    advance(header.value);
+    return _data.subspan(start, header.value);
+}
+
+std::string_view Reader::readString() {
+    const auto bytes = readBytes();
+    return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+std::optional<uint64_t> Reader::readArray() {
+    const auto header = readHeader(Decode::MT_array);
+    if (header.isIndefinite) {
+        return std::nullopt;
+    }
+    return header.value;
+}
+
+std::optional<uint64_t> Reader::readMap() {
+    const auto header = readHeader(Decode::MT_map);
+    if (header.isIndefinite) {
+        return std::nullopt;
+    }
+    return header.value;
+}
+
+uint64_t Reader::readTag() {
+    return readHeader(Decode::MT_tag).value;
+}
+
+uint64_t Reader::readSpecial() {
+    const auto header = readHeader(Decode::MT_special);
+    if (header.isIndefinite) {
+        throw invalid_argument("CBOR unexpected break");
+    }
+    return header.value;
+}
+
+bool Reader::readBreak() {
+    if (atEnd()) {
+        throw invalid_argument("CBOR data too short");
+    }
+    if (_data[_pos] != 0xFF) {
+        return false;
+    }
+    ++_pos;
+    return true;
+}
+
+std::span<const byte> Reader::skip() {
+    const auto start = _pos;
+    skipItem(0);
+    return _data.subspan(start, _pos - start);
+}
+
+Reader::Header Reader::readHeader() {
+    if (atEnd()) {
+        throw invalid_argument("CBOR data too short");
+    }
+    Header header;
+    header.majorType = (Decode::MajorType)(_data[_pos] >> 5);
+    const byte minorType = _data[_pos] & 0x1F;
+    ++_pos;
+    if (minorType < 24) {
+        header.value = minorType;
+        return header;
+    }
+    if (minorType >= 28 && minorType <= 30) {
+        throw invalid_argument("CBOR unassigned type not supported");
+    }
+    if (minorType == 31) {
+        if (header.majorType == Decode::MT_uint || header.majorType == Decode::MT_negint || header.majorType == Decode::MT_tag) {
+            throw invalid_argument("CBOR invalid indefinite length");
+        }
+        header.isIndefinite = true;
+        return header;
+    }
+    const auto byteCount = 1ul << (minorType - 24);
+    if (byteCount > _data.size() - _pos) {
+        throw invalid_argument("CBOR data too short");
+    }
+    for (auto i = 0ul; i < byteCount; ++i) {
+        header.value = (header.value << 8) | _data[_pos++];
+    }
+    return header;
+}
+
+Reader::Header Reader::readHeader(Decode::MajorType expectedType) {
+    const auto header = readHeader();
+    if (header.majorType != expectedType) {
+        throw invalid_argument("CBOR data type mismatch");
+    }
+    return header;
+}
+
+void Reader::skipItem(std::size_t depth) {
+    if (depth > maxDepth) {
+        throw invalid_argument("CBOR nesting too deep");
+    }
+    const auto header = readHeader();
+    switch (header.majorType) {
+        case Decode::MT_uint:
+        case Decode::MT_negint:
+            return;
+
+        case Decode::MT_bytes:
+        case Decode::MT_string:
+            if (!header.isIndefinite) {
+                advance(header.value);
+                return;
+            }
+            // definite-length chunks of the same type, up to a break
+            while (!readBreak()) {
+                const auto chunk = readHeader(header.majorType);
+                if (chunk.isIndefinite) {
+                    throw invalid_argument("CBOR invalid indefinite-length chunk");
+                }
+                advance(chunk.value);
+            }
+            return;
+
+        case Decode::MT_array:
+        case Decode::MT_map: {
+            const uint64_t itemsPerElement = header.majorType == Decode::MT_map ? 2 : 1;
+            if (header.isIndefinite) {
+                while (!readBreak()) {
+                    for (auto i = 0ul; i < itemsPerElement; ++i) {
+                        skipItem(depth + 1);
+                    }
+                }
+                return;
+            }
+            // every item takes at least one byte, reject impossible counts before looping
+            if (header.value > (_data.size() - _pos) / itemsPerElement) {
+                throw invalid_argument("CBOR array data too short");
+            }
+            for (auto i = 0ul; i < header.value * itemsPerElement; ++i) {
+                skipItem(depth + 1);
+            }
+            return;
+        }
+
+        case Decode::MT_tag:
+            skipItem(depth + 1);
+            return;
+
+        default:
+        case Decode::MT_special:
+            if (header.isIndefinite) {
+                throw invalid_argument("CBOR unexpected break");
+            }
+            return;
+    }
+}
+
+void Reader::advance(uint64_t count) {
+    if (count > _data.size() - _pos) {
+        throw invalid_argument("CBOR bytes/string data too short");
+    }
+    _pos += count;
+}
+
 } // namespace TW::Cbor
@@ -6,9 +6,13 @@
 
 #include "Data.h"
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
 #include <vector>
 #include <map>
 
@@ -78,6 +82,73 @@ inline bool operator<(const Encode& lhs, const Encode& rhs) {
     return lhs.getDataInternal() < rhs.getDataInternal();
 }
 
+/// Streaming CBOR encoder, writes every item straight into a single output buffer.
+/// Items follow each other in document order: a definite-length array or map header is written
+/// up front with its element count, and the next `count` items (or key/value pairs) are its content.
+/// Maps opened with `beginMap` are emitted in canonical key order (as `Encode::map`) when closed.
+/// See CborTests.cpp for usage.
+class Writer {
+public:
+    Writer() = default;
+    /// Create with a reserved output capacity
+    explicit Writer(std::size_t capacity) { _data.reserve(capacity); }
+
+    /// encode an unsigned int
+    Writer& uint(uint64_t value);
+    /// encode a negative int (positive is given)
+    Writer& negInt(uint64_t value);
+    /// encode a string
+    Writer& string(const std::string& str);
+    /// encode a byte array
+    Writer& bytes(std::span<const byte> data);
+    /// start a definite-length array, the next `count` items are its elements
+    Writer& array(uint64_t count);
+    /// start a definite-length map, the next `count` key/value pairs are its entries, already in canonical order
+    Writer& map(uint64_t count);
+    /// start a map with keys in any order; entries are sorted by encoded key and duplicates dropped in `endMap`
+    Writer& beginMap();
+    /// close a map opened with `beginMap`
+    Writer& endMap();
+    /// encode a tag, the next item is the tagged element
+    Writer& tag(uint64_t value);
+    /// encode a null value (special)
+    Writer& null();
+    /// encode a version
+    Writer& version(uint64_t value);
+    /// Start an indefinite-length array
+    Writer& beginIndefArray();
+    /// Close an indefinite-length array
+    Writer& endIndefArray();
+    /// Append raw content, must be valid CBOR item(s), not checked
+    Writer& raw(std::span<const byte> encoded);
+
+    /// Return encoded bytes, throws if a map or indefinite array is still open
+    const Data& encoded() const;
+    /// Move the encoded bytes out, the writer is left empty
+    Data release();
+    /// Number of bytes written so far
+    std::size_t size() const { return _data.size(); }
+    /// Number of bytes of the header of an item with `value` (an unsigned int, or a length or count)
+    static constexpr std::size_t headerSize(uint64_t value) {
+        return value < 24 ? 1 : value <= 0xFF ? 2 : value <= 0xFFFF ? 3 : value <= 0xFFFFFFFF ? 5 : 9;
+    }
+
+private:
+    enum class OpenType : byte { indefArray, map };
+    struct Open {
+        OpenType type;
+        /// start of the content in `_data`
+        std::size_t start;
+    };
+    void appendValue(byte majorType, uint64_t value);
+    void close(OpenType type);
+
+private:
+    TW::Data _data;
+    /// currently open maps and indefinite arrays, innermost last
+    std::vector<Open> _open;
+};
+
 /// CBOR Decoder and container for data for decoding.  Contains reference to read-only CBOR data.
 /// See CborTests.cpp for usage.
 class Decode {
@@ -155,4 +226,58 @@ private:
     uint32_t subLen;
 };
 
+/// Non-owning, forward-only CBOR reader (cursor) over a byte span.
+/// Items are read in document order without allocation; a subtree that is not needed is stepped over
+/// with `skip`. Strings and byte arrays are returned as views into the input, valid as long as the input is.
+/// See CborTests.cpp for usage.
+class Reader {
+public:
+    struct Header {
+        Decode::MajorType majorType = Decode::MT_uint;
+        uint64_t value = 0;
+        bool isIndefinite = false;
+    };
+
+    /// Nesting depth accepted by `skip`, deeper input is rejected instead of exhausting the stack
+    static constexpr std::size_t maxDepth = 1024;
+
+    explicit Reader(std::span<const byte> data) : _data(data) {}
+
+    /// True if all input has been read
+    bool atEnd() const { return _pos >= _data.size(); }
+    /// Offset of the next item in the input
+    std::size_t position() const { return _pos; }
+    /// Header of the next item, without consuming it
+    Header peek() const;
+
+    /// Read an unsigned or negative int, return the raw value (as Decode::getValue)
+    uint64_t readValue();
+    /// Read a byte array, as a view into the input
+    std::span<const byte> readBytes();
+    /// Read a string, as a view into the input
+    std::string_view readString();
+    /// Read an array header, return the number of elements, or nullopt for indefinite length (elements end with a break, see `readBreak`)
+    std::optional<uint64_t> readArray();
+    /// Read a map header, return the number of key/value pairs, or nullopt for indefinite length
+    std::optional<uint64_t> readMap();
+    /// Read a tag number, the tagged element is the next item
+    uint64_t readTag();
+    /// Read a special value (e.g. null, version), return its value
+    uint64_t readSpecial();
+    /// If the next item is the break closing an indefinite-length container, consume it and return true
+    bool readBreak();
+    /// Step over the next item with its whole subtree, return its encoded bytes
+    std::span<const byte> skip();
+
+private:
+    Header readHeader();
+    Header readHeader(Decode::MajorType expectedType);
+    void skipItem(std::size_t depth);
+    void advance(uint64_t count);
+
+private:
+    std::span<const byte> _data;
+    std::size_t _pos = 0;
+};
+
 } // namespace TW::Cbor
@@ -4,11 +4,73 @@
 
 #include "Crc.h"
 
+#include <array>
+#include <cstring>
 #include <limits>
 #include <string>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TW_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#endif
+
 using namespace TW;
 
+namespace {
+
+constexpr uint32_t crc32cPolynomial = 0x82f63b78; // reversed 0x1edc6f41
+
+constexpr std::array<uint32_t, 256> crc32cTable = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (auto bit = 0; bit < 8; ++bit) {
+            c = (c & 1) ? (c >> 1) ^ crc32cPolynomial : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}();
+
+uint32_t crc32cSoftware(uint32_t c, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        c = crc32cTable[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c;
+}
+
+#ifdef TW_CRC32C_SSE42
+
+bool hasSse42() {
+    static const bool supported = __builtin_cpu_supports("sse4.2") != 0;
+    return supported;
+}
+
+__attribute__((target("sse4.2"))) uint32_t crc32cSse42(uint32_t c, const uint8_t* data, size_t size) {
+#if defined(__x86_64__)
+    uint64_t c64 = c;
+    for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        c64 = _mm_crc32_u64(c64, word);
+    }
+    c = static_cast<uint32_t>(c64);
+#endif
+    for (; size >= sizeof(uint32_t); data += sizeof(uint32_t), size -= sizeof(uint32_t)) {
+        uint32_t word;
+        std::memcpy(&word, data, sizeof(word));
+        c = _mm_crc32_u32(c, word);
+    }
+    for (; size > 0; ++data, --size) {
+        c = _mm_crc32_u8(c, *data);
+    }
+    return c;
+}
+
+#endif
+
+} // namespace
+
 uint16_t Crc::crc16(uint8_t* bytes, uint32_t length) {
     // Calculate checksum for existing bytes
     uint16_t crc = 0x0000;
@@ -39,6 +101,16 @@ uint32_t Crc::crc32(const Data& data) {
     return ~c;
 }
 
+uint32_t Crc::crc32c(const uint8_t* data, size_t size) {
+    uint32_t c = std::numeric_limits<uint32_t>::max();
+#ifdef TW_CRC32C_SSE42
+    if (hasSse42()) {
+        return ~crc32cSse42(c, data, size);
+    }
+#endif
+    return ~crc32cSoftware(c, data, size);
+}
+
 Data Crc::crc16_xmodem(const Data& data) {
     uint16_t crc16 = 0x0;
 
@@ -15,6 +15,10 @@ uint16_t crc16(uint8_t* bytes, uint32_t length);
 
 uint32_t crc32(const TW::Data& data);
 
+/// CRC32C (Castagnoli) checksum, as used by TON bags of cells.
+/// Uses the SSE4.2 CRC32 instruction when the CPU supports it.
+uint32_t crc32c(const uint8_t* data, size_t size);
+
 /// CRC16-XModem implementation compatible with the Stellar version
 // Taken from: https://github.com/stellar/js-stellar-base/blob/087e2d651a59b5cbed01386b4b8c45862d358259/src/strkey.js#L353
 // Computes the CRC16-XModem checksum of `payload` in little-endian order
@@ -89,6 +89,8 @@ Result<Transaction, Common::Proto::SigningError> Signer::sign() {
     }
 
     signedInputs = _transaction.inputs;
+    // the signature hashes do not depend on the input scripts, so all inputs are signed against the unsigned transaction
+    _transaction.precomputeSighash();
 
     const auto hashSingle = Bitcoin::hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
     for (auto i = 0ul; i < txPlan.utxos.size(); i += 1) {
@@ -100,10 +102,12 @@ Result<Transaction, Common::Proto::SigningError> Signer::sign() {
         }
         auto result = sign(utxo.script, i);
         if (!result) {
+            _transaction.sighashCache.reset();
             return Result<Transaction, Common::Proto::SigningError>::failure(result.error());
         }
         signedInputs[i].script = result.payload();
     }
+    _transaction.sighashCache.reset();
 
     Transaction tx(_transaction);
     tx.inputs = std::move(signedInputs);
@@ -141,9 +145,7 @@ Result<Bitcoin::Script, Common::Proto::SigningError> Signer::sign(Bitcoin::Scrip
 }
 
 Result<std::vector<Data>, Common::Proto::SigningError> Signer::signStep(Bitcoin::Script script, size_t index) {
-    Transaction transactionToSign(_transaction);
-    transactionToSign.inputs = signedInputs;
-    transactionToSign.outputs = _transaction.outputs;
+    const auto& transactionToSign = _transaction;
 
     Data data;
     std::vector<Data> keys;
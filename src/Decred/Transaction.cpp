@@ -7,6 +7,7 @@
 #include "../Bitcoin/SigHashType.h"
 #include "../BinaryCoding.h"
 
+#include <array>
 #include <cassert>
 
 namespace TW::Decred {
@@ -18,8 +19,14 @@ static const uint32_t sigHashSerializePrefix = 1;
 // Indicates the serialization only contains witness data.
 static const uint32_t sigHashSerializeWitness = 3;
 
-std::size_t sigHashWitnessSize(const std::vector<TransactionInput>& inputs,
-                               const Bitcoin::Script& signScript);
+/// Commits to `count` nil scripts, encoded as a single 0x00 byte each.
+void updateNilScripts(Hash::Blake256Context& context, std::size_t count) {
+    static const std::array<byte, 64> nilScripts{};
+    for (; count > nilScripts.size(); count -= nilScripts.size()) {
+        context.update(nilScripts);
+    }
+    context.update(nilScripts.data(), count);
+}
 } // namespace
 
 Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, size_t index,
@@ -31,46 +38,43 @@ Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, siz
                                     "larger than the number of outputs");
     }
 
-    auto inputsToSign = inputs;
-    auto signIndex = index;
-    if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0) {
-        inputsToSign.clear();
-        inputsToSign.push_back(inputs[index]);
-        signIndex = 0;
-    }
-
-    auto outputsToSign = outputs;
-    switch (hashType & Bitcoin::SigHashMask) {
-    case TWBitcoinSigHashTypeNone:
-        outputsToSign = {};
-        break;
-    case TWBitcoinSigHashTypeSingle:
-        outputsToSign.clear();
-        std::copy(outputs.begin(), outputs.begin() + index + 1, std::back_inserter(outputsToSign));
-        break;
-    default:
-        // Keep all outputs
-        break;
-    }
-
     auto preimage = Data();
     preimage.reserve(Hash::sha256Size * 2 + 4);
     encode32LE(hashType, preimage);
 
-    const auto prefixHash =
-        computePrefixHash(inputsToSign, outputsToSign, signIndex, index, hashType);
-    std::copy(prefixHash.begin(), prefixHash.end(), std::back_inserter(preimage));
+    // the prefix hash of SigHashAll does not depend on the input being signed
+    const auto signsAll = (hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
+                          !Bitcoin::hashTypeIsNone(hashType) && !Bitcoin::hashTypeIsSingle(hashType);
+    if (signsAll && sighashCache.has_value()) {
+        append(preimage, sighashCache->prefixHashAll);
+    } else {
+        append(preimage, computePrefixHash(index, hashType));
+    }
 
-    const auto witnessHash = computeWitnessHash(inputsToSign, prevOutScript, signIndex);
-    std::copy(witnessHash.begin(), witnessHash.end(), std::back_inserter(preimage));
+    append(preimage, computeWitnessHash(prevOutScript, index, hashType));
 
     return Hash::blake256(preimage);
 }
 
-Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsToSign,
-                                    const std::vector<TransactionOutput>& outputsToSign,
-                                    std::size_t signIndex, std::size_t index,
-                                    enum TWBitcoinSigHashType hashType) const {
+void Transaction::precomputeSighash() {
+    sighashCache.reset();
+    auto prefixHashAll = computePrefixHash(0, TWBitcoinSigHashTypeAll);
+    sighashCache = SighashCache{std::move(prefixHashAll), witnessHeaderContext(inputs.size())};
+}
+
+Data Transaction::computePrefixHash(std::size_t index, enum TWBitcoinSigHashType hashType) const {
+    // With AnyoneCanPay, only the input being signed is committed to
+    const auto anyoneCanPay = (hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0;
+    const auto firstInput = anyoneCanPay ? index : 0;
+    const auto endInput = anyoneCanPay ? index + 1 : inputs.size();
+
+    auto outputCount = outputs.size();
+    if (Bitcoin::hashTypeIsNone(hashType)) {
+        outputCount = 0;
+    } else if (Bitcoin::hashTypeIsSingle(hashType)) {
+        outputCount = index + 1;
+    }
+
     auto preimage = Data{};
 
     // Commit to the version and hash serialization type.
@@ -79,32 +83,32 @@ Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsT
                preimage);
 
     // Commit to the relevant transaction inputs.
-    encodeVarInt(inputsToSign.size(), preimage);
-    for (auto i = 0ul; i < inputsToSign.size(); i += 1) {
-        auto& input = inputsToSign[i];
+    encodeVarInt(endInput - firstInput, preimage);
+    for (auto i = firstInput; i < endInput; i += 1) {
+        auto& input = inputs[i];
         input.previousOutput.encode(preimage);
 
         auto sequence = input.sequence;
         if ((Bitcoin::hashTypeIsNone(hashType) || Bitcoin::hashTypeIsSingle(hashType)) &&
-            i != signIndex) {
+            i != index) {
             sequence = 0;
         }
         encode32LE(sequence, preimage);
     }
 
     // Commit to the relevant transaction outputs.
-    encodeVarInt(outputsToSign.size(), preimage);
-    for (auto i = 0ul; i < outputsToSign.size(); i += 1) {
-        auto& output = outputsToSign[i];
-        auto value = output.value;
-        auto pkScript = output.script;
+    encodeVarInt(outputCount, preimage);
+    for (auto i = 0ul; i < outputCount; i += 1) {
+        auto& output = outputs[i];
         if (Bitcoin::hashTypeIsSingle(hashType) && i != index) {
-            value = -1;
-            pkScript = {};
+            encode64LE(static_cast<uint64_t>(-1), preimage);
+            encode16LE(output.version, preimage);
+            Bitcoin::Script().encode(preimage);
+            continue;
         }
-        encode64LE(value, preimage);
+        encode64LE(output.value, preimage);
         encode16LE(output.version, preimage);
-        pkScript.encode(preimage);
+        output.script.encode(preimage);
     }
 
     encode32LE(lockTime, preimage);
@@ -113,29 +117,43 @@ Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsT
     return Hash::blake256(preimage);
 }
 
-Data Transaction::computeWitnessHash(const std::vector<TransactionInput>& inputsToSign,
-                                     const Bitcoin::Script& signScript,
-                                     std::size_t signIndex) const {
-    const auto size = sigHashWitnessSize(inputsToSign, signScript);
-    auto witnessBuf = Data();
-    witnessBuf.reserve(size);
+Data Transaction::computeWitnessHash(const Bitcoin::Script& signScript, std::size_t index,
+                                     enum TWBitcoinSigHashType hashType) const {
+    // With AnyoneCanPay, only the input being signed is committed to
+    const auto anyoneCanPay = (hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0;
+    const auto inputCount = anyoneCanPay ? 1 : inputs.size();
+    const auto signIndex = anyoneCanPay ? 0 : index;
+
+    auto context = !anyoneCanPay && sighashCache.has_value() ? sighashCache->witnessHeader
+                                                             : witnessHeaderContext(inputCount);
+
+    // The prevout pkscript is replaced by nil for all inputs except the input being signed.
+    updateNilScripts(context, signIndex);
+    auto script = Data();
+    script.reserve(varIntSize(signScript.bytes.size()) + signScript.bytes.size());
+    signScript.encode(script);
+    context.update(script);
+    updateNilScripts(context, inputCount - signIndex - 1);
+
+    const auto hash = context.final();
+    return Data(hash.begin(), hash.end());
+}
+
+Hash::Blake256Context Transaction::witnessHeaderContext(std::size_t inputCount) const {
+    auto header = Data();
+    header.reserve(4 + 9);
 
     // Commit to the version and hash serialization type.
     encode32LE(static_cast<uint32_t>(version) |
                    (static_cast<uint32_t>(sigHashSerializeWitness) << 16),
-               witnessBuf);
+               header);
 
-    // Commit to the relevant transaction inputs.
-    encodeVarInt(inputsToSign.size(), witnessBuf);
-    for (auto i = 0ul; i < inputsToSign.size(); i += 1) {
-        if (i == signIndex) {
-            signScript.encode(witnessBuf);
-        } else {
-            Bitcoin::Script().encode(witnessBuf);
-        }
-    }
+    // Commit to the number of inputs.
+    encodeVarInt(inputCount, header);
 
-    return Hash::blake256(witnessBuf);
+    Hash::Blake256Context context;
+    context.update(header);
+    return context;
 }
 
 Data Transaction::hash() const {
@@ -209,29 +227,4 @@ Proto::Transaction Transaction::proto() const {
     return protoTx;
 }
 
-namespace {
-/// Returns the number of bytes the passed parameters would take when encoded
-/// with the format used by the witness hash portion of the overall signature
-/// hash.
-std::size_t sigHashWitnessSize(const std::vector<TransactionInput>& inputs,
-                               const Bitcoin::Script& signScript) {
-    // 1) 4 bytes version/serialization type
-    // 2) number of inputs varint
-    // 3) per input:
-    //    a) prevout pkscript varint (1 byte if not input being signed)
-    //    b) N bytes prevout pkscript (0 bytes if not input being signed)
-    //
-    // NOTE: The prevout pkscript is replaced by nil for all inputs except
-    // the input being signed.  Thus, all other inputs (aka numTxIns-1) commit
-    // to a nil script which gets encoded as a single 0x00 byte.  This is
-    // because encoding 0 as a varint results in 0x00 and there is no script
-    // to write.  So, rather than looping through all inputs and manually
-    // calculating the size per input, use (numTxIns - 1) as an
-    // optimization.
-    const auto numTxIns = inputs.size();
-    return 4 + varIntSize(numTxIns) + (numTxIns - 1) + varIntSize(signScript.bytes.size()) +
-           signScript.bytes.size();
-}
-} // namespace
-
 } // namespace TW::Decred
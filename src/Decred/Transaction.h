@@ -10,15 +10,26 @@
 #include "Bitcoin/Transaction.h"
 #include "Bitcoin/Script.h"
 #include "Data.h"
+#include "HashContext.h"
 #include "../proto/Decred.pb.h"
 
 #include "Bitcoin/SignatureVersion.h"
+#include <optional>
 #include <vector>
 
 namespace TW::Decred {
 
 enum class SerializeType : uint16_t { full, noWitness, onlyWitness };
 
+/// Signature hash components that are shared by all inputs of a transaction.
+struct SighashCache {
+    /// Prefix hash of SigHashAll, which commits to all inputs and outputs.
+    Data prefixHashAll;
+
+    /// Witness hash state after the version, serialization type and number of inputs.
+    Hash::Blake256Context witnessHeader;
+};
+
 struct Transaction {
     /// Serialization format
     SerializeType serializeType = SerializeType::full;
@@ -40,6 +51,10 @@ struct Transaction {
     /// valid.
     uint32_t expiry = 0;
 
+    /// Precomputed signature hash components, see `precomputeSighash()`.
+    /// Must be reset if the inputs or outputs are changed afterwards.
+    std::optional<SighashCache> sighashCache;
+
     Transaction()
         : inputs()
         , outputs() {}
@@ -51,6 +66,10 @@ struct Transaction {
     Data computeSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                               enum TWBitcoinSigHashType hashType) const;
 
+    /// Computes the signature hash components shared by all inputs once, so that signing N inputs
+    /// does not reserialize and rehash all the inputs and outputs N times.
+    void precomputeSighash();
+
     /// Generates the transaction hash.
     Data hash() const;
 
@@ -61,11 +80,10 @@ struct Transaction {
     Proto::Transaction proto() const;
 
   private:
-    Data computePrefixHash(const std::vector<TransactionInput>& inputsToSign,
-                           const std::vector<TransactionOutput>& outputsToSign,
-                           std::size_t signIndex, std::size_t index, enum TWBitcoinSigHashType hashType) const;
-    Data computeWitnessHash(const std::vector<TransactionInput>& inputsToSign,
-                            const Bitcoin::Script& signScript, std::size_t signIndex) const;
+    Data computePrefixHash(std::size_t index, enum TWBitcoinSigHashType hashType) const;
+    Data computeWitnessHash(const Bitcoin::Script& signScript, std::size_t index,
+                            enum TWBitcoinSigHashType hashType) const;
+    Hash::Blake256Context witnessHeaderContext(std::size_t inputCount) const;
 
     void encodePrefix(Data& data) const;
     void encodeWitness(Data& data) const;
@@ -4,6 +4,7 @@
 
 #include "Address.h"
 #include "AddressChecksum.h"
+#include "../Hash.h"
 #include "../HexCoding.h"
 
 namespace TW::Ethereum {
@@ -35,8 +36,9 @@ Address::Address(const PublicKey& publicKey) {
     if (publicKey.type != TWPublicKeyTypeSECP256k1Extended) {
         throw std::invalid_argument("Ethereum::Address needs an extended SECP256k1 public key.");
     }
-    const auto data = publicKey.hash({}, Hash::HasherKeccak256, true);
-    std::copy(data.end() - Address::size, data.end(), bytes.begin());
+    Hash::Digest<32> hash;
+    Hash::keccak256(publicKey.bytes.data() + 1, publicKey.bytes.size() - 1, hash);
+    std::copy(hash.end() - Address::size, hash.end(), bytes.begin());
 }
 
 std::string Address::string() const {
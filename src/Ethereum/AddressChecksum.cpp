@@ -11,7 +11,9 @@ namespace TW::Ethereum {
 
 std::string checksumed(const Address& address) {
     const auto addressString = hex(address.bytes);
-    const auto hash = hex(Hash::keccak256(addressString));
+    Hash::Digest<32> digest;
+    Hash::keccak256(reinterpret_cast<const byte*>(addressString.data()), addressString.size(), digest);
+    const auto hash = hex(digest);
 
     std::string string = "0x";
     for (auto i = 0ul; i < std::min(addressString.size(), hash.size()); i += 1) {
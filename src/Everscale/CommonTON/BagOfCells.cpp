@@ -0,0 +1,478 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "BagOfCells.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "BinaryCoding.h"
+#include "Crc.h"
+
+using namespace TW;
+
+namespace TW::CommonTON {
+
+constexpr static uint8_t ABSENT_CELL_D1 = 7 + 16; // 7 references with stored hashes
+constexpr static size_t STORED_HASH_SIZE = Hash::sha256Size + sizeof(uint16_t);
+constexpr static size_t CRC_SIZE = sizeof(uint32_t);
+constexpr static auto NOT_LOADED = std::numeric_limits<CellArena::Index>::max();
+
+uint16_t computeBitLen(const uint8_t* _Nonnull data, size_t len, bool aligned) {
+    auto bitLen = static_cast<uint16_t>(len * 8);
+    if (aligned) {
+        return bitLen;
+    }
+
+    for (auto i = static_cast<int64_t>(len - 1); i >= 0; --i) {
+        const auto index = static_cast<size_t>(i);
+        if (data[index] == 0) {
+            bitLen -= 8;
+        } else {
+            auto skip = 1;
+            uint8_t mask = 1;
+            while ((data[index] & mask) == 0) {
+                skip += 1;
+                mask <<= 1;
+            }
+            bitLen -= skip;
+            break;
+        }
+    }
+    return bitLen;
+}
+
+struct Reader {
+    const uint8_t* _Nonnull buffer;
+    size_t bufferLen;
+    size_t offset = 0;
+
+    explicit Reader(const uint8_t* _Nonnull buffer, size_t len, size_t offset = 0) noexcept
+        : buffer(buffer), bufferLen(len), offset(offset) {
+    }
+
+    void require(size_t bytes) const {
+        if (offset > bufferLen || bytes > bufferLen - offset) {
+            throw std::runtime_error("unexpected eof");
+        }
+    }
+
+    void advance(size_t bytes) {
+        offset += bytes;
+    }
+
+    const uint8_t* _Nonnull data() const {
+        return buffer + offset;
+    }
+
+    // Big-endian unsigned integer of `len` bytes, up to 8
+    uint64_t readNextUint(uint8_t len) {
+        const auto* _Nonnull p = data();
+        advance(len);
+
+        uint64_t value = 0;
+        for (uint8_t i = 0; i < len; ++i) {
+            value = (value << 8) | p[i];
+        }
+        return value;
+    }
+};
+
+// Smallest number of bytes to represent `value`, at least 1
+uint8_t byteSize(uint64_t value) {
+    uint8_t size = 1;
+    while (size < sizeof(value) && (value >> (8 * size)) != 0) {
+        ++size;
+    }
+    return size;
+}
+
+void encodeUint(uint64_t value, uint8_t len, Data& os) {
+    for (auto i = len; i > 0; --i) {
+        os.push_back(static_cast<uint8_t>(value >> (8 * (i - 1))));
+    }
+}
+
+void serializeBoc(const CellArena& arena, std::span<const CellArena::Index> roots, Data& os, const BocOptions& options) {
+    if (roots.empty()) {
+        throw std::invalid_argument("no root cells");
+    }
+    if (options.hasCacheBits && !options.indexIncluded) {
+        throw std::invalid_argument("cache bits require the index");
+    }
+
+    // Post-order of a depth-first traversal from the roots; reversed, parents precede their children
+    constexpr auto NOT_VISITED = std::numeric_limits<size_t>::max();
+    std::vector<size_t> positions(arena.size(), NOT_VISITED);
+    std::vector<CellArena::Index> postOrder{};
+    std::vector<std::pair<CellArena::Index, uint8_t>> stack{};
+    std::vector<bool> isRoot(arena.size(), false);
+    for (const auto root : roots) {
+        if (root >= arena.size()) {
+            throw std::invalid_argument("root cell not found");
+        }
+        // every root is stored in the header, the reader rejects more roots than cells
+        if (isRoot[root]) {
+            throw std::invalid_argument("duplicate root cell");
+        }
+        isRoot[root] = true;
+        if (positions[root] != NOT_VISITED) {
+            continue;
+        }
+        positions[root] = 0;
+        stack.emplace_back(root, 0);
+        while (!stack.empty()) {
+            auto& [cell, next] = stack.back();
+            const auto references = arena.references(cell);
+            if (next < references.size()) {
+                const auto child = references[next++];
+                if (positions[child] == NOT_VISITED) {
+                    positions[child] = 0;
+                    stack.emplace_back(child, 0);
+                }
+                continue;
+            }
+            postOrder.push_back(cell);
+            stack.pop_back();
+        }
+    }
+
+    const auto cellCount = postOrder.size();
+    for (size_t i = 0; i < cellCount; ++i) {
+        positions[postOrder[i]] = cellCount - 1 - i;
+    }
+
+    const uint8_t refSize = options.refSize != 0 ? options.refSize : byteSize(cellCount);
+    if (refSize > 4 || (refSize < sizeof(uint64_t) && (cellCount >> (8 * refSize)) != 0)) {
+        throw std::invalid_argument("too many cells for the reference size");
+    }
+
+    // Cell sizes, absent cells and cells referenced more than once
+    size_t cellsSize = 0;
+    size_t absentCount = 0;
+    std::vector<uint8_t> parentCounts(options.hasCacheBits ? cellCount : 0, 0);
+    for (const auto cell : postOrder) {
+        if (arena.isAbsent(cell)) {
+            cellsSize += 2 + STORED_HASH_SIZE;
+            ++absentCount;
+            continue;
+        }
+        const auto references = arena.references(cell);
+        cellsSize += 2 + arena.data(cell).size() + references.size() * refSize;
+        if (options.hasCacheBits) {
+            for (const auto child : references) {
+                auto& parents = parentCounts[positions[child]];
+                parents = static_cast<uint8_t>(std::min(parents + 1, 2));
+            }
+        }
+    }
+
+    const auto maxOffset = options.hasCacheBits ? cellsSize * 2 + 1 : cellsSize;
+    const uint8_t offsetSize = options.offsetSize != 0 ? options.offsetSize : byteSize(maxOffset);
+    if (offsetSize > 8 || (offsetSize < sizeof(uint64_t) && (static_cast<uint64_t>(maxOffset) >> (8 * offsetSize)) != 0)) {
+        throw std::invalid_argument("cells too large for the offset size");
+    }
+
+    const auto begin = os.size();
+    os.reserve(begin + 4 + 2 + refSize * (3 + roots.size()) + offsetSize * (1 + (options.indexIncluded ? cellCount : 0)) + cellsSize + CRC_SIZE);
+
+    // Write header
+    encode32BE(BOC_MAGIC, os);
+    os.push_back(static_cast<uint8_t>((options.indexIncluded << 7) | (options.hasCrc << 6) | (options.hasCacheBits << 5) | refSize));
+    os.push_back(offsetSize);
+    encodeUint(cellCount, refSize, os);
+    encodeUint(roots.size(), refSize, os);
+    encodeUint(absentCount, refSize, os);
+    encodeUint(cellsSize, offsetSize, os);
+    for (const auto root : roots) {
+        encodeUint(positions[root], refSize, os);
+    }
+
+    // Write index: offset of the end of every cell, with the cache bit as least significant bit
+    if (options.indexIncluded) {
+        size_t end = 0;
+        for (size_t i = cellCount; i-- > 0;) {
+            const auto cell = postOrder[i];
+            end += arena.isAbsent(cell) ? 2 + STORED_HASH_SIZE : 2 + arena.data(cell).size() + arena.references(cell).size() * refSize;
+            const auto position = cellCount - 1 - i;
+            encodeUint(options.hasCacheBits ? end * 2 + (parentCounts[position] > 1) : end, offsetSize, os);
+        }
+    }
+
+    // Write cells
+    for (size_t i = cellCount; i-- > 0;) {
+        const auto cell = postOrder[i];
+        if (arena.isAbsent(cell)) {
+            os.push_back(ABSENT_CELL_D1);
+            os.push_back(0);
+            const auto& hash = arena.hash(cell);
+            os.insert(os.end(), hash.begin(), hash.end());
+            encode16BE(arena.depth(cell), os);
+            continue;
+        }
+
+        const auto references = arena.references(cell);
+        const auto data = arena.data(cell);
+        const auto [d1, d2] = Cell::getDescriptorBytes(static_cast<uint8_t>(references.size()), arena.bitLen(cell));
+        os.push_back(d1);
+        os.push_back(d2);
+        os.insert(os.end(), data.begin(), data.end());
+        for (const auto child : references) {
+            encodeUint(positions[child], refSize, os);
+        }
+    }
+
+    if (options.hasCrc) {
+        encode32LE(Crc::crc32c(os.data() + begin, os.size() - begin), os);
+    }
+}
+
+BocReader::BocReader(std::span<const uint8_t> boc, CellArena& arena)
+    : boc(boc), arena(arena) {
+    Reader reader(boc.data(), boc.size());
+
+    // Parse header
+    reader.require(6);
+    // 1. Magic
+    if (reader.readNextUint(sizeof(BOC_MAGIC)) != BOC_MAGIC) {
+        throw std::runtime_error("unknown magic");
+    }
+    // 2. Flags
+    struct Flags {
+        uint8_t refSize : 3;
+        uint8_t : 2; // unused
+        bool hasCacheBits : 1;
+        bool hasCrc : 1;
+        bool indexIncluded : 1;
+    };
+
+    static_assert(sizeof(Flags) == 1, "flags must be represented as 1 byte");
+    const auto flags = reinterpret_cast<const Flags*>(reader.data())[0];
+    refSize = flags.refSize;
+    offsetSize = reader.data()[1];
+    indexIncluded = flags.indexIncluded;
+    hasCacheBits = flags.hasCacheBits;
+    reader.advance(2);
+    if (refSize == 0 || refSize > 4) {
+        throw std::runtime_error("invalid ref size");
+    }
+    if (offsetSize == 0 || offsetSize > 8) {
+        throw std::runtime_error("invalid offset size");
+    }
+    if (hasCacheBits && !indexIncluded) {
+        throw std::runtime_error("cache bits without index");
+    }
+
+    // 3. CRC32C of everything before it, at the end
+    auto end = boc.size();
+    if (flags.hasCrc) {
+        if (end < CRC_SIZE) {
+            throw std::runtime_error("unexpected eof");
+        }
+        end -= CRC_SIZE;
+        if (Crc::crc32c(boc.data(), end) != decode32LE(boc.data() + end)) {
+            throw std::runtime_error("crc32c mismatch");
+        }
+    }
+    reader.bufferLen = end;
+
+    // 4. Counters and root indices
+    reader.require(refSize * 3 + offsetSize);
+    count = reader.readNextUint(refSize);
+    const auto rootCount = reader.readNextUint(refSize);
+    if (rootCount == 0) {
+        throw std::runtime_error("unsupported root count");
+    }
+    if (rootCount > count) {
+        throw std::runtime_error("root count is greater than cell count");
+    }
+    absentCount = reader.readNextUint(refSize);
+    if (absentCount > count) {
+        throw std::runtime_error("absent count is greater than cell count");
+    }
+
+    reader.readNextUint(offsetSize); // total cell size
+
+    reader.require(refSize * rootCount);
+    roots.reserve(rootCount);
+    for (size_t i = 0; i < rootCount; ++i) {
+        const auto rootIndex = reader.readNextUint(refSize);
+        if (rootIndex >= count) {
+            throw std::runtime_error("root cell not found");
+        }
+        roots.push_back(rootIndex);
+    }
+
+    // 5. Cell offsets
+    if (indexIncluded) {
+        reader.require(count * offsetSize);
+        indexBegin = reader.offset;
+        reader.advance(count * offsetSize);
+    }
+
+    // Every cell takes at least 2 bytes, do not trust the cell count before checking it against the input size
+    reader.require(count * 2);
+    cellsBegin = reader.offset;
+    cellsEnd = end;
+    loaded.assign(count, NOT_LOADED);
+
+    if (!indexIncluded) {
+        offsets.reserve(count);
+        size_t offset = cellsBegin;
+        for (size_t i = 0; i < count; ++i) {
+            offsets.push_back(offset - cellsBegin);
+            offset = parseCell(i, offset).end;
+        }
+    }
+}
+
+bool BocReader::shouldCache(size_t index) const {
+    if (index >= count) {
+        throw std::out_of_range("cell not found");
+    }
+    return hasCacheBits && (indexEntry(index) & 1) != 0;
+}
+
+uint64_t BocReader::indexEntry(size_t index) const {
+    Reader reader(boc.data(), cellsBegin, indexBegin + index * offsetSize);
+    return reader.readNextUint(offsetSize);
+}
+
+size_t BocReader::cellOffset(size_t index) const {
+    if (!indexIncluded) {
+        return cellsBegin + offsets[index];
+    }
+    if (index == 0) {
+        return cellsBegin;
+    }
+    const auto offset = indexEntry(index - 1) >> (hasCacheBits ? 1 : 0);
+    if (offset > cellsEnd - cellsBegin) {
+        throw std::runtime_error("invalid cell offset");
+    }
+    return cellsBegin + offset;
+}
+
+BocReader::RawCell BocReader::parseCell(size_t index, size_t offset) const {
+    struct Descriptor {
+        uint8_t refCount : 3;
+        bool exotic : 1;
+        bool storeHashes : 1;
+        uint8_t level : 3;
+    };
+
+    static_assert(sizeof(Descriptor) == 1, "cell descriptor must be represented as 1 byte");
+
+    Reader reader(boc.data(), cellsEnd, offset);
+    reader.require(2);
+    const auto d1 = reinterpret_cast<const Descriptor*>(reader.data())[0];
+    if (d1.level != 0) {
+        throw std::runtime_error("non-zero level is not supported");
+    }
+    if (d1.exotic) {
+        throw std::runtime_error("exotic cells are not supported");
+    }
+    const bool absent = d1.refCount == 7 && d1.storeHashes;
+    if (d1.refCount > 4 && !absent) {
+        throw std::runtime_error("invalid ref count");
+    }
+    const auto d2 = reader.data()[1];
+    const auto byteLen = static_cast<size_t>((d2 >> 1) + (d2 & 0b1));
+    reader.advance(2);
+
+    RawCell raw{
+        .absent = absent,
+        .bitLen = 0,
+        .data = {},
+        .refCount = 0,
+        .references = {},
+        .storedHash = nullptr,
+        .storedDepth = 0,
+        .end = 0,
+    };
+
+    // Stored hash and depth, only used for absent cells
+    if (d1.storeHashes) {
+        reader.require(STORED_HASH_SIZE);
+        raw.storedHash = reader.data();
+        reader.advance(Hash::sha256Size);
+        raw.storedDepth = static_cast<uint16_t>(reader.readNextUint(sizeof(uint16_t)));
+    }
+
+    reader.require(byteLen);
+    if (!absent) {
+        raw.data = std::span(reader.data(), byteLen);
+        raw.bitLen = computeBitLen(reader.data(), byteLen, (d2 & 0b1) == 0);
+        raw.refCount = d1.refCount;
+    }
+    reader.advance(byteLen);
+
+    reader.require(refSize * raw.refCount);
+    for (size_t r = 0; r < raw.refCount; ++r) {
+        const auto child = reader.readNextUint(refSize);
+        if (child > count || child <= index) {
+            throw std::runtime_error("invalid child index");
+        }
+        if (child == count) {
+            throw std::runtime_error("child cell not found");
+        }
+        raw.references[r] = child;
+    }
+
+    raw.end = reader.offset;
+    return raw;
+}
+
+CellArena::Index BocReader::load(size_t index) {
+    if (index >= count) {
+        throw std::out_of_range("cell not found");
+    }
+
+    // Children always follow their parents in a BOC, so this terminates;
+    // a cell is loaded once all its children are
+    std::vector<size_t> stack{index};
+    while (!stack.empty()) {
+        const auto current = stack.back();
+        if (loaded[current] != NOT_LOADED) {
+            stack.pop_back();
+            continue;
+        }
+
+        const auto offset = cellOffset(current);
+        const auto raw = parseCell(current, offset);
+        if (indexIncluded && raw.end - cellsBegin != indexEntry(current) >> (hasCacheBits ? 1 : 0)) {
+            throw std::runtime_error("invalid cell offset");
+        }
+
+        bool ready = true;
+        for (size_t r = 0; r < raw.refCount; ++r) {
+            if (loaded[raw.references[r]] == NOT_LOADED) {
+                stack.push_back(raw.references[r]);
+                ready = false;
+            }
+        }
+        if (!ready) {
+            continue;
+        }
+
+        if (raw.absent) {
+            if (++absentLoaded > absentCount) {
+                throw std::runtime_error("unexpected absent cell");
+            }
+            Cell::CellHash hash{};
+            std::copy(raw.storedHash, raw.storedHash + hash.size(), hash.begin());
+            loaded[current] = arena.addAbsent(hash, raw.storedDepth);
+        } else {
+            std::array<CellArena::Index, Cell::MAX_REFS> references{};
+            for (size_t r = 0; r < raw.refCount; ++r) {
+                references[r] = loaded[raw.references[r]];
+            }
+            loaded[current] = arena.add(raw.data, raw.bitLen, std::span(references).first(raw.refCount));
+        }
+        stack.pop_back();
+    }
+
+    return loaded[index];
+}
+
+} // namespace TW::CommonTON
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "CellArena.h"
+#include "Data.h"
+
+namespace TW::CommonTON {
+
+// Bag of cells (BOC) serialization options, see `serialized_boc` in the TON TL-B scheme
+struct BocOptions {
+    // Write the offset index, for random access to the cells
+    bool indexIncluded = false;
+    // Append a CRC32C checksum
+    bool hasCrc = false;
+    // Mark the cells referenced more than once in the index, requires `indexIncluded`
+    bool hasCacheBits = false;
+    // Size of cell references and of offsets in bytes, 0 for the smallest size that fits
+    uint8_t refSize = 0;
+    uint8_t offsetSize = 0;
+};
+
+// Serializes the cells reachable from `roots` as a bag of cells.
+// Every cell is written once, parents before their children; `roots` must be distinct.
+void serializeBoc(const CellArena& arena, std::span<const CellArena::Index> roots, Data& os, const BocOptions& options = {});
+
+// Reader of a serialized bag of cells.
+//
+// Only the header is parsed up front: a cell is decoded into the arena when it, or one of its ancestors, is loaded.
+// Cells are located in O(1) through the offset index when the BOC includes one,
+// otherwise by a single scan of the cell descriptors.
+// The serialized BOC must outlive the reader.
+class BocReader {
+public:
+    // Parses the header, and verifies the CRC32C checksum if there is one
+    BocReader(std::span<const uint8_t> boc, CellArena& arena);
+
+    [[nodiscard]] size_t cellCount() const noexcept { return count; }
+    [[nodiscard]] size_t rootCount() const noexcept { return roots.size(); }
+    [[nodiscard]] bool hasIndex() const noexcept { return indexIncluded; }
+
+    // BOC index of root `i`
+    [[nodiscard]] size_t rootIndex(size_t i) const { return roots.at(i); }
+
+    // Whether cell `index` is marked in the index as referenced more than once
+    [[nodiscard]] bool shouldCache(size_t index) const;
+
+    // Loads cell `index` and its descendants into the arena, returns its arena index.
+    // Cells already loaded by this reader are not decoded again.
+    CellArena::Index load(size_t index);
+
+    CellArena::Index loadRoot(size_t i) { return load(rootIndex(i)); }
+
+private:
+    struct RawCell {
+        bool absent;
+        uint16_t bitLen;
+        std::span<const uint8_t> data;
+        uint8_t refCount;
+        std::array<size_t, Cell::MAX_REFS> references;
+        const uint8_t* _Nullable storedHash;
+        uint16_t storedDepth;
+        size_t end;
+    };
+
+    RawCell parseCell(size_t index, size_t offset) const;
+    size_t cellOffset(size_t index) const;
+    uint64_t indexEntry(size_t index) const;
+
+    std::span<const uint8_t> boc;
+    CellArena& arena;
+
+    uint8_t refSize = 0;
+    uint8_t offsetSize = 0;
+    bool indexIncluded = false;
+    bool hasCacheBits = false;
+    size_t count = 0;
+    size_t absentCount = 0;
+    size_t absentLoaded = 0;
+    std::vector<size_t> roots{};
+
+    // Cells are within [cellsBegin, cellsEnd) of the BOC
+    size_t indexBegin = 0;
+    size_t cellsBegin = 0;
+    size_t cellsEnd = 0;
+
+    // Cell offsets, relative to `cellsBegin`, when the BOC has no index
+    std::vector<size_t> offsets{};
+    std::vector<CellArena::Index> loaded{};
+};
+
+} // namespace TW::CommonTON
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "Data.h"
@@ -14,10 +15,14 @@
 
 namespace TW::CommonTON {
 
+constexpr uint32_t BOC_MAGIC = 0xb5ee9c72;
+
 class Cell {
 public:
     constexpr static uint16_t MAX_BITS = 1023;
     constexpr static uint8_t MAX_REFS = 4;
+    // Maximum depth of a cell tree, as enforced by the TVM
+    constexpr static uint16_t MAX_DEPTH = 1024;
 
     using Ref = std::shared_ptr<Cell>;
     using Refs = std::array<Ref, MAX_REFS>;
@@ -40,21 +45,30 @@ public:
     // Deserialize from Base64
     static std::shared_ptr<Cell> fromBase64(const std::string& encoded);
 
-    // Deserialize from BOC representation
+    // Deserialize from BOC representation with a single root
     static std::shared_ptr<Cell> deserialize(const uint8_t* _Nonnull data, size_t len);
 
-    // Serialize to binary stream
+    // Serialize to binary stream, as a BOC with this cell as its only root
     void serialize(Data& os) const;
 
-    // Compute cell depth and hash
+    // Compute cell depth and hash, of this cell and of all its not yet finalized descendants
     void finalize();
 
-    [[nodiscard]] inline std::pair<uint8_t, uint8_t> getDescriptorBytes() const noexcept {
+    // Compute the representation hash of a cell from its data and its children depths and hashes,
+    // writing it into `out` without building the representation
+    static void computeHash(uint16_t bitLen, std::span<const uint8_t> data, std::span<const uint16_t> childDepths,
+                            std::span<const CellHash* const> childHashes, CellHash& out);
+
+    [[nodiscard]] inline static std::pair<uint8_t, uint8_t> getDescriptorBytes(uint8_t refCount, uint16_t bitLen) noexcept {
         const uint8_t d1 = refCount;
         const uint8_t d2 = (static_cast<uint8_t>(bitLen >> 2) & 0b11111110) | (bitLen % 8 != 0);
         return std::pair<uint8_t, uint8_t>{d1, d2};
     }
 
+    [[nodiscard]] inline std::pair<uint8_t, uint8_t> getDescriptorBytes() const noexcept {
+        return getDescriptorBytes(refCount, bitLen);
+    }
+
     [[nodiscard]] inline size_t serializedSize(uint8_t refSize) const noexcept {
         return 2 + (bitLen + 7) / 8 + refCount * refSize;
     }
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "CellArena.h"
+#include "BagOfCells.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+using namespace TW;
+
+namespace TW::CommonTON {
+
+void CellArena::reserve(size_t cellCount, size_t dataSize) {
+    nodes.reserve(cellCount);
+    bytes.reserve(dataSize);
+    indices.reserve(cellCount);
+}
+
+CellArena::Index CellArena::add(std::span<const uint8_t> data, uint16_t bitLen, std::span<const Index> references) {
+    return insert(data, bitLen, references, nullptr);
+}
+
+CellArena::Index CellArena::insert(std::span<const uint8_t> data, uint16_t bitLen, std::span<const Index> references, const Cell::CellHash* _Nullable hash) {
+    if (bitLen > Cell::MAX_BITS || references.size() > Cell::MAX_REFS || data.size() < static_cast<size_t>((bitLen + 7) / 8)) {
+        throw std::invalid_argument("invalid cell");
+    }
+    data = data.first((bitLen + 7) / 8);
+
+    Node node{
+        .dataOffset = bytes.size(),
+        .bitLen = bitLen,
+        .refCount = static_cast<uint8_t>(references.size()),
+        .absent = false,
+        .depth = 0,
+        .references = {},
+        .hash = {},
+    };
+
+    std::array<uint16_t, Cell::MAX_REFS> childDepths{};
+    std::array<const Cell::CellHash*, Cell::MAX_REFS> childHashes{};
+    for (size_t r = 0; r < references.size(); ++r) {
+        if (references[r] >= nodes.size()) {
+            throw std::invalid_argument("child cell not found");
+        }
+        const auto& child = nodes[references[r]];
+        node.references[r] = references[r];
+        childDepths[r] = child.depth;
+        childHashes[r] = &child.hash;
+        node.depth = std::max(node.depth, static_cast<uint16_t>(child.depth + 1));
+    }
+    if (node.depth > Cell::MAX_DEPTH) {
+        throw std::runtime_error("cell depth limit exceeded");
+    }
+
+    if (hash != nullptr) {
+        node.hash = *hash;
+    } else {
+        Cell::computeHash(bitLen, data,
+                          std::span(childDepths).first(references.size()),
+                          std::span(childHashes).first(references.size()),
+                          node.hash);
+    }
+
+    const auto index = static_cast<Index>(nodes.size());
+    const auto [existing, inserted] = indices.emplace(node.hash, index);
+    if (!inserted) {
+        return existing->second;
+    }
+
+    // `data` may be the data of a cell of this arena, which the resize can reallocate
+    const auto aliased = std::less_equal<>()(bytes.data(), data.data()) && std::less<>()(data.data(), bytes.data() + bytes.size());
+    const auto sourceOffset = aliased ? static_cast<size_t>(data.data() - bytes.data()) : 0;
+    bytes.resize(node.dataOffset + data.size());
+    std::copy_n(aliased ? bytes.data() + sourceOffset : data.data(), data.size(), bytes.data() + node.dataOffset);
+    nodes.push_back(node);
+    return index;
+}
+
+CellArena::Index CellArena::add(const Cell& root) {
+    // Post-order traversal with an explicit stack; shared subtrees are added once
+    struct Frame {
+        const Cell* _Nonnull cell;
+        uint8_t next;
+        std::array<Index, Cell::MAX_REFS> references;
+    };
+
+    std::unordered_map<const Cell*, Index> added{};
+    std::vector<Frame> stack{};
+    stack.push_back(Frame{.cell = &root, .next = 0, .references = {}});
+
+    Index result = 0;
+    while (!stack.empty()) {
+        auto& frame = stack.back();
+        if (frame.next < frame.cell->refCount) {
+            const auto* child = frame.cell->references[frame.next].get();
+            if (child == nullptr) {
+                throw std::invalid_argument("invalid cell");
+            }
+            const auto it = added.find(child);
+            if (it != added.end()) {
+                frame.references[frame.next++] = it->second;
+                continue;
+            }
+            if (stack.size() > Cell::MAX_DEPTH) {
+                throw std::runtime_error("cell depth limit exceeded");
+            }
+            stack.push_back(Frame{.cell = child, .next = 0, .references = {}});
+            continue;
+        }
+
+        const auto& cell = *frame.cell;
+        result = insert(cell.data, cell.bitLen, std::span(frame.references).first(cell.refCount), cell.finalized ? &cell.hash : nullptr);
+        added.emplace(&cell, result);
+        stack.pop_back();
+        if (!stack.empty()) {
+            auto& parent = stack.back();
+            parent.references[parent.next++] = result;
+        }
+    }
+    return result;
+}
+
+CellArena::Index CellArena::addAbsent(const Cell::CellHash& hash, uint16_t depth) {
+    if (depth > Cell::MAX_DEPTH) {
+        throw std::runtime_error("cell depth limit exceeded");
+    }
+
+    // Absent cells are not shared with the cells of the same hash, which have data
+    const auto index = static_cast<Index>(nodes.size());
+    nodes.push_back(Node{
+        .dataOffset = bytes.size(),
+        .bitLen = 0,
+        .refCount = 0,
+        .absent = true,
+        .depth = depth,
+        .references = {},
+        .hash = hash,
+    });
+    return index;
+}
+
+std::vector<CellArena::Index> CellArena::deserialize(const uint8_t* _Nonnull data, size_t len) {
+    BocReader reader(std::span(data, len), *this);
+    reserve(nodes.size() + reader.cellCount(), bytes.size() + len);
+
+    std::vector<Index> roots{};
+    roots.reserve(reader.rootCount());
+    for (size_t i = 0; i < reader.rootCount(); ++i) {
+        roots.push_back(reader.loadRoot(i));
+    }
+    return roots;
+}
+
+Cell::Ref CellArena::toCell(Index index) const {
+    if (index >= nodes.size()) {
+        throw std::invalid_argument("cell not found");
+    }
+
+    // Children always have lower indices than their parents:
+    // mark the cells reachable from the root top-down, then create them bottom-up
+    std::vector<Cell::Ref> cells(index + 1);
+    std::vector<bool> reachable(index + 1, false);
+    reachable[index] = true;
+    for (size_t i = index + 1; i-- > 0;) {
+        if (!reachable[i]) {
+            continue;
+        }
+        const auto& node = nodes[i];
+        for (size_t r = 0; r < node.refCount; ++r) {
+            reachable[node.references[r]] = true;
+        }
+    }
+
+    for (size_t i = 0; i <= index; ++i) {
+        if (!reachable[i]) {
+            continue;
+        }
+        const auto& node = nodes[i];
+        if (node.absent) {
+            throw std::runtime_error("absent cells are not supported");
+        }
+
+        Cell::Refs references{};
+        for (size_t r = 0; r < node.refCount; ++r) {
+            references[r] = cells[node.references[r]];
+        }
+
+        const auto cellData = data(static_cast<Index>(i));
+        auto cell = std::make_shared<Cell>(node.bitLen, Data(cellData.begin(), cellData.end()), node.refCount, std::move(references));
+        cell->depth = node.depth;
+        cell->hash = node.hash;
+        cell->finalized = true;
+        cells[i] = std::move(cell);
+    }
+
+    return std::move(cells[index]);
+}
+
+std::span<const uint8_t> CellArena::data(Index index) const {
+    const auto& node = nodes.at(index);
+    return std::span(bytes).subspan(node.dataOffset, (node.bitLen + 7) / 8);
+}
+
+std::span<const CellArena::Index> CellArena::references(Index index) const {
+    const auto& node = nodes.at(index);
+    return std::span(node.references).first(node.refCount);
+}
+
+} // namespace TW::CommonTON
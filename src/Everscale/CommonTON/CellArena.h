@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Cell.h"
+#include "Data.h"
+
+namespace TW::CommonTON {
+
+// Store of the cells of a bag of cells.
+//
+// Cells are referenced by stable indices, and the data of all cells lives in a single buffer.
+// A cell can only be added once its children are in the arena, so every cell is hashed exactly once,
+// children before parents, and identical cells (same representation hash) are stored once.
+// Nothing is recursive: deep trees cannot overflow the call stack.
+class CellArena {
+public:
+    using Index = uint32_t;
+
+    CellArena() = default;
+
+    void reserve(size_t cellCount, size_t dataSize);
+
+    // Adds a cell whose children are already in the arena, returns its index.
+    // If an identical cell is already in the arena, returns the index of that cell instead.
+    Index add(std::span<const uint8_t> data, uint16_t bitLen, std::span<const Index> references);
+
+    // Adds a tree of cells, which does not need to be finalized, returns the index of its root.
+    // Hashes of finalized cells are reused.
+    Index add(const Cell& root);
+
+    // Adds an absent cell: a cell outside of the bag of cells, known only by its hash and depth
+    Index addAbsent(const Cell::CellHash& hash, uint16_t depth);
+
+    // Deserializes a BOC representation into the arena, returns the indices of its roots
+    std::vector<Index> deserialize(const uint8_t* _Nonnull data, size_t len);
+
+    // Materializes a cell and its descendants as a finalized tree of `Cell`, none of them may be absent
+    [[nodiscard]] Cell::Ref toCell(Index index) const;
+
+    [[nodiscard]] size_t size() const noexcept { return nodes.size(); }
+
+    [[nodiscard]] const Cell::CellHash& hash(Index index) const { return nodes.at(index).hash; }
+    [[nodiscard]] uint16_t depth(Index index) const { return nodes.at(index).depth; }
+    [[nodiscard]] uint16_t bitLen(Index index) const { return nodes.at(index).bitLen; }
+    [[nodiscard]] bool isAbsent(Index index) const { return nodes.at(index).absent; }
+    [[nodiscard]] std::span<const uint8_t> data(Index index) const;
+    [[nodiscard]] std::span<const Index> references(Index index) const;
+
+private:
+    struct Node {
+        size_t dataOffset;
+        uint16_t bitLen;
+        uint8_t refCount;
+        bool absent;
+        uint16_t depth;
+        std::array<Index, Cell::MAX_REFS> references;
+        Cell::CellHash hash;
+    };
+
+    struct CellHashHasher {
+        size_t operator()(const Cell::CellHash& hash) const noexcept {
+            // Representation hashes are uniformly distributed already
+            size_t result;
+            std::memcpy(&result, hash.data(), sizeof(result));
+            return result;
+        }
+    };
+
+    Index insert(std::span<const uint8_t> data, uint16_t bitLen, std::span<const Index> references, const Cell::CellHash* _Nullable hash);
+
+    std::vector<Node> nodes{};
+    Data bytes{};
+    std::unordered_map<Cell::CellHash, Index, CellHashHasher> indices{};
+};
+
+} // namespace TW::CommonTON
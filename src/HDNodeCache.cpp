@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "HDNodeCache.h"
+
+#include "memory/memzero_wrapper.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace TW {
+
+HDNodeCache& HDNodeCache::operator=(const HDNodeCache& other) {
+    if (this != &other) {
+        clear();
+        std::lock_guard lock(mutex);
+        capacity = other.capacity;
+    }
+    return *this;
+}
+
+std::size_t HDNodeCache::findLongestPrefix(TWCurve curve, const std::vector<uint32_t>& indices, std::size_t maxLength, HDNode& node) {
+    std::lock_guard lock(mutex);
+    if (index.empty()) {
+        return 0;
+    }
+    Key key{curve, std::vector<uint32_t>(indices.begin(), indices.begin() + std::min(maxLength, indices.size()))};
+    while (!key.second.empty()) {
+        auto found = index.find(key);
+        if (found != index.end()) {
+            entries.splice(entries.begin(), entries, found->second);
+            node = found->second->node;
+            return key.second.size();
+        }
+        key.second.pop_back();
+    }
+    return 0;
+}
+
+void HDNodeCache::insert(TWCurve curve, const std::vector<uint32_t>& indices, std::size_t length, const HDNode& node) {
+    if (capacity == 0 || length == 0 || length > indices.size()) {
+        return;
+    }
+    Key key{curve, std::vector<uint32_t>(indices.begin(), indices.begin() + length)};
+
+    std::lock_guard lock(mutex);
+    auto found = index.find(key);
+    if (found != index.end()) {
+        // derived concurrently by another thread, result is the same
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+    while (entries.size() >= capacity) {
+        erase(std::prev(entries.end()));
+    }
+    entries.push_front(Entry{key, node});
+    index.emplace(std::move(key), entries.begin());
+}
+
+bool HDNodeCache::findRoot(TWCurve curve, HDNode& node) const {
+    std::lock_guard lock(mutex);
+    auto found = roots.find(curve);
+    if (found == roots.end()) {
+        return false;
+    }
+    node = found->second;
+    return true;
+}
+
+void HDNodeCache::insertRoot(TWCurve curve, const HDNode& node) {
+    std::lock_guard lock(mutex);
+    roots.emplace(curve, node);
+}
+
+void HDNodeCache::clear() {
+    std::lock_guard lock(mutex);
+    while (!entries.empty()) {
+        erase(entries.begin());
+    }
+    for (auto& root : roots) {
+        memzero(&root.second);
+    }
+    roots.clear();
+}
+
+std::size_t HDNodeCache::size() const {
+    std::lock_guard lock(mutex);
+    return entries.size();
+}
+
+void HDNodeCache::erase(Entries::iterator it) {
+    memzero(&it->node);
+    index.erase(it->key);
+    entries.erase(it);
+}
+
+} // namespace TW
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include <TrustWalletCore/TWCurve.h>
+#include <TrezorCrypto/bip32.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace TW {
+
+/// Thread-safe, bounded LRU cache of intermediate HD derivation nodes, keyed by curve and derivation path prefix.
+/// Used by HDWallet so that deriving many keys under one account repeats only the last derivation steps.
+/// Cached nodes hold private key material, they are zeroized on eviction, on `clear()` and on destruction.
+class HDNodeCache {
+public:
+    static constexpr std::size_t defaultCapacity = 64;
+
+    explicit HDNodeCache(std::size_t capacity = defaultCapacity) : capacity(capacity) {}
+
+    /// Copies start out empty, cached secrets are not duplicated.
+    HDNodeCache(const HDNodeCache& other) : capacity(other.capacity) {}
+    HDNodeCache& operator=(const HDNodeCache& other);
+
+    ~HDNodeCache() { clear(); }
+
+    /// Finds the longest cached prefix of `indices`, not longer than `maxLength`, and copies its node into `node`.
+    /// Returns the length of the prefix found, 0 if none.
+    std::size_t findLongestPrefix(TWCurve curve, const std::vector<uint32_t>& indices, std::size_t maxLength, HDNode& node);
+
+    /// Stores the node derived with the first `length` elements of `indices`.
+    void insert(TWCurve curve, const std::vector<uint32_t>& indices, std::size_t length, const HDNode& node);
+
+    /// Finds the master node of the curve, returns false if not cached.
+    bool findRoot(TWCurve curve, HDNode& node) const;
+
+    /// Stores the master node of the curve. Master nodes are kept until `clear()` and do not count against
+    /// the capacity, as they can be expensive to compute (e.g. Cardano Icarus PBKDF2).
+    void insertRoot(TWCurve curve, const HDNode& node);
+
+    /// Removes and zeroizes all cached nodes, including master nodes.
+    void clear();
+
+    /// Number of cached intermediate nodes, not counting master nodes.
+    std::size_t size() const;
+
+    /// Maximum number of cached nodes.
+    std::size_t maxSize() const { return capacity; }
+
+private:
+    using Key = std::pair<TWCurve, std::vector<uint32_t>>;
+
+    struct Entry {
+        Key key;
+        HDNode node;
+    };
+
+    using Entries = std::list<Entry>;
+
+    /// Zeroizes and removes the entry; the lock must be held.
+    void erase(Entries::iterator it);
+
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    /// Most recently used first
+    Entries entries;
+    std::map<Key, Entries::iterator> index;
+    std::map<TWCurve, HDNode> roots;
+};
+
+} // namespace TW
@@ -9,8 +9,10 @@
 #include "Bitcoin/CashAddress.h"
 #include "Bitcoin/SegwitAddress.h"
 #include "Coin.h"
+#include "Ethereum/Address.h"
 #include "ImmutableX/StarkKey.h"
 #include "Mnemonic.h"
+#include "SeedCache.h"
 #include "memory/memzero_wrapper.h"
 
 #include <TrustWalletCore/TWHRP.h>
@@ -22,7 +24,9 @@
 #include <TrezorCrypto/bip39.h>
 #include <TrezorCrypto/cardano.h>
 #include <TrezorCrypto/curves.h>
+#include <TrezorCrypto/ecdsa.h>
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 
@@ -47,8 +51,11 @@ template <std::size_t seedSize>
 void HDWallet<seedSize>::updateSeedAndEntropy([[maybe_unused]] bool check) {
     assert(!check || Mnemonic::isValid(mnemonic)); // precondition
 
-    // generate seed from mnemonic
-    mnemonic_to_seed(mnemonic.c_str(), passphrase.c_str(), seed.data(), nullptr);
+    // generate seed from mnemonic, cached as the PBKDF2 is expensive
+    SeedCache::Seed fullSeed;
+    SeedCache::shared().mnemonicToSeed(mnemonic, passphrase, fullSeed);
+    std::copy_n(fullSeed.begin(), std::min(seedSize, fullSeed.size()), seed.begin());
+    memzero(&fullSeed);
 
     // generate entropy bits from mnemonic
     Data entropyRaw((Mnemonic::MaxWords * Mnemonic::BitsPerWord) / 8);
@@ -125,34 +132,59 @@ static HDNode getMasterNode(const HDWallet<seedSize>& wallet, TWCurve curve) {
     return node;
 }
 
-template <size_t seedSize>
-static HDNode getNode(const HDWallet<seedSize>& wallet, TWCurve curve, const DerivationPath& derivationPath) {
+template <std::size_t seedSize>
+HDNode HDWallet<seedSize>::getRootNode(TWCurve curve) const {
+    HDNode node;
+    if (!nodeCache.findRoot(curve, node)) {
+        node = getMasterNode<seedSize>(*this, curve);
+        nodeCache.insertRoot(curve, node);
+    }
+    return node;
+}
+
+template <std::size_t seedSize>
+HDNode HDWallet<seedSize>::getNode(TWCurve curve, const DerivationPath& derivationPath) const {
     const auto privateKeyType = PrivateKey::getType(curve);
-    auto node = getMasterNode<seedSize>(wallet, curve);
+    std::vector<uint32_t> indices;
+    indices.reserve(derivationPath.indices.size());
     for (auto& index : derivationPath.indices) {
+        indices.push_back(index.derivationIndex());
+    }
+
+    // Only intermediate nodes are cached, not the final (e.g. per-address) ones
+    const auto cacheableLength = indices.empty() ? 0 : indices.size() - 1;
+    HDNode node;
+    const auto start = nodeCache.findLongestPrefix(curve, indices, cacheableLength, node);
+    if (start == 0) {
+        node = getRootNode(curve);
+    }
+    for (auto i = start; i < indices.size(); ++i) {
         switch (privateKeyType) {
         case TWPrivateKeyTypeCardano:
-            hdnode_private_ckd_cardano(&node, index.derivationIndex());
+            hdnode_private_ckd_cardano(&node, indices[i]);
             break;
         case TWPrivateKeyTypeDefault:
         default:
-            hdnode_private_ckd(&node, index.derivationIndex());
+            hdnode_private_ckd(&node, indices[i]);
             break;
         }
+        if (i + 1 <= cacheableLength) {
+            nodeCache.insert(curve, indices, i + 1, node);
+        }
     }
     return node;
 }
 
 template <std::size_t seedSize>
 PrivateKey HDWallet<seedSize>::getMasterKey(TWCurve curve) const {
-    auto node = getMasterNode(*this, curve);
+    auto node = getRootNode(curve);
     auto data = Data(node.private_key, node.private_key + PrivateKey::_size);
     return PrivateKey(data, curve);
 }
 
 template <std::size_t seedSize>
 PrivateKey HDWallet<seedSize>::getMasterKeyExtension(TWCurve curve) const {
-    auto node = getMasterNode(*this, curve);
+    auto node = getRootNode(curve);
     auto data = Data(node.private_key_extension, node.private_key_extension + PrivateKey::_size);
     return PrivateKey(data, curve);
 }
@@ -168,7 +200,7 @@ DerivationPath HDWallet<seedSize>::cardanoStakingDerivationPath(const Derivation
 template <std::size_t seedSize>
 PrivateKey HDWallet<seedSize>::getKeyByCurve(TWCurve curve, const DerivationPath& derivationPath) const {
     const auto privateKeyType = PrivateKey::getType(curve);
-    auto node = getNode<seedSize>(*this, curve, derivationPath);
+    auto node = getNode(curve, derivationPath);
     switch (privateKeyType) {
     case TWPrivateKeyTypeCardano: {
         if (derivationPath.indices.size() < 4 || derivationPath.indices[3].value > 1) {
@@ -181,13 +213,14 @@ PrivateKey HDWallet<seedSize>::getKeyByCurve(TWCurve curve, const DerivationPath
         auto extData = Data(node.private_key_extension, node.private_key_extension + PrivateKey::_size);
         auto chainCode = Data(node.chain_code, node.chain_code + PrivateKey::_size);
 
-        // repeat with staking path
-        const auto node2 = getNode(*this, curve, stakingPath);
+        // repeat with staking path; it shares the account node (m/1852'/1815'/account') from the node cache
+        auto node2 = getNode(curve, stakingPath);
         auto pkData2 = Data(node2.private_key, node2.private_key + PrivateKey::_size);
         auto extData2 = Data(node2.private_key_extension, node2.private_key_extension + PrivateKey::_size);
         auto chainCode2 = Data(node2.chain_code, node2.chain_code + PrivateKey::_size);
 
         TW::memzero(&node);
+        TW::memzero(&node2);
         return PrivateKey(pkData, extData, chainCode, pkData2, extData2, chainCode2, curve);
     }
     case TWPrivateKeyTypeDefault:
@@ -217,7 +250,7 @@ PrivateKey HDWallet<seedSize>::getKey(TWCoinType coin, TWDerivation derivation)
 template <std::size_t seedSize>
 std::string HDWallet<seedSize>::getRootKey(TWCoinType coin, TWHDVersion version) const {
     const auto curve = TWCoinTypeCurve(coin);
-    auto node = getMasterNode(*this, curve);
+    auto node = getRootNode(curve);
     return serialize(&node, 0, version, false, base58Hasher(coin));
 }
 
@@ -227,6 +260,89 @@ std::string HDWallet<seedSize>::deriveAddress(TWCoinType coin, TWDerivation deri
     return TW::deriveAddress(coin, getKey(coin, derivationPath), derivation);
 }
 
+template <std::size_t seedSize>
+std::vector<std::string> HDWallet<seedSize>::deriveAddresses(TWCoinType coin, uint32_t account, uint32_t change, uint32_t start, uint32_t count) const {
+    if (change > 1) {
+        throw std::invalid_argument("Invalid change, must be 0 (external) or 1 (internal)");
+    }
+    if (count > 0 && uint64_t(start) + count > 0x80000000) {
+        throw std::invalid_argument("Invalid address index range");
+    }
+    const auto curve = TWCoinTypeCurve(coin);
+    const auto purpose = TW::purpose(coin);
+    const auto coinId = TW::slip44Id(coin);
+    std::vector<std::string> addresses;
+    addresses.reserve(count);
+
+    if (curve != TWCurveSECP256k1 && curve != TWCurveNIST256p1) {
+        // no public derivation on this curve, derive every private key (account node comes from the cache);
+        // SLIP-0010 ed25519 and curve25519 only have hardened derivation, so change and index are hardened
+        const auto hardened = curve == TWCurveED25519 || curve == TWCurveED25519Blake2bNano || curve == TWCurveCurve25519;
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto path = DerivationPath({
+                DerivationPathIndex(purpose, true),
+                DerivationPathIndex(coinId, true),
+                DerivationPathIndex(account, true),
+                DerivationPathIndex(change, hardened),
+                DerivationPathIndex(start + i, hardened),
+            });
+            addresses.push_back(TW::deriveAddress(coin, getKey(coin, path)));
+        }
+        return addresses;
+    }
+
+    const auto changePath = DerivationPath({
+        DerivationPathIndex(purpose, true),
+        DerivationPathIndex(coinId, true),
+        DerivationPathIndex(account, true),
+        DerivationPathIndex(change, false),
+    });
+    auto node = getNode(curve, changePath);
+    hdnode_fill_public_key(&node);
+    const ecdsa_curve* params = node.curve->params;
+    curve_point parent;
+    uint8_t chainCode[32];
+    std::copy(std::begin(node.chain_code), std::end(node.chain_code), chainCode);
+    const auto valid = ecdsa_read_pubkey(params, node.public_key, &parent) != 0;
+    TW::memzero(&node);
+    if (!valid) {
+        throw std::invalid_argument("Invalid public key");
+    }
+
+    const auto keyType = TW::publicKeyType(coin);
+    const auto extended = keyType == TWPublicKeyTypeSECP256k1Extended || keyType == TWPublicKeyTypeNIST256p1Extended;
+    std::vector<PublicKey> publicKeys;
+    publicKeys.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        curve_point child;
+        hdnode_public_ckd_cp(params, &parent, chainCode, start + i, &child, nullptr);
+        Data publicKey;
+        if (extended) {
+            publicKey.resize(PublicKey::secp256k1ExtendedSize);
+            publicKey[0] = 0x04;
+            bn_write_be(&child.x, publicKey.data() + 1);
+            bn_write_be(&child.y, publicKey.data() + 33);
+        } else {
+            publicKey.resize(PublicKey::secp256k1Size);
+            compress_coords(&child, publicKey.data());
+        }
+        publicKeys.emplace_back(publicKey, keyType);
+    }
+    TW::memzero(chainCode, sizeof(chainCode));
+
+    if (TW::blockchain(coin) == TWBlockchainEthereum && keyType == TWPublicKeyTypeSECP256k1Extended) {
+        // EVM coins: the address is the tail of the key's Keccak256, hash all keys in one batch
+        for (const auto& keyHash : PublicKey::hashes(publicKeys, {}, Hash::HasherKeccak256, true)) {
+            addresses.push_back(Ethereum::Address(Data(keyHash.end() - Ethereum::Address::size, keyHash.end())).string());
+        }
+        return addresses;
+    }
+    for (const auto& publicKey : publicKeys) {
+        addresses.push_back(TW::deriveAddress(coin, publicKey));
+    }
+    return addresses;
+}
+
 template <std::size_t seedSize>
 std::string HDWallet<seedSize>::deriveAddress(TWCoinType coin) const {
     return deriveAddress(coin, TWDerivationDefault);
@@ -241,7 +357,7 @@ std::string HDWallet<seedSize>::getExtendedPrivateKeyAccount(TWPurpose purpose,
     const auto curve = TWCoinTypeCurve(coin);
     const auto path = TW::derivationPath(coin, derivation);
     auto derivationPath = DerivationPath({DerivationPathIndex(purpose, true), DerivationPathIndex(path.coin(), true)});
-    auto node = getNode(*this, curve, derivationPath);
+    auto node = getNode(curve, derivationPath);
     auto fingerprintValue = fingerprint(&node, publicKeyHasher(coin));
     hdnode_private_ckd(&node, account + 0x80000000);
     return serialize(&node, fingerprintValue, version, false, base58Hasher(coin));
@@ -256,7 +372,7 @@ std::string HDWallet<seedSize>::getExtendedPublicKeyAccount(TWPurpose purpose, T
     const auto curve = TWCoinTypeCurve(coin);
     const auto path = TW::derivationPath(coin, derivation);
     auto derivationPath = DerivationPath({DerivationPathIndex(purpose, true), DerivationPathIndex(path.coin(), true)});
-    auto node = getNode(*this, curve, derivationPath);
+    auto node = getNode(curve, derivationPath);
     auto fingerprintValue = fingerprint(&node, publicKeyHasher(coin));
     hdnode_private_ckd(&node, account + 0x80000000);
     hdnode_fill_public_key(&node);
@@ -6,6 +6,7 @@
 
 #include "Data.h"
 #include "DerivationPath.h"
+#include "HDNodeCache.h"
 #include "Hash.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
@@ -19,6 +20,7 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace TW {
 
@@ -42,6 +44,9 @@ class HDWallet {
     /// Entropy is the binary 1-to-1 representation of the mnemonic (11 bits from each word)
     TW::Data entropy;
 
+    /// Intermediate derivation nodes (e.g. account level), reused by subsequent derivations
+    mutable HDNodeCache nodeCache;
+
 public:
     const std::array<byte, seedSize>& getSeed() const { return seed; }
     const std::string& getMnemonic() const { return mnemonic; }
@@ -92,6 +97,14 @@ public:
     /// Derives the address for a coin with given derivation.
     std::string deriveAddress(TWCoinType coin, TWDerivation derivation) const;
 
+    /// Derives the addresses for indices [start, start+count) at "m/purpose'/coin'/account'/change/index".
+    /// On curves with public derivation (secp256k1, nist256p1), the change-level key is derived once, and then
+    /// only public child derivation is done for each address.
+    /// On curves with hardened derivation only (ed25519, curve25519), the path is "m/purpose'/coin'/account'/change'/index'".
+    /// Throws on a change other than 0 (external chain) or 1 (internal chain), and on an index range reaching the
+    /// hardened indices.
+    std::vector<std::string> deriveAddresses(TWCoinType coin, uint32_t account, uint32_t change, uint32_t start, uint32_t count) const;
+
     /// Returns the extended private key for default 0 account with the given derivation.
     std::string getExtendedPrivateKeyDerivation(TWPurpose purpose, TWCoinType coin, TWDerivation derivation, TWHDVersion version) const {
         return getExtendedPrivateKeyAccount(purpose, coin, derivation, version, 0);
@@ -137,6 +150,12 @@ public:
   private:
     void updateSeedAndEntropy(bool check = true);
 
+    /// Returns the master node of the curve, computed only once per wallet.
+    HDNode getRootNode(TWCurve curve) const;
+
+    /// Derives the node at the given path, starting from the longest cached intermediate node.
+    HDNode getNode(TWCurve curve, const DerivationPath& derivationPath) const;
+
     // For Cardano, derive 2nd staking derivation path from the primary one
     static DerivationPath cardanoStakingDerivationPath(const DerivationPath& path);
 };
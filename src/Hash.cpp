@@ -3,9 +3,18 @@
 // Copyright © 2017 Trust Wallet.
 
 #include "Hash.h"
+#include "HashContext.h"
 
 #include "rust/bindgen/WalletCoreRSBindgen.h"
 #include "rust/Wrapper.h"
+
+#include <TrezorCrypto/blake256.h>
+#include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/groestl.h>
+#include <TrezorCrypto/ripemd160.h>
+#include <TrezorCrypto/sha2.h>
+#include <TrezorCrypto/sha3.h>
+
 #include <string>
 
 using namespace TW;
@@ -123,3 +132,148 @@ Data Hash::hmac256(const Data& key, const Data& message) {
     Rust::CByteArrayWrapper res = Rust::hmac__sha256(key.data(), key.size(), message.data(), message.size());
     return res.data;
 }
+
+void Hash::sha1(const byte* data, size_t size, std::span<byte, sha1Size> out) {
+    sha1_Raw(data, size, out.data());
+}
+
+void Hash::sha256(const byte* data, size_t size, std::span<byte, sha256Size> out) {
+    sha256_Raw(data, size, out.data());
+}
+
+void Hash::sha512(const byte* data, size_t size, std::span<byte, sha512Size> out) {
+    sha512_Raw(data, size, out.data());
+}
+
+void Hash::sha512_256(const byte* data, size_t size, std::span<byte, 32> out) {
+    sha512_256_Raw(data, size, out.data());
+}
+
+void Hash::keccak256(const byte* data, size_t size, std::span<byte, 32> out) {
+    keccak_256(data, size, out.data());
+}
+
+void Hash::keccak512(const byte* data, size_t size, std::span<byte, 64> out) {
+    keccak_512(data, size, out.data());
+}
+
+void Hash::sha3_256(const byte* data, size_t size, std::span<byte, 32> out) {
+    ::sha3_256(data, size, out.data());
+}
+
+void Hash::sha3_512(const byte* data, size_t size, std::span<byte, 64> out) {
+    ::sha3_512(data, size, out.data());
+}
+
+void Hash::ripemd(const byte* data, size_t size, std::span<byte, ripemdSize> out) {
+    RipemdContext().update(data, size).final(out);
+}
+
+void Hash::blake256(const byte* data, size_t size, std::span<byte, 32> out) {
+    ::blake256(data, size, out.data());
+}
+
+void Hash::blake2b(const byte* data, size_t dataSize, std::span<byte> out) {
+    Blake2bContext(out.size()).update(data, dataSize).final(out);
+}
+
+void Hash::blake2b(const byte* data, size_t dataSize, std::span<byte> out, std::span<const byte> personal) {
+    Blake2bContext(out.size(), personal).update(data, dataSize).final(out);
+}
+
+void Hash::groestl512(const byte* data, size_t size, std::span<byte, 64> out) {
+    Groestl512Context().update(data, size).final(out);
+}
+
+void Hash::sha256d(const byte* data, size_t size, std::span<byte, sha256Size> out) {
+    sha256(data, size, out);
+    sha256(out.data(), out.size(), out);
+}
+
+void Hash::sha256ripemd(const byte* data, size_t size, std::span<byte, ripemdSize> out) {
+    Digest<sha256Size> inner;
+    sha256(data, size, inner);
+    ripemd(inner.data(), inner.size(), out);
+}
+
+void Hash::sha3_256ripemd(const byte* data, size_t size, std::span<byte, ripemdSize> out) {
+    Digest<32> inner;
+    sha3_256(data, size, inner);
+    ripemd(inner.data(), inner.size(), out);
+}
+
+void Hash::blake256d(const byte* data, size_t size, std::span<byte, 32> out) {
+    blake256(data, size, out);
+    blake256(out.data(), out.size(), out);
+}
+
+void Hash::blake256ripemd(const byte* data, size_t size, std::span<byte, ripemdSize> out) {
+    Digest<32> inner;
+    blake256(data, size, inner);
+    ripemd(inner.data(), inner.size(), out);
+}
+
+void Hash::groestl512d(const byte* data, size_t size, std::span<byte, 64> out) {
+    groestl512(data, size, out);
+    groestl512(out.data(), out.size(), out);
+}
+
+size_t Hash::hash(Hasher hasher, const byte* data, size_t dataSize, std::span<byte, maxHashSize> out) {
+    switch (hasher) {
+    case HasherSha1:
+        sha1(data, dataSize, out.first<sha1Size>());
+        return sha1Size;
+    case HasherSha256:
+        sha256(data, dataSize, out.first<sha256Size>());
+        return sha256Size;
+    case HasherSha512:
+        sha512(data, dataSize, out.first<sha512Size>());
+        return sha512Size;
+    case HasherSha512_256:
+        sha512_256(data, dataSize, out.first<32>());
+        return 32;
+    case HasherKeccak256:
+        keccak256(data, dataSize, out.first<32>());
+        return 32;
+    case HasherKeccak512:
+        keccak512(data, dataSize, out.first<64>());
+        return 64;
+    case HasherSha3_256:
+        sha3_256(data, dataSize, out.first<32>());
+        return 32;
+    case HasherSha3_512:
+        sha3_512(data, dataSize, out.first<64>());
+        return 64;
+    case HasherRipemd:
+        ripemd(data, dataSize, out.first<ripemdSize>());
+        return ripemdSize;
+    case HasherBlake2b:
+        blake2b(data, dataSize, out.first(32));
+        return 32;
+    case HasherBlake256:
+        blake256(data, dataSize, out.first<32>());
+        return 32;
+    case HasherGroestl512:
+        groestl512(data, dataSize, out.first<64>());
+        return 64;
+    case HasherSha256d:
+        sha256d(data, dataSize, out.first<sha256Size>());
+        return sha256Size;
+    case HasherSha256ripemd:
+        sha256ripemd(data, dataSize, out.first<ripemdSize>());
+        return ripemdSize;
+    case HasherSha3_256ripemd:
+        sha3_256ripemd(data, dataSize, out.first<ripemdSize>());
+        return ripemdSize;
+    case HasherBlake256d:
+        blake256d(data, dataSize, out.first<32>());
+        return 32;
+    case HasherBlake256ripemd:
+        blake256ripemd(data, dataSize, out.first<ripemdSize>());
+        return ripemdSize;
+    case HasherGroestl512d:
+        groestl512d(data, dataSize, out.first<64>());
+        return 64;
+    }
+    throw std::invalid_argument("Unsupported hasher");
+}
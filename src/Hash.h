@@ -6,7 +6,9 @@
 
 #include "Data.h"
 
+#include <array>
 #include <functional>
+#include <span>
 
 namespace TW::Hash {
 
@@ -51,6 +53,13 @@ static const size_t sha512Size = 64;
 /// Number of bytes in a RIPEMD160 hash.
 static const size_t ripemdSize = 20;
 
+/// Largest digest produced by any `Hasher`, used to size buffers for `hash()` below.
+static const size_t maxHashSize = 64;
+
+/// Fixed-size digest buffer, for the allocation-free overloads.
+template <std::size_t N>
+using Digest = std::array<byte, N>;
+
 /// Computes the SHA1 hash.
 Data sha1(const byte* data, size_t size);
 
@@ -217,4 +226,81 @@ inline Data groestl512d(const byte* data, size_t size) {
 /// Compute the SHA256-based HMAC of a message
 Data hmac256(const Data& key, const Data& message);
 
+// Allocation-free versions, writing the digest into a caller-provided buffer.
+// Streaming (init/update/final) contexts are in HashContext.h.
+
+/// Computes the SHA1 hash into `out`.
+void sha1(const byte* data, size_t size, std::span<byte, sha1Size> out);
+
+/// Computes the SHA256 hash into `out`.
+void sha256(const byte* data, size_t size, std::span<byte, sha256Size> out);
+
+/// Computes the SHA512 hash into `out`.
+void sha512(const byte* data, size_t size, std::span<byte, sha512Size> out);
+
+/// Computes the SHA512/256 hash into `out`.
+void sha512_256(const byte* data, size_t size, std::span<byte, 32> out);
+
+/// Computes the Keccak SHA256 hash into `out`.
+void keccak256(const byte* data, size_t size, std::span<byte, 32> out);
+
+/// Computes the Keccak SHA512 hash into `out`.
+void keccak512(const byte* data, size_t size, std::span<byte, 64> out);
+
+/// Computes the version 3 SHA256 hash into `out`.
+void sha3_256(const byte* data, size_t size, std::span<byte, 32> out);
+
+/// Computes the version 3 SHA512 hash into `out`.
+void sha3_512(const byte* data, size_t size, std::span<byte, 64> out);
+
+/// Computes the RIPEMD160 hash into `out`.
+void ripemd(const byte* data, size_t size, std::span<byte, ripemdSize> out);
+
+/// Computes the Blake256 hash into `out`.
+void blake256(const byte* data, size_t size, std::span<byte, 32> out);
+
+/// Computes the Blake2b hash into `out`; the hash size is `out.size()` (1 to 64 bytes).
+void blake2b(const byte* data, size_t dataSize, std::span<byte> out);
+
+/// Computes the personalized Blake2b hash into `out`; `personal` must be 16 bytes.
+void blake2b(const byte* data, size_t dataSize, std::span<byte> out, std::span<const byte> personal);
+
+/// Computes the Groestl512 hash into `out`.
+void groestl512(const byte* data, size_t size, std::span<byte, 64> out);
+
+/// Computes the SHA256 hash of the SHA256 hash into `out`.
+void sha256d(const byte* data, size_t size, std::span<byte, sha256Size> out);
+
+/// Computes the ripemd hash of the SHA256 hash into `out`.
+void sha256ripemd(const byte* data, size_t size, std::span<byte, ripemdSize> out);
+
+/// Computes the ripemd hash of the SHA3-256 hash into `out`.
+void sha3_256ripemd(const byte* data, size_t size, std::span<byte, ripemdSize> out);
+
+/// Computes the Blake256 hash of the Blake256 hash into `out`.
+void blake256d(const byte* data, size_t size, std::span<byte, 32> out);
+
+/// Computes the ripemd hash of the Blake256 hash into `out`.
+void blake256ripemd(const byte* data, size_t size, std::span<byte, ripemdSize> out);
+
+/// Computes the Groestl512 hash of the Groestl512 hash into `out`.
+void groestl512d(const byte* data, size_t size, std::span<byte, 64> out);
+
+/// Computes requested hash for data into the front of `out`, returns the digest size.
+size_t hash(Hasher hasher, const byte* data, size_t dataSize, std::span<byte, maxHashSize> out);
+
+/// Digest size of a hasher, in bytes.
+size_t hashSize(Hasher hasher);
+
+/// Computes the digests of many independent inputs into consecutive `hashSize(hasher)`-byte slots of `out`.
+/// SHA256 and Keccak256 (and the hashers built on SHA256) process several inputs at once on CPUs with AVX2,
+/// other hashers and CPUs hash the inputs one by one.
+void batch(Hasher hasher, std::span<const std::span<const byte>> inputs, std::span<byte> out);
+
+/// Computes requested hash for data into the front of `out`, returns the digest size.
+template <typename T>
+size_t hash(Hasher hasher, const T& data, std::span<byte, maxHashSize> out) {
+    return hash(hasher, reinterpret_cast<const byte*>(data.data()), data.size(), out);
+}
+
 } // namespace TW::Hash
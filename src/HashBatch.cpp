@@ -0,0 +1,395 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Hash.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TW_HASH_BATCH_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace TW::Hash {
+
+namespace {
+
+using Inputs = std::span<const std::span<const byte>>;
+
+void hashEach(Hasher hasher, Inputs inputs, std::span<byte> out, size_t digestSize) {
+    Digest<maxHashSize> digest;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        hash(hasher, inputs[i].data(), inputs[i].size(), digest);
+        std::copy(digest.begin(), digest.begin() + digestSize, out.begin() + i * digestSize);
+    }
+}
+
+#ifdef TW_HASH_BATCH_AVX2
+
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+    return supported;
+}
+
+/// Writes block `index` of the padded message into `block`: the message bytes, the `first` delimiter byte right after
+/// them and, in the last block, either the big-endian bit length (SHA2) or the `last` delimiter bit (Keccak).
+void paddedBlock(std::span<const byte> message, size_t index, size_t blockCount, size_t blockSize, byte* block,
+                 byte first, byte last, bool lengthSuffix) {
+    const auto offset = index * blockSize;
+    const auto copied = offset < message.size() ? std::min(blockSize, message.size() - offset) : size_t(0);
+    if (copied > 0) {
+        std::memcpy(block, message.data() + offset, copied);
+    }
+    std::memset(block + copied, 0, blockSize - copied);
+    if (message.size() >= offset && message.size() - offset < blockSize) {
+        block[message.size() - offset] = first;
+    }
+    if (index + 1 == blockCount) {
+        if (lengthSuffix) {
+            const uint64_t bits = uint64_t(message.size()) * 8;
+            for (size_t i = 0; i < 8; ++i) {
+                block[blockSize - 1 - i] = static_cast<byte>(bits >> (8 * i));
+            }
+        } else {
+            block[blockSize - 1] |= last;
+        }
+    }
+}
+
+// Multi-buffer SHA256: eight independent messages, one per 32-bit lane.
+
+constexpr size_t sha256Lanes = 8;
+constexpr size_t sha256Block = 64;
+
+constexpr std::array<uint32_t, 64> sha256K = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr std::array<uint32_t, 8> sha256Initial = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+__attribute__((target("avx2"))) inline __m256i rotr32(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_srl_epi32(x, _mm_cvtsi32_si128(n)), _mm256_sll_epi32(x, _mm_cvtsi32_si128(32 - n)));
+}
+
+__attribute__((target("avx2"))) void sha256Avx2(Inputs inputs, std::span<byte> out) {
+    const auto lanes = inputs.size();
+    std::array<size_t, sha256Lanes> blockCounts{};
+    size_t maxBlocks = 0;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        blockCounts[lane] = (inputs[lane].size() + 9 + sha256Block - 1) / sha256Block;
+        maxBlocks = std::max(maxBlocks, blockCounts[lane]);
+    }
+
+    std::array<__m256i, 8> state;
+    for (size_t i = 0; i < 8; ++i) {
+        state[i] = _mm256_set1_epi32(static_cast<int>(sha256Initial[i]));
+    }
+
+    alignas(32) std::array<std::array<uint32_t, sha256Lanes>, 16> words{};
+    std::array<byte, sha256Block> block;
+    for (size_t index = 0; index < maxBlocks; ++index) {
+        alignas(32) std::array<int32_t, sha256Lanes> active{};
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (index >= blockCounts[lane]) {
+                continue;
+            }
+            active[lane] = -1;
+            paddedBlock(inputs[lane], index, blockCounts[lane], sha256Block, block.data(), 0x80, 0, true);
+            for (size_t j = 0; j < 16; ++j) {
+                words[j][lane] = (uint32_t(block[4 * j]) << 24) | (uint32_t(block[4 * j + 1]) << 16) |
+                                 (uint32_t(block[4 * j + 2]) << 8) | uint32_t(block[4 * j + 3]);
+            }
+        }
+
+        std::array<__m256i, 16> w;
+        for (size_t j = 0; j < 16; ++j) {
+            w[j] = _mm256_load_si256(reinterpret_cast<const __m256i*>(words[j].data()));
+        }
+        auto a = state[0], b = state[1], c = state[2], d = state[3];
+        auto e = state[4], f = state[5], g = state[6], h = state[7];
+        for (size_t t = 0; t < 64; ++t) {
+            if (t >= 16) {
+                const auto w15 = w[(t - 15) & 15];
+                const auto w2 = w[(t - 2) & 15];
+                const auto s0 = _mm256_xor_si256(_mm256_xor_si256(rotr32(w15, 7), rotr32(w15, 18)), _mm256_srli_epi32(w15, 3));
+                const auto s1 = _mm256_xor_si256(_mm256_xor_si256(rotr32(w2, 17), rotr32(w2, 19)), _mm256_srli_epi32(w2, 10));
+                w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+            }
+            const auto sum1 = _mm256_xor_si256(_mm256_xor_si256(rotr32(e, 6), rotr32(e, 11)), rotr32(e, 25));
+            const auto ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            const auto t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, sum1), _mm256_add_epi32(ch, w[t & 15])),
+                                             _mm256_set1_epi32(static_cast<int>(sha256K[t])));
+            const auto sum0 = _mm256_xor_si256(_mm256_xor_si256(rotr32(a, 2), rotr32(a, 13)), rotr32(a, 22));
+            const auto maj = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)), _mm256_and_si256(b, c));
+            const auto t2 = _mm256_add_epi32(sum0, maj);
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi32(t1, t2);
+        }
+
+        // lanes whose message is already complete keep their state
+        const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(active.data()));
+        const std::array<__m256i, 8> rounds = {a, b, c, d, e, f, g, h};
+        for (size_t i = 0; i < 8; ++i) {
+            state[i] = _mm256_blendv_epi8(state[i], _mm256_add_epi32(state[i], rounds[i]), mask);
+        }
+    }
+
+    alignas(32) std::array<uint32_t, sha256Lanes> digestWords;
+    for (size_t i = 0; i < 8; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(digestWords.data()), state[i]);
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            auto* dst = out.data() + lane * sha256Size + 4 * i;
+            dst[0] = static_cast<byte>(digestWords[lane] >> 24);
+            dst[1] = static_cast<byte>(digestWords[lane] >> 16);
+            dst[2] = static_cast<byte>(digestWords[lane] >> 8);
+            dst[3] = static_cast<byte>(digestWords[lane]);
+        }
+    }
+}
+
+// Multi-buffer Keccak256: four independent messages, one per 64-bit lane.
+
+constexpr size_t keccakLanes = 4;
+constexpr size_t keccak256Rate = 136;
+
+constexpr std::array<uint64_t, 24> keccakRoundConstants = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+};
+
+/// Rotation offsets, indexed by x + 5y.
+constexpr std::array<int, 25> keccakRotations = {
+    0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14,
+};
+
+/// Target of the pi step for the lane at x + 5y: y + 5 * ((2x + 3y) % 5).
+constexpr std::array<std::size_t, 25> keccakPi = [] {
+    std::array<std::size_t, 25> pi{};
+    for (std::size_t x = 0; x < 5; ++x) {
+        for (std::size_t y = 0; y < 5; ++y) {
+            pi[x + 5 * y] = y + 5 * ((2 * x + 3 * y) % 5);
+        }
+    }
+    return pi;
+}();
+
+template <int N>
+__attribute__((target("avx2"))) inline __m256i rotl64(__m256i x) {
+    if constexpr (N == 0) {
+        return x;
+    } else {
+        return _mm256_or_si256(_mm256_slli_epi64(x, N), _mm256_srli_epi64(x, 64 - N));
+    }
+}
+
+// The steps are unrolled at compile time, so that every rotation is by an immediate.
+
+template <std::size_t... I>
+__attribute__((target("avx2"))) inline void keccakTheta(std::array<__m256i, 25>& a, std::index_sequence<I...>) {
+    std::array<__m256i, 5> c;
+    ((c[I] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[I], a[I + 5]), _mm256_xor_si256(a[I + 10], a[I + 15])), a[I + 20])), ...);
+    std::array<__m256i, 5> d;
+    ((d[I] = _mm256_xor_si256(c[(I + 4) % 5], rotl64<1>(c[(I + 1) % 5]))), ...);
+    ((a[I] = _mm256_xor_si256(a[I], d[I]), a[I + 5] = _mm256_xor_si256(a[I + 5], d[I]),
+      a[I + 10] = _mm256_xor_si256(a[I + 10], d[I]), a[I + 15] = _mm256_xor_si256(a[I + 15], d[I]),
+      a[I + 20] = _mm256_xor_si256(a[I + 20], d[I])), ...);
+}
+
+template <std::size_t... I>
+__attribute__((target("avx2"))) inline void keccakRhoPi(const std::array<__m256i, 25>& a, std::array<__m256i, 25>& b, std::index_sequence<I...>) {
+    ((b[keccakPi[I]] = rotl64<keccakRotations[I]>(a[I])), ...);
+}
+
+template <std::size_t... I>
+__attribute__((target("avx2"))) inline void keccakChi(std::array<__m256i, 25>& a, const std::array<__m256i, 25>& b, std::index_sequence<I...>) {
+    ((a[I] = _mm256_xor_si256(b[I], _mm256_andnot_si256(b[(I % 5 + 1) % 5 + I / 5 * 5], b[(I % 5 + 2) % 5 + I / 5 * 5]))), ...);
+}
+
+__attribute__((target("avx2"))) void keccakF1600(std::array<__m256i, 25>& a) {
+    std::array<__m256i, 25> b;
+    for (const auto roundConstant : keccakRoundConstants) {
+        keccakTheta(a, std::make_index_sequence<5>());
+        keccakRhoPi(a, b, std::make_index_sequence<25>());
+        keccakChi(a, b, std::make_index_sequence<25>());
+        a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(static_cast<long long>(roundConstant)));
+    }
+}
+
+__attribute__((target("avx2"))) void keccak256Avx2(Inputs inputs, std::span<byte> out) {
+    const auto lanes = inputs.size();
+    std::array<size_t, keccakLanes> blockCounts{};
+    size_t maxBlocks = 0;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        blockCounts[lane] = inputs[lane].size() / keccak256Rate + 1;
+        maxBlocks = std::max(maxBlocks, blockCounts[lane]);
+    }
+
+    std::array<__m256i, 25> state;
+    state.fill(_mm256_setzero_si256());
+    alignas(32) std::array<std::array<uint64_t, keccakLanes>, keccak256Rate / 8> words{};
+    std::array<byte, keccak256Rate> block;
+    for (size_t index = 0; index < maxBlocks; ++index) {
+        alignas(32) std::array<int64_t, keccakLanes> active{};
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (index >= blockCounts[lane]) {
+                continue;
+            }
+            active[lane] = -1;
+            paddedBlock(inputs[lane], index, blockCounts[lane], keccak256Rate, block.data(), 0x01, 0x80, false);
+            for (size_t j = 0; j < words.size(); ++j) {
+                uint64_t word = 0;
+                for (size_t k = 0; k < 8; ++k) {
+                    word |= uint64_t(block[8 * j + k]) << (8 * k);
+                }
+                words[j][lane] = word;
+            }
+        }
+
+        const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(active.data()));
+        auto next = state;
+        for (size_t j = 0; j < words.size(); ++j) {
+            next[j] = _mm256_xor_si256(next[j], _mm256_load_si256(reinterpret_cast<const __m256i*>(words[j].data())));
+        }
+        keccakF1600(next);
+        // lanes whose message is already complete keep their state
+        for (size_t j = 0; j < state.size(); ++j) {
+            state[j] = _mm256_blendv_epi8(state[j], next[j], mask);
+        }
+    }
+
+    alignas(32) std::array<uint64_t, keccakLanes> digestWords;
+    for (size_t j = 0; j < 4; ++j) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(digestWords.data()), state[j]);
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            for (size_t k = 0; k < 8; ++k) {
+                out[lane * 32 + 8 * j + k] = static_cast<byte>(digestWords[lane] >> (8 * k));
+            }
+        }
+    }
+}
+
+#endif // TW_HASH_BATCH_AVX2
+
+void sha256Batch(Inputs inputs, std::span<byte> out) {
+#ifdef TW_HASH_BATCH_AVX2
+    if (inputs.size() > 1 && hasAvx2()) {
+        for (size_t i = 0; i < inputs.size(); i += sha256Lanes) {
+            const auto lanes = std::min(sha256Lanes, inputs.size() - i);
+            sha256Avx2(inputs.subspan(i, lanes), out.subspan(i * sha256Size, lanes * sha256Size));
+        }
+        return;
+    }
+#endif
+    hashEach(HasherSha256, inputs, out, sha256Size);
+}
+
+void keccak256Batch(Inputs inputs, std::span<byte> out) {
+#ifdef TW_HASH_BATCH_AVX2
+    if (inputs.size() > 1 && hasAvx2()) {
+        for (size_t i = 0; i < inputs.size(); i += keccakLanes) {
+            const auto lanes = std::min(keccakLanes, inputs.size() - i);
+            keccak256Avx2(inputs.subspan(i, lanes), out.subspan(i * 32, lanes * 32));
+        }
+        return;
+    }
+#endif
+    hashEach(HasherKeccak256, inputs, out, 32);
+}
+
+/// Spans over consecutive `size`-byte digests, to feed one batch into the next.
+std::vector<std::span<const byte>> slots(std::span<const byte> digests, size_t count, size_t size) {
+    std::vector<std::span<const byte>> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(digests.subspan(i * size, size));
+    }
+    return result;
+}
+
+} // namespace
+
+size_t hashSize(Hasher hasher) {
+    switch (hasher) {
+    case HasherSha1:
+    case HasherRipemd:
+    case HasherSha256ripemd:
+    case HasherSha3_256ripemd:
+    case HasherBlake256ripemd:
+        return 20;
+    case HasherSha512:
+    case HasherKeccak512:
+    case HasherSha3_512:
+    case HasherGroestl512:
+    case HasherGroestl512d:
+        return 64;
+    case HasherSha256:
+    case HasherSha512_256:
+    case HasherKeccak256:
+    case HasherSha3_256:
+    case HasherBlake2b:
+    case HasherBlake256:
+    case HasherSha256d:
+    case HasherBlake256d:
+        return 32;
+    }
+    throw std::invalid_argument("Unsupported hasher");
+}
+
+void batch(Hasher hasher, std::span<const std::span<const byte>> inputs, std::span<byte> out) {
+    const auto digestSize = hashSize(hasher);
+    if (out.size() < inputs.size() * digestSize) {
+        throw std::invalid_argument("Output buffer too small");
+    }
+    switch (hasher) {
+    case HasherSha256:
+        sha256Batch(inputs, out);
+        return;
+    case HasherKeccak256:
+        keccak256Batch(inputs, out);
+        return;
+    case HasherSha256d: {
+        sha256Batch(inputs, out);
+        sha256Batch(slots(out, inputs.size(), sha256Size), out);
+        return;
+    }
+    case HasherSha256ripemd: {
+        Data inner(inputs.size() * sha256Size);
+        sha256Batch(inputs, inner);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            ripemd(inner.data() + i * sha256Size, sha256Size, out.subspan(i * ripemdSize).first<ripemdSize>());
+        }
+        return;
+    }
+    default:
+        hashEach(hasher, inputs, out, digestSize);
+        return;
+    }
+}
+
+} // namespace TW::Hash
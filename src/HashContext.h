@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "Data.h"
+#include "Hash.h"
+#include "memory/memzero_wrapper.h"
+
+#include <TrezorCrypto/blake256.h>
+#include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/groestl.h>
+#include <TrezorCrypto/ripemd160.h>
+#include <TrezorCrypto/sha2.h>
+#include <TrezorCrypto/sha3.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace TW::Hash {
+
+namespace internal {
+
+inline void ripemdUpdate(RIPEMD160_CTX* ctx, const byte* data, std::size_t size) {
+    ripemd160_Update(ctx, data, static_cast<uint32_t>(size));
+}
+
+inline void groestl512Init(GROESTL512_CTX* ctx) {
+    groestl512_Init(ctx);
+}
+
+inline void groestl512Update(GROESTL512_CTX* ctx, const byte* data, std::size_t size) {
+    groestl512_Update(ctx, data, size);
+}
+
+inline void groestl512Final(GROESTL512_CTX* ctx, byte* out) {
+    groestl512_Final(ctx, out);
+}
+
+} // namespace internal
+
+/// Streaming (init/update/final) hash context, kept on the stack and finalized into a caller-provided buffer.
+///
+/// The context is initialized on construction; call `reset()` to reuse it after `final()`.
+/// Copying a context is allowed, so a common prefix can be hashed once.
+/// The internal state is wiped on destruction.
+template <typename Ctx, std::size_t DigestSize,
+          void (*Init)(Ctx*), void (*Update)(Ctx*, const byte*, std::size_t), void (*Final)(Ctx*, byte*)>
+class Context {
+public:
+    static constexpr std::size_t digestSize = DigestSize;
+
+    Context() { Init(&ctx); }
+    Context(const Context&) = default;
+    Context& operator=(const Context&) = default;
+    ~Context() { memzero(&ctx); }
+
+    void reset() { Init(&ctx); }
+
+    Context& update(const byte* data, std::size_t size) {
+        Update(&ctx, data, size);
+        return *this;
+    }
+
+    template <typename T>
+    Context& update(const T& data) {
+        return update(reinterpret_cast<const byte*>(data.data()), data.size());
+    }
+
+    void final(std::span<byte, DigestSize> out) { Final(&ctx, out.data()); }
+
+    Digest<DigestSize> final() {
+        Digest<DigestSize> out;
+        final(out);
+        return out;
+    }
+
+private:
+    Ctx ctx;
+};
+
+using Sha1Context = Context<SHA1_CTX, sha1Size, sha1_Init, sha1_Update, sha1_Final>;
+using Sha256Context = Context<SHA256_CTX, sha256Size, sha256_Init, sha256_Update, sha256_Final>;
+using Sha512Context = Context<SHA512_CTX, sha512Size, sha512_Init, sha512_Update, sha512_Final>;
+using Keccak256Context = Context<SHA3_CTX, 32, sha3_256_Init, sha3_Update, keccak_Final>;
+using Keccak512Context = Context<SHA3_CTX, 64, sha3_512_Init, sha3_Update, keccak_Final>;
+using Sha3_256Context = Context<SHA3_CTX, 32, sha3_256_Init, sha3_Update, sha3_Final>;
+using Sha3_512Context = Context<SHA3_CTX, 64, sha3_512_Init, sha3_Update, sha3_Final>;
+using RipemdContext = Context<RIPEMD160_CTX, ripemdSize, ripemd160_Init, internal::ripemdUpdate, ripemd160_Final>;
+using Blake256Context = Context<BLAKE256_CTX, 32, blake256_Init, blake256_Update, blake256_Final>;
+using Groestl512Context = Context<GROESTL512_CTX, 64, internal::groestl512Init, internal::groestl512Update, internal::groestl512Final>;
+
+/// Streaming Blake2b context; the hash size (and optional 16-byte personalization) is chosen at construction.
+class Blake2bContext {
+public:
+    explicit Blake2bContext(std::size_t hashSize = 32, std::span<const byte> personal = {})
+        : personal(personal.begin(), personal.end()), hashSize(hashSize) {
+        reset();
+    }
+    Blake2bContext(const Blake2bContext&) = default;
+    Blake2bContext& operator=(const Blake2bContext&) = default;
+    ~Blake2bContext() { memzero(&ctx); }
+
+    void reset() {
+        const auto res = personal.empty()
+                             ? tc_blake2b_Init(&ctx, hashSize)
+                             : tc_blake2b_InitPersonal(&ctx, hashSize, personal.data(), personal.size());
+        if (res != 0) {
+            throw std::invalid_argument("Invalid blake2b hash size or personalization");
+        }
+    }
+
+    Blake2bContext& update(const byte* data, std::size_t size) {
+        tc_blake2b_Update(&ctx, data, size);
+        return *this;
+    }
+
+    template <typename T>
+    Blake2bContext& update(const T& data) {
+        return update(reinterpret_cast<const byte*>(data.data()), data.size());
+    }
+
+    /// Writes the digest into `out`, which must be exactly the hash size.
+    void final(std::span<byte> out) {
+        if (out.size() != hashSize) {
+            throw std::invalid_argument("Invalid blake2b output size");
+        }
+        tc_blake2b_Final(&ctx, out.data(), out.size());
+    }
+
+private:
+    blake2b_state ctx;
+    Data personal;
+    std::size_t hashSize;
+};
+
+} // namespace TW::Hash
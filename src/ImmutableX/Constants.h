@@ -6,6 +6,8 @@
 
 #include "uint256.h"
 
+#include <array>
+
 namespace TW::ImmutableX {
 
 namespace internal {
@@ -17,6 +19,13 @@ inline const int256_t gStarkCurveB("31415926535897932384626433832795028841971693
 inline const int256_t gStarkCurveN("3618502788666131213697322783095070105526743751716087489154079457884512865583");
 inline const int256_t gStarkCurveP("3618502788666131213697322783095070105623107215331596699973092056135872020481");
 inline const int256_t gStarkDeriveBias("112173586448650067624617006275947173271329056303198712163776463194419898833073");
+/// `gStarkCurveN` and `gStarkDeriveBias` as 32 big-endian bytes.
+inline constexpr std::array<byte, 32> gStarkCurveNBytes = {
+    0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xb7, 0x81, 0x12, 0x6d, 0xca, 0xe7, 0xb2, 0x32, 0x1e, 0x66, 0xa2, 0x41, 0xad, 0xc6, 0x4d, 0x2f};
+inline constexpr std::array<byte, 32> gStarkDeriveBiasBytes = {
+    0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x0e, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7,
+    0x38, 0xa1, 0x3b, 0x4b, 0x92, 0x0e, 0x94, 0x11, 0xae, 0x6d, 0xa5, 0xf4, 0x0b, 0x03, 0x58, 0xb1};
 } // namespace internal
 
 } // namespace TW::ImmutableX
@@ -7,6 +7,7 @@
 #include <HexCoding.h>
 #include <ImmutableX/Constants.h>
 #include <ImmutableX/StarkKey.h>
+#include <HashContext.h>
 #include <rust/bindgen/WalletCoreRSBindgen.h>
 
 namespace TW::ImmutableX {
@@ -18,27 +19,66 @@ uint256_t hashKeyWithIndex(const Data& seed, std::size_t index) {
     return load(out);
 }
 
-std::string grindKey(const Data& seed) {
+namespace {
+
+using KeyBytes = std::array<byte, 32>;
+
+/// SHA256 of `data` followed by the `index` byte.
+void hashWithIndex(const byte* data, std::size_t size, std::size_t index, KeyBytes& out) {
+    Hash::Sha256Context context;
+    const auto indexByte = static_cast<byte>(index);
+    context.update(data, size);
+    context.update(&indexByte, 1);
+    context.final(out);
+}
+
+/// Subtracts `b` from `a`, both big-endian; `a` must not be less than `b`.
+void subtract(KeyBytes& a, const KeyBytes& b) {
+    int borrow = 0;
+    for (auto i = a.size(); i-- > 0;) {
+        const int difference = int(a[i]) - int(b[i]) - borrow;
+        borrow = difference < 0 ? 1 : 0;
+        a[i] = static_cast<byte>(difference + (borrow << 8));
+    }
+}
+
+} // namespace
+
+std::array<byte, 32> grindKeyBytes(const Data& seed) {
+    using namespace internal;
+    // big-endian byte arrays of the same size compare as the numbers they hold
     std::size_t index{0};
-    int256_t key = hashKeyWithIndex(seed, index);
-    while (key >= internal::gStarkDeriveBias) {
-        key = hashKeyWithIndex(store(uint256_t(key)), index);
+    KeyBytes key;
+    hashWithIndex(seed.data(), seed.size(), index, key);
+    while (key >= gStarkDeriveBiasBytes) {
+        // the key is above the bias, so it has no leading zero byte
+        hashWithIndex(key.data(), key.size(), index, key);
         index += 1;
     }
-    auto finalKey = key % internal::gStarkCurveN;
-    std::stringstream ss;
-    ss << std::hex << finalKey;
-    return ss.str();
+    // the key is below the bias, a multiple of the order: a few subtractions reduce it
+    while (key >= gStarkCurveNBytes) {
+        subtract(key, gStarkCurveNBytes);
+    }
+    return key;
+}
+
+std::string grindKey(const Data& seed) {
+    const auto key = grindKeyBytes(seed);
+    // hex number, without leading zeros
+    const auto str = hex(key);
+    const auto first = str.find_first_not_of('0');
+    return first == std::string::npos ? "0" : str.substr(first);
 }
 
 PrivateKey getPrivateKeyFromSeed(const Data& seed, const DerivationPath& path) {
     auto key = HDWallet<32>::bip32DeriveRawSeed(TWCoinTypeEthereum, seed, path);
-    auto data = parse_hex(grindKey(key.bytes), true);
-    return PrivateKey(data, TWCurveStarkex);
+    const auto grinded = grindKeyBytes(key.bytes);
+    return PrivateKey(Data(grinded.begin(), grinded.end()), TWCurveStarkex);
 }
 
 PrivateKey getPrivateKeyFromEthPrivKey(const PrivateKey& ethPrivKey) {
-    return PrivateKey(parse_hex(ImmutableX::grindKey(ethPrivKey.bytes), true), TWCurveStarkex);
+    const auto grinded = grindKeyBytes(ethPrivKey.bytes);
+    return PrivateKey(Data(grinded.begin(), grinded.end()), TWCurveStarkex);
 }
 
 PrivateKey getPrivateKeyFromRawSignature(const Data& signature, const DerivationPath& derivationPath) {
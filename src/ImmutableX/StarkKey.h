@@ -7,12 +7,17 @@
 #include "uint256.h"
 #include <PrivateKey.h>
 #include <DerivationPath.h>
+#include <array>
 #include <string>
 
 namespace TW::ImmutableX {
 
 uint256_t hashKeyWithIndex(const Data& seed, std::size_t index);
 
+/// Grinds `seed` into a private key of the Stark curve, as 32 big-endian bytes.
+std::array<byte, 32> grindKeyBytes(const Data& seed);
+
+/// Grinds `seed` into a private key of the Stark curve, as a hex number without leading zeros.
 std::string grindKey(const Data& seed);
 
 PrivateKey getPrivateKeyFromSeed(const std::string& seed, const DerivationPath& path);
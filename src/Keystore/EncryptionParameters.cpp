@@ -3,12 +3,13 @@
 // Copyright © 2017 Trust Wallet.
 
 #include "EncryptionParameters.h"
+#include "Scrypt.h"
 
 #include "../Hash.h"
+#include "../memory/memzero_wrapper.h"
 
 #include <TrezorCrypto/aes.h>
 #include <TrezorCrypto/pbkdf2.h>
-#include <TrezorCrypto/scrypt.h>
 #include <cassert>
 
 using namespace TW;
@@ -69,9 +70,7 @@ EncryptedPayload::EncryptedPayload(const Data& password, const Data& data, const
     : params(std::move(params)), _mac() {
     auto scryptParams = std::get<ScryptParameters>(this->params.kdfParams);
     auto derivedKey = Data(scryptParams.desiredKeyLength);
-    scrypt(reinterpret_cast<const byte*>(password.data()), password.size(), scryptParams.salt.data(),
-           scryptParams.salt.size(), scryptParams.n, scryptParams.r, scryptParams.p, derivedKey.data(),
-           scryptParams.desiredKeyLength);
+    deriveScryptKey(password, scryptParams, derivedKey);
 
     aes_encrypt_ctx ctx;
     auto result = 0;
@@ -102,25 +101,32 @@ EncryptedPayload::~EncryptedPayload() {
 }
 
 Data EncryptedPayload::decrypt(const Data& password) const {
-    auto derivedKey = Data();
-    auto mac = Data();
+    DerivedKey derivedKey;
+    deriveKey(password, derivedKey);
+    try {
+        auto decrypted = decrypt(derivedKey);
+        memzero(&derivedKey);
+        return decrypted;
+    } catch (...) {
+        memzero(&derivedKey);
+        throw;
+    }
+}
 
+void EncryptedPayload::deriveKey(const Data& password, DerivedKey& derivedKey) const {
     if (auto* scryptParams = std::get_if<ScryptParameters>(&params.kdfParams); scryptParams) {
-        derivedKey.resize(scryptParams->defaultDesiredKeyLength);
-        scrypt(password.data(), password.size(), scryptParams->salt.data(),
-               scryptParams->salt.size(), scryptParams->n, scryptParams->r, scryptParams->p, derivedKey.data(),
-               scryptParams->defaultDesiredKeyLength);
-        mac = computeMAC(derivedKey.end() - params.getKeyBytesSize(), derivedKey.end(), encrypted);
+        deriveScryptKey(password, *scryptParams, derivedKey);
     } else if (auto* pbkdf2Params = std::get_if<PBKDF2Parameters>(&params.kdfParams); pbkdf2Params) {
-        derivedKey.resize(pbkdf2Params->defaultDesiredKeyLength);
         pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), pbkdf2Params->salt.data(),
                            static_cast<int>(pbkdf2Params->salt.size()), pbkdf2Params->iterations, derivedKey.data(),
-                           pbkdf2Params->defaultDesiredKeyLength);
-        mac = computeMAC(derivedKey.end() - params.getKeyBytesSize(), derivedKey.end(), encrypted);
+                           derivedKey.size());
     } else {
         throw DecryptionError::unsupportedKDF;
     }
+}
 
+Data EncryptedPayload::decrypt(std::span<const byte, derivedKeySize> derivedKey) const {
+    const auto mac = computeMAC(derivedKey.end() - params.getKeyBytesSize(), derivedKey.end(), encrypted);
     if (mac != _mac) {
         throw DecryptionError::invalidPassword;
     }
@@ -135,6 +141,7 @@ Data EncryptedPayload::decrypt(const Data& password) const {
 
         aes_ctr_decrypt(encrypted.data(), decrypted.data(), static_cast<int>(encrypted.size()), iv.data(),
                         aes_ctr_cbuf_inc, &ctx);
+        memzero(&ctx);
     } else if (encryption == TWStoredKeyEncryptionAes128Cbc) {
         aes_decrypt_ctx ctx;
         [[maybe_unused]] auto result = aes_decrypt_key(derivedKey.data(), params.getKeyBytesSize(), &ctx);
@@ -143,6 +150,7 @@ Data EncryptedPayload::decrypt(const Data& password) const {
         for (auto i = 0ul; i < encrypted.size(); i += params.getKeyBytesSize()) {
             aes_cbc_decrypt(encrypted.data() + i, decrypted.data() + i, params.getKeyBytesSize(), iv.data(), &ctx);
         }
+        memzero(&ctx);
     } else {
         throw DecryptionError::unsupportedCipher;
     }
@@ -150,6 +158,13 @@ Data EncryptedPayload::decrypt(const Data& password) const {
     return decrypted;
 }
 
+bool EncryptedPayload::hasSameKeyDerivation(const EncryptedPayload& other) const {
+    // the JSON encoding holds every parameter of the key derivation function
+    const auto kdf = params.json();
+    const auto otherKdf = other.params.json();
+    return kdf[CodingKeys::kdf] == otherKdf[CodingKeys::kdf] && kdf[CodingKeys::kdfParams] == otherKdf[CodingKeys::kdfParams];
+}
+
 EncryptedPayload::EncryptedPayload(const nlohmann::json& json) {
     params = EncryptionParameters(json);
     encrypted = parse_hex(json[CodingKeys::encrypted].get<std::string>());
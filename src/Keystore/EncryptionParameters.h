@@ -12,6 +12,8 @@
 #include <TrustWalletCore/TWStoredKeyEncryptionLevel.h>
 
 #include <nlohmann/json.hpp>
+#include <array>
+#include <span>
 #include <string>
 #include <variant>
 
@@ -75,6 +77,7 @@ enum class DecryptionError {
     invalidKeyFile,
     invalidCipher,
     invalidPassword,
+    sessionExpired,
 };
 
 /// An encrypted payload data
@@ -103,9 +106,26 @@ public:
     /// Initializes with a JSON object.
     explicit EncryptedPayload(const nlohmann::json& json);
 
+    /// Size of the key derived from the password.
+    static const std::size_t derivedKeySize = 32;
+
+    using DerivedKey = std::array<byte, derivedKeySize>;
+
     /// Decrypts the payload with the given password.
     Data decrypt(const Data& password) const;
 
+    /// Runs the key derivation function with the given password into `derivedKey`, without checking the password.
+    void deriveKey(const Data& password, DerivedKey& derivedKey) const;
+
+    /// Decrypts the payload with a key derived by `deriveKey`, skipping the key derivation function.
+    ///
+    /// \throws DecryptionError::invalidPassword if the key does not match the MAC.
+    Data decrypt(std::span<const byte, derivedKeySize> derivedKey) const;
+
+    /// Whether the key derivation function and its parameters are the same as those of `other`, so that both
+    /// payloads derive the same key from a password.
+    bool hasSameKeyDerivation(const EncryptedPayload& other) const;
+
     /// Saves `this` as a JSON object.
     nlohmann::json json() const;
 
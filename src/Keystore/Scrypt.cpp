@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Scrypt.h"
+
+#include "../memory/memzero_wrapper.h"
+
+#include <TrezorCrypto/pbkdf2.h>
+#include <TrezorCrypto/scrypt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace TW::Keystore {
+
+void deriveScryptKey(const Data& password, const ScryptParameters& params, std::span<byte> derivedKey,
+                     std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min<std::size_t>(threads, params.p);
+    if (threads <= 1) {
+        // a single lane at a time, the sequential implementation reuses its working memory
+        if (::scrypt(password.data(), password.size(), params.salt.data(), params.salt.size(), params.n, params.r,
+                     params.p, derivedKey.data(), derivedKey.size()) != 0) {
+            throw std::runtime_error("scrypt failed");
+        }
+        return;
+    }
+
+    // 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen)
+    const std::size_t laneSize = 128 * std::size_t(params.r);
+    Data blocks(laneSize * params.p);
+    pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), params.salt.data(),
+                       static_cast<int>(params.salt.size()), 1, blocks.data(), static_cast<int>(blocks.size()));
+
+    // 2: B_i <-- MF(B_i, N), thread t takes lanes t, t + threads, ...
+    std::atomic<bool> failed = false;
+    const auto mixLanes = [&](std::size_t first) {
+        for (auto lane = first; lane < params.p && !failed; lane += threads) {
+            if (scrypt_smix(blocks.data() + lane * laneSize, params.r, params.n) != 0) {
+                failed = true;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t first = 1; first < threads; ++first) {
+        workers.emplace_back(mixLanes, first);
+    }
+    mixLanes(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (!failed) {
+        // 5: DK <-- PBKDF2(P, B, 1, dkLen)
+        pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), blocks.data(),
+                           static_cast<int>(blocks.size()), 1, derivedKey.data(), static_cast<int>(derivedKey.size()));
+    }
+    memzero(blocks.data(), blocks.size());
+    if (failed) {
+        throw std::runtime_error("scrypt failed");
+    }
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "ScryptParameters.h"
+#include "Data.h"
+
+#include <cstddef>
+#include <span>
+
+namespace TW::Keystore {
+
+/// Derives `derivedKey.size()` bytes from `password` with scrypt.
+///
+/// The p lanes of `params` are independent, and are computed concurrently on up to `threads` threads (0 for the
+/// hardware concurrency), each with its own 128 * r * N bytes of memory. The result is the same as a sequential scrypt.
+///
+/// \throws std::runtime_error if the working memory cannot be allocated.
+void deriveScryptKey(const Data& password, const ScryptParameters& params, std::span<byte> derivedKey,
+                     std::size_t threads = 0);
+
+} // namespace TW::Keystore
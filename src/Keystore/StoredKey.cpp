@@ -3,6 +3,7 @@
 // Copyright © 2017 Trust Wallet.
 
 #include "StoredKey.h"
+#include "UnlockSession.h"
 
 #include "Coin.h"
 #include "HexCoding.h"
@@ -116,6 +117,13 @@ const HDWallet<> StoredKey::wallet(const Data& password) const {
     return HDWallet<>(mnemonic, "");
 }
 
+std::shared_ptr<const HDWallet<>> StoredKey::wallet(const UnlockSession& session) const {
+    if (type != StoredKeyType::mnemonicPhrase) {
+        throw std::invalid_argument("Invalid account requested.");
+    }
+    return session.wallet(payload);
+}
+
 std::vector<Account> StoredKey::getAccounts(TWCoinType coin) const {
     std::vector<Account> result;
     for (auto& account : accounts) {
@@ -294,31 +302,63 @@ const PrivateKey StoredKey::privateKey(TWCoinType coin, [[maybe_unused]] TWDeriv
     return PrivateKey(payload.decrypt(password), TWCoinTypeCurve(coin));
 }
 
+const PrivateKey StoredKey::privateKey(TWCoinType coin, const UnlockSession& session) {
+    return privateKey(coin, TWDerivationDefault, session);
+}
+
+const PrivateKey StoredKey::privateKey(TWCoinType coin, [[maybe_unused]] TWDerivation derivation, const UnlockSession& session) {
+    if (type == StoredKeyType::mnemonicPhrase) {
+        const auto wallet = session.wallet(payload);
+        const Account& account = this->account(coin, derivation, *wallet);
+        return wallet->getKey(coin, account.derivationPath);
+    }
+    // type == StoredKeyType::privateKey
+    return PrivateKey(session.decrypt(payload), TWCoinTypeCurve(coin));
+}
+
 void StoredKey::fixAddresses(const Data& password) {
     switch (type) {
-    case StoredKeyType::mnemonicPhrase: {
-        const auto wallet = this->wallet(password);
-        for (auto& account : accounts) {
-            if (!account.address.empty() && !account.publicKey.empty() &&
-                TW::validateAddress(account.coin, account.address)) {
-                continue;
-            }
-            const auto& derivationPath = account.derivationPath;
-            const auto key = wallet.getKey(account.coin, derivationPath);
-            updateAddressForAccount(key, account);
+    case StoredKeyType::mnemonicPhrase:
+        fixAddresses(wallet(password));
+        break;
+
+    case StoredKeyType::privateKey:
+        fixAddresses(PrivateKey(payload.decrypt(password)));
+        break;
+    }
+}
+
+void StoredKey::fixAddresses(const UnlockSession& session) {
+    switch (type) {
+    case StoredKeyType::mnemonicPhrase:
+        fixAddresses(*session.wallet(payload));
+        break;
+
+    case StoredKeyType::privateKey:
+        fixAddresses(PrivateKey(session.decrypt(payload)));
+        break;
+    }
+}
+
+void StoredKey::fixAddresses(const HDWallet<>& wallet) {
+    for (auto& account : accounts) {
+        if (!account.address.empty() && !account.publicKey.empty() &&
+            TW::validateAddress(account.coin, account.address)) {
+            continue;
         }
-    } break;
-
-    case StoredKeyType::privateKey: {
-        auto key = PrivateKey(payload.decrypt(password));
-        for (auto& account : accounts) {
-            if (!account.address.empty() && !account.publicKey.empty() &&
-                TW::validateAddress(account.coin, account.address)) {
-                continue;
-            }
-            updateAddressForAccount(key, account);
+        const auto& derivationPath = account.derivationPath;
+        const auto key = wallet.getKey(account.coin, derivationPath);
+        updateAddressForAccount(key, account);
+    }
+}
+
+void StoredKey::fixAddresses(const PrivateKey& key) {
+    for (auto& account : accounts) {
+        if (!account.address.empty() && !account.publicKey.empty() &&
+            TW::validateAddress(account.coin, account.address)) {
+            continue;
         }
-    } break;
+        updateAddressForAccount(key, account);
     }
 }
 
@@ -350,6 +390,16 @@ const std::string StoredKey::decryptPrivateKeyEncoded(const Data& password) cons
     }
 }
 
+const std::string StoredKey::decryptPrivateKeyEncoded(const UnlockSession& session) const {
+    if (encodedPayload) {
+        auto data = session.decrypt(*encodedPayload);
+        return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+    } else {
+        auto data = session.decrypt(payload);
+        return TW::hex(data);
+    }
+}
+
 // -----------------
 // Encoding/Decoding
 // -----------------
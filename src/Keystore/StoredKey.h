@@ -14,12 +14,15 @@
 #include <TrustWalletCore/TWStoredKeyEncryption.h>
 #include <nlohmann/json.hpp>
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace TW::Keystore {
 
+class UnlockSession;
+
 /// An stored key can be either a private key or a mnemonic phrase for a HD
 /// wallet.
 enum class StoredKeyType { privateKey, mnemonicPhrase };
@@ -91,6 +94,13 @@ public:
     /// @throws std::invalid_argument if this key is of a type other than `mnemonicPhrase`.
     const HDWallet<> wallet(const Data& password) const;
 
+    /// Returns the HDWallet for this key, from an unlock session of it.
+    /// The wallet is the one owned by the session, not a copy of the mnemonic and seed.
+    ///
+    /// @throws std::invalid_argument if this key is of a type other than `mnemonicPhrase`.
+    /// @throws DecryptionError if the session has expired, or is not a session of this key.
+    std::shared_ptr<const HDWallet<>> wallet(const UnlockSession& session) const;
+
     /// Returns all the accounts for a specific coin: 0, 1, or more.
     std::vector<Account> getAccounts(TWCoinType coin) const;
 
@@ -141,6 +151,16 @@ public:
     /// `mnemonicPhrase` and a coin other than the default is requested.
     const PrivateKey privateKey(TWCoinType coin, TWDerivation derivation, const Data& password);
 
+    /// Returns the private key for a specific coin, using default derivation, from an unlock session of this key.
+    const PrivateKey privateKey(TWCoinType coin, const UnlockSession& session);
+
+    /// Returns the private key for a specific coin, from an unlock session of this key, creating an account if necessary.
+    ///
+    /// \throws std::invalid_argument if this key is of a type other than
+    /// `mnemonicPhrase` and a coin other than the default is requested.
+    /// \throws DecryptionError if the session has expired, or is not a session of this key.
+    const PrivateKey privateKey(TWCoinType coin, TWDerivation derivation, const UnlockSession& session);
+
     /// Loads and decrypts a stored key from a file.
     ///
     /// \param path file path to load from.
@@ -165,6 +185,9 @@ public:
     /// the encryption password to re-derive addresses from private keys.
     void fixAddresses(const Data& password);
 
+    /// Fills in all empty or invalid addresses and public keys, from an unlock session of this key.
+    void fixAddresses(const UnlockSession& session);
+
     /// Re-derives address for the account(s) associated with the given coin.
     ///
     /// This method can be used if address format has been changed.
@@ -177,6 +200,12 @@ public:
     /// \throws DecryptionError
     const std::string decryptPrivateKeyEncoded(const Data& password) const;
 
+    /// Decrypts the encoded private key, from an unlock session of this key.
+    ///
+    /// \returns the decoded private key.
+    /// \throws DecryptionError
+    const std::string decryptPrivateKeyEncoded(const UnlockSession& session) const;
+
 private:
     /// Default constructor, private
     StoredKey() : type(StoredKeyType::mnemonicPhrase) {}
@@ -211,6 +240,12 @@ private:
     /// Re-derive account address if missing
     Account fillAddressIfMissing(Account& account, const HDWallet<>* wallet) const;
 
+    /// Fills in all empty or invalid addresses and public keys of a mnemonic.
+    void fixAddresses(const HDWallet<>& wallet);
+
+    /// Fills in all empty or invalid addresses and public keys of a private key.
+    void fixAddresses(const PrivateKey& key);
+
     /// Re-derives public key and address for the specified account.
     static void updateAddressForAccount(const PrivateKey& privKey, Account& account);
 };
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "UnlockSession.h"
+
+#include "../memory/memzero_wrapper.h"
+
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace TW::Keystore {
+
+#if defined(__unix__) || defined(__APPLE__)
+namespace {
+
+std::size_t roundUpToPageSize(std::size_t size) {
+    const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return (size + pageSize - 1) / pageSize * pageSize;
+}
+
+} // namespace
+#endif
+
+/// Derived keys, locked in memory for the lifetime of the session.
+struct UnlockSession::Secrets {
+    EncryptedPayload::DerivedKey payloadKey;
+    EncryptedPayload::DerivedKey encodedPayloadKey;
+    /// Whether the keys are locked against swapping; locking fails beyond RLIMIT_MEMLOCK
+    bool locked = false;
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Memory locks are not counted: the keys get pages of their own, so that unlocking them does not unlock the
+    // secrets of another session sharing the page.
+    static void* operator new(std::size_t size) {
+        void* memory = mmap(nullptr, roundUpToPageSize(size), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    static void operator delete(void* memory, std::size_t size) {
+        munmap(memory, roundUpToPageSize(size));
+    }
+#endif
+
+    Secrets() {
+#if defined(__unix__) || defined(__APPLE__)
+        locked = mlock(this, sizeof(*this)) == 0;
+#endif
+    }
+
+    Secrets(const Secrets&) = delete;
+    Secrets& operator=(const Secrets&) = delete;
+
+    ~Secrets() {
+        memzero(&payloadKey);
+        memzero(&encodedPayloadKey);
+#if defined(__unix__) || defined(__APPLE__)
+        if (locked) {
+            munlock(this, sizeof(*this));
+        }
+#endif
+    }
+};
+
+UnlockSession::UnlockSession(const StoredKey& key, const Data& password, Clock::duration lifetime)
+    : payloadMac(key.payload._mac), secrets(std::make_unique<Secrets>()) {
+    key.payload.deriveKey(password, secrets->payloadKey);
+    // checks the password against the MAC
+    auto data = key.payload.decrypt(secrets->payloadKey);
+    memzero(data.data(), data.size());
+
+    if (key.encodedPayload.has_value()) {
+        encodedPayloadMac = key.encodedPayload->_mac;
+        encodedPayloadHasOwnKey = !key.encodedPayload->hasSameKeyDerivation(key.payload);
+        if (encodedPayloadHasOwnKey) {
+            key.encodedPayload->deriveKey(password, secrets->encodedPayloadKey);
+        }
+    }
+    // the lifetime starts once unlocked, the key derivation function may take a while
+    expiry = Clock::now() + lifetime;
+}
+
+UnlockSession::~UnlockSession() {
+    lock();
+}
+
+bool UnlockSession::isExpired() const {
+    std::lock_guard guard(mutex);
+    wipeIfExpired();
+    return secrets == nullptr;
+}
+
+bool UnlockSession::isMemoryLocked() const {
+    std::lock_guard guard(mutex);
+    return secrets != nullptr && secrets->locked;
+}
+
+void UnlockSession::lock() {
+    std::lock_guard guard(mutex);
+    wipe();
+}
+
+Data UnlockSession::decrypt(const EncryptedPayload& payload) const {
+    std::lock_guard guard(mutex);
+    return payload.decrypt(derivedKey(payload));
+}
+
+std::shared_ptr<const HDWallet<>> UnlockSession::wallet(const EncryptedPayload& payload) const {
+    std::lock_guard guard(mutex);
+    const auto& key = derivedKey(payload);
+    if (payload._mac != payloadMac) {
+        // the encoded payload holds a private key
+        throw DecryptionError::invalidPassword;
+    }
+    if (cachedWallet == nullptr) {
+        auto data = payload.decrypt(key);
+        const auto mnemonic = std::string(reinterpret_cast<const char*>(data.data()), data.size());
+        memzero(data.data(), data.size());
+        cachedWallet = std::make_shared<const HDWallet<>>(mnemonic, "");
+    }
+    return cachedWallet;
+}
+
+const EncryptedPayload::DerivedKey& UnlockSession::derivedKey(const EncryptedPayload& payload) const {
+    wipeIfExpired();
+    if (secrets == nullptr) {
+        throw DecryptionError::sessionExpired;
+    }
+    if (payload._mac == payloadMac) {
+        return secrets->payloadKey;
+    }
+    if (encodedPayloadMac.has_value() && payload._mac == *encodedPayloadMac) {
+        return encodedPayloadHasOwnKey ? secrets->encodedPayloadKey : secrets->payloadKey;
+    }
+    throw DecryptionError::invalidPassword;
+}
+
+void UnlockSession::wipeIfExpired() const {
+    if (secrets != nullptr && Clock::now() >= expiry) {
+        wipe();
+    }
+}
+
+void UnlockSession::wipe() const {
+    secrets.reset();
+    cachedWallet.reset();
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "EncryptionParameters.h"
+#include "StoredKey.h"
+#include "Data.h"
+#include "../HDWallet.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace TW::Keystore {
+
+/// A `StoredKey` unlocked with its password for a limited time.
+///
+/// The session keeps the keys derived from the password, so that the stored key can be decrypted again without
+/// rerunning the key derivation function (scrypt or PBKDF2), and the HD wallet of a mnemonic once it is first used.
+/// Derived keys are kept in memory locked against swapping where the platform allows it. They are wiped on `lock()`,
+/// on destruction, and on the first use or `isExpired()` check after the session has expired.
+/// The session is neither copyable nor movable, and can be used from several threads.
+class UnlockSession {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Unlocks `key` with `password`, running the key derivation function once. The session lasts `lifetime` from then.
+    ///
+    /// \throws DecryptionError::invalidPassword if the password is incorrect.
+    UnlockSession(const StoredKey& key, const Data& password, Clock::duration lifetime);
+
+    UnlockSession(const UnlockSession&) = delete;
+    UnlockSession& operator=(const UnlockSession&) = delete;
+
+    ~UnlockSession();
+
+    /// Whether the session has expired or has been locked; the derived keys and the wallet are wiped once expired.
+    bool isExpired() const;
+
+    /// Whether the derived keys are locked in memory against swapping. Locking is best effort: it is not supported on
+    /// every platform, and fails beyond the limit of locked memory of the process (RLIMIT_MEMLOCK).
+    bool isMemoryLocked() const;
+
+    /// Wipes the derived keys and the wallet, ending the session before it expires.
+    void lock();
+
+    /// Decrypts a payload of the unlocked key.
+    ///
+    /// \throws DecryptionError::sessionExpired if the session has expired.
+    /// \throws DecryptionError::invalidPassword if the payload is not one of the unlocked key.
+    Data decrypt(const EncryptedPayload& payload) const;
+
+    /// Returns the HD wallet of the mnemonic in `payload`, created on first use.
+    /// The wallet stays valid after the session expires, until it is released.
+    ///
+    /// \throws DecryptionError::sessionExpired if the session has expired.
+    /// \throws DecryptionError::invalidPassword if the payload is not one of the unlocked key.
+    std::shared_ptr<const HDWallet<>> wallet(const EncryptedPayload& payload) const;
+
+private:
+    struct Secrets;
+
+    /// Returns the derived key for `payload`; the mutex must be held.
+    const EncryptedPayload::DerivedKey& derivedKey(const EncryptedPayload& payload) const;
+
+    /// Wipes the derived keys and releases the wallet if the session has expired; the mutex must be held.
+    void wipeIfExpired() const;
+
+    /// Wipes the derived keys and releases the wallet; the mutex must be held.
+    void wipe() const;
+
+    mutable std::mutex mutex;
+    Clock::time_point expiry;
+    /// MACs identifying the payloads of the unlocked key
+    Data payloadMac;
+    std::optional<Data> encodedPayloadMac;
+    /// Whether the encoded payload derives its own key, instead of the same one as the payload
+    bool encodedPayloadHasOwnKey = false;
+    mutable std::unique_ptr<Secrets> secrets;
+    mutable std::shared_ptr<const HDWallet<>> cachedWallet;
+};
+
+} // namespace TW::Keystore
+
+/// Wrapper for C interface.
+struct TWStoredKeyUnlockSession {
+    TW::Keystore::UnlockSession impl;
+};
@@ -4,6 +4,7 @@
 // Copyright © 2017 Trust Wallet.
 
 #include "Signer.h"
+#include "Work.h"
 #include "../BinaryCoding.h"
 #include "../HexCoding.h"
 #include "../uint256.h"
@@ -128,8 +129,13 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     try {
         auto signer = Signer(input);
         output = signer.build();
+    } catch (const std::exception& e) {
+        // e.g. invalid input, or the work generation timing out
+        output.set_error(Common::Proto::Error_general);
+        output.set_error_message(e.what());
+    } catch (...) {
+        output.set_error(Common::Proto::Error_general);
     }
-    catch (...) {}
     return output;
 }
 
@@ -150,9 +156,30 @@ std::array<byte, 64> Signer::sign() const noexcept {
     return signature;
 }
 
+std::string Signer::work() const {
+    if (!input.work().empty() || input.work_threshold() == 0) {
+        return input.work();
+    }
+    // the root is the previous block, or the account for an open block
+    auto root = previous;
+    if (std::all_of(root.begin(), root.end(), [](auto b) { return b == 0; })) {
+        std::copy_n(publicKey.bytes.begin(), root.size(), root.begin());
+    }
+    WorkOptions options;
+    options.timeout = std::chrono::milliseconds(input.work_timeout_ms());
+    const auto work = generateWork(root, input.work_threshold(), options);
+    if (!work.has_value()) {
+        throw std::runtime_error("Work generation timed out");
+    }
+    Data bytes;
+    encode64BE(*work, bytes);
+    return hex(bytes);
+}
+
 Proto::SigningOutput Signer::build() const {
     auto output = Proto::SigningOutput();
     const auto signature = sign();
+    const auto work = this->work();
     output.set_signature(signature.data(), signature.size());
     output.set_block_hash(blockHash.data(), blockHash.size());
 
@@ -168,8 +195,8 @@ Proto::SigningOutput Signer::build() const {
         {"signature", hex(signature)},
     };
 
-    if (input.work().size() > 0) {
-        json["work"] = input.work();
+    if (work.size() > 0) {
+        json["work"] = work;
     }
 
     output.set_json(json.dump());
@@ -31,6 +31,11 @@ public:
     /// Signs the blockHash, returns signature bytes
     std::array<byte, 64> sign() const noexcept;
 
+    /// Returns the work of the block: the input one, or one generated against `work_threshold` when it is missing.
+    ///
+    /// \throws std::runtime_error if the generation times out.
+    std::string work() const;
+
     /// Builds signed transaction, incl. signature, and json format
     Proto::SigningOutput build() const;
 
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Work.h"
+
+#include <TrezorCrypto/rand.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TW_NANO_WORK_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace TW::Nano {
+
+namespace {
+
+// The hashed message is a single 40-byte block: the work in word 0 and the root in words 1 to 4, the other words are
+// zero. The hash is 8 bytes long, so only the first word of the state is computed.
+
+constexpr std::size_t kMessageSize = 40;
+constexpr std::size_t kHashSize = 8;
+
+constexpr std::array<uint64_t, 8> kIV = {
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179,
+};
+
+constexpr uint8_t kSigma[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+};
+
+/// First state word: IV with the parameter block of an unkeyed 8-byte hash.
+constexpr uint64_t kH0 = kIV[0] ^ 0x01010000 ^ kHashSize;
+
+using RootWords = std::array<uint64_t, 4>;
+
+RootWords rootWords(const std::array<byte, 32>& root) {
+    RootWords words{};
+    for (std::size_t i = 0; i < root.size(); ++i) {
+        words[i / 8] |= uint64_t(root[i]) << (8 * (i % 8));
+    }
+    return words;
+}
+
+inline uint64_t rotr64(uint64_t x, int n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+uint64_t workHash(uint64_t work, const RootWords& root) {
+    std::array<uint64_t, 16> m = {work, root[0], root[1], root[2], root[3]};
+    std::array<uint64_t, 16> v = {
+        kH0, kIV[1], kIV[2], kIV[3], kIV[4], kIV[5], kIV[6], kIV[7],
+        kIV[0], kIV[1], kIV[2], kIV[3], kIV[4] ^ kMessageSize, kIV[5], ~kIV[6], kIV[7],
+    };
+    const auto g = [&](const uint8_t* s, int i, int a, int b, int c, int d) {
+        v[a] = v[a] + v[b] + m[s[2 * i]];
+        v[d] = rotr64(v[d] ^ v[a], 32);
+        v[c] = v[c] + v[d];
+        v[b] = rotr64(v[b] ^ v[c], 24);
+        v[a] = v[a] + v[b] + m[s[2 * i + 1]];
+        v[d] = rotr64(v[d] ^ v[a], 16);
+        v[c] = v[c] + v[d];
+        v[b] = rotr64(v[b] ^ v[c], 63);
+    };
+    for (const auto* s : kSigma) {
+        g(s, 0, 0, 4, 8, 12);
+        g(s, 1, 1, 5, 9, 13);
+        g(s, 2, 2, 6, 10, 14);
+        g(s, 3, 3, 7, 11, 15);
+        g(s, 4, 0, 5, 10, 15);
+        g(s, 5, 1, 6, 11, 12);
+        g(s, 6, 2, 7, 8, 13);
+        g(s, 7, 3, 4, 9, 14);
+    }
+    return kH0 ^ v[0] ^ v[8];
+}
+
+/// Number of nonces a thread claims at once; the stop conditions are checked between chunks.
+constexpr uint64_t kChunkSize = 1 << 12;
+
+#ifdef TW_NANO_WORK_AVX2
+
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+    return supported;
+}
+
+template <int N>
+__attribute__((target("avx2"))) inline __m256i rotr64x4(__m256i x) {
+    return _mm256_or_si256(_mm256_srli_epi64(x, N), _mm256_slli_epi64(x, 64 - N));
+}
+
+__attribute__((target("avx2"))) inline void g4(__m256i* v, const __m256i* m, const uint8_t* s, int i, int a, int b, int c, int d) {
+    v[a] = _mm256_add_epi64(_mm256_add_epi64(v[a], v[b]), m[s[2 * i]]);
+    v[d] = _mm256_shuffle_epi32(_mm256_xor_si256(v[d], v[a]), 0xb1);
+    v[c] = _mm256_add_epi64(v[c], v[d]);
+    v[b] = rotr64x4<24>(_mm256_xor_si256(v[b], v[c]));
+    v[a] = _mm256_add_epi64(_mm256_add_epi64(v[a], v[b]), m[s[2 * i + 1]]);
+    v[d] = rotr64x4<16>(_mm256_xor_si256(v[d], v[a]));
+    v[c] = _mm256_add_epi64(v[c], v[d]);
+    v[b] = rotr64x4<63>(_mm256_xor_si256(v[b], v[c]));
+}
+
+__attribute__((target("avx2"))) inline __m256i set4(uint64_t value) {
+    return _mm256_set1_epi64x(static_cast<long long>(value));
+}
+
+/// Hashes the works `first` to `first + 3`, one per 64-bit lane.
+__attribute__((target("avx2"))) void workHashAvx2(uint64_t first, const RootWords& root, std::array<uint64_t, 4>& out) {
+    const auto zero = _mm256_setzero_si256();
+    const __m256i m[16] = {
+        _mm256_add_epi64(set4(first), _mm256_set_epi64x(3, 2, 1, 0)),
+        set4(root[0]), set4(root[1]), set4(root[2]), set4(root[3]),
+        zero, zero, zero, zero, zero, zero, zero, zero, zero, zero, zero,
+    };
+    __m256i v[16] = {
+        set4(kH0), set4(kIV[1]), set4(kIV[2]), set4(kIV[3]), set4(kIV[4]), set4(kIV[5]), set4(kIV[6]), set4(kIV[7]),
+        set4(kIV[0]), set4(kIV[1]), set4(kIV[2]), set4(kIV[3]), set4(kIV[4] ^ kMessageSize), set4(kIV[5]), set4(~kIV[6]), set4(kIV[7]),
+    };
+    for (const auto* s : kSigma) {
+        g4(v, m, s, 0, 0, 4, 8, 12);
+        g4(v, m, s, 1, 1, 5, 9, 13);
+        g4(v, m, s, 2, 2, 6, 10, 14);
+        g4(v, m, s, 3, 3, 7, 11, 15);
+        g4(v, m, s, 4, 0, 5, 10, 15);
+        g4(v, m, s, 5, 1, 6, 11, 12);
+        g4(v, m, s, 6, 2, 7, 8, 13);
+        g4(v, m, s, 7, 3, 4, 9, 14);
+    }
+    const auto hash = _mm256_xor_si256(_mm256_xor_si256(set4(kH0), v[0]), v[8]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.data()), hash);
+}
+
+/// Searches the chunk of nonces starting at `first`, four at a time.
+__attribute__((target("avx2"))) std::optional<uint64_t> searchChunkAvx2(uint64_t first, const RootWords& root, uint64_t threshold) {
+    std::array<uint64_t, 4> hashes;
+    for (uint64_t offset = 0; offset < kChunkSize; offset += hashes.size()) {
+        workHashAvx2(first + offset, root, hashes);
+        for (std::size_t lane = 0; lane < hashes.size(); ++lane) {
+            if (hashes[lane] >= threshold) {
+                return first + offset + lane;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+#endif
+
+/// Searches the chunk of nonces starting at `first`.
+std::optional<uint64_t> searchChunk(uint64_t first, const RootWords& root, uint64_t threshold) {
+#ifdef TW_NANO_WORK_AVX2
+    if (hasAvx2()) {
+        return searchChunkAvx2(first, root, threshold);
+    }
+#endif
+    for (uint64_t offset = 0; offset < kChunkSize; ++offset) {
+        if (workHash(first + offset, root) >= threshold) {
+            return first + offset;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+uint64_t workDifficulty(uint64_t work, const std::array<byte, 32>& root) {
+    return workHash(work, rootWords(root));
+}
+
+std::optional<uint64_t> generateWork(const std::array<byte, 32>& root, uint64_t threshold, const WorkOptions& options) {
+    const auto words = rootWords(root);
+    auto threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const auto deadline = std::chrono::steady_clock::now() + options.timeout;
+
+    // a random start, so that concurrent searches for the same root do not repeat each other
+    uint64_t start = 0;
+    random_buffer(reinterpret_cast<uint8_t*>(&start), sizeof(start));
+    std::atomic<uint64_t> next = start;
+    std::atomic<bool> done = false;
+    std::optional<uint64_t> result;
+
+    const auto search = [&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            if ((options.cancel != nullptr && options.cancel->load(std::memory_order_relaxed)) ||
+                (options.timeout.count() > 0 && std::chrono::steady_clock::now() >= deadline)) {
+                done = true;
+                break;
+            }
+            const auto first = next.fetch_add(kChunkSize, std::memory_order_relaxed);
+            if (const auto work = searchChunk(first, words, threshold); work.has_value()) {
+                if (!done.exchange(true)) {
+                    result = work;
+                }
+                break;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(search);
+    }
+    search();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return result;
+}
+
+} // namespace TW::Nano
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "Data.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace TW::Nano {
+
+/// Work difficulty thresholds of epoch 2 blocks.
+constexpr uint64_t kSendWorkThreshold = 0xfffffff800000000;
+constexpr uint64_t kReceiveWorkThreshold = 0xfffffe0000000000;
+
+/// Returns the difficulty of `work` for `root`: the 8-byte Blake2b hash of the little-endian work followed by the root,
+/// as a little-endian integer. The work is valid when its difficulty is at least the threshold.
+uint64_t workDifficulty(uint64_t work, const std::array<byte, 32>& root);
+
+/// Options of a work search.
+struct WorkOptions {
+    /// Number of threads searching, 0 for the hardware concurrency.
+    std::size_t threads = 0;
+    /// Time after which the search gives up, 0 for no limit.
+    std::chrono::milliseconds timeout{0};
+    /// When set, the search gives up once it becomes true.
+    const std::atomic<bool>* cancel = nullptr;
+};
+
+/// Searches a work value for `root` (the previous block hash, or the account public key for an open block) with a
+/// difficulty of at least `threshold`.
+///
+/// Threads claim chunks of nonces from a shared counter starting at a random nonce, and stop as soon as one finds a
+/// valid work. Nonces are hashed four at a time with AVX2 where the CPU supports it.
+///
+/// \returns the work, or nothing if the search timed out or was cancelled.
+std::optional<uint64_t> generateWork(const std::array<byte, 32>& root, uint64_t threshold, const WorkOptions& options = {});
+
+} // namespace TW::Nano
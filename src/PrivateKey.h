@@ -115,6 +115,8 @@ class PrivateKey {
     /// Cleanup contents (fill with 0s), called before destruction
     void cleanup();
 private:
+    friend class SigningContext;
+
     std::optional<TWCurve> _curve = std::nullopt;
 };
 
@@ -213,12 +213,35 @@ bool PublicKey::verifyZilliqa(const Data& signature, const Data& message) const
 
 Data PublicKey::hash(const Data& prefix, Hash::Hasher hasher, bool skipTypeByte) const {
     const auto offset = std::size_t(skipTypeByte ? 1 : 0);
-    const auto hash = Hash::hash(hasher, bytes.data() + offset, bytes.size() - offset);
+    Hash::Digest<Hash::maxHashSize> hash;
+    const auto hashSize = Hash::hash(hasher, bytes.data() + offset, bytes.size() - offset, hash);
 
     auto result = Data();
-    result.reserve(prefix.size() + hash.size());
+    result.reserve(prefix.size() + hashSize);
     append(result, prefix);
-    append(result, hash);
+    result.insert(result.end(), hash.begin(), hash.begin() + hashSize);
+    return result;
+}
+
+std::vector<Data> PublicKey::hashes(const std::vector<PublicKey>& publicKeys, const Data& prefix, Hash::Hasher hasher, bool skipTypeByte) {
+    const auto offset = std::size_t(skipTypeByte ? 1 : 0);
+    std::vector<std::span<const byte>> inputs;
+    inputs.reserve(publicKeys.size());
+    for (const auto& publicKey : publicKeys) {
+        inputs.emplace_back(publicKey.bytes.data() + offset, publicKey.bytes.size() - offset);
+    }
+    const auto hashSize = Hash::hashSize(hasher);
+    Data digests(publicKeys.size() * hashSize);
+    Hash::batch(hasher, inputs, digests);
+
+    std::vector<Data> result;
+    result.reserve(publicKeys.size());
+    for (auto i = 0ul; i < publicKeys.size(); ++i) {
+        auto& keyHash = result.emplace_back();
+        keyHash.reserve(prefix.size() + hashSize);
+        append(keyHash, prefix);
+        keyHash.insert(keyHash.end(), digests.begin() + i * hashSize, digests.begin() + (i + 1) * hashSize);
+    }
     return result;
 }
 
@@ -10,6 +10,8 @@
 #include <TrustWalletCore/TWPublicKeyType.h>
 
 #include <cassert>
+#include <optional>
+#include <span>
 #include <stdexcept>
 
 namespace TW {
@@ -81,6 +83,11 @@ class PublicKey {
     /// bytes and then prepending the prefix.
     Data hash(const Data& prefix, Hash::Hasher hasher = Hash::HasherSha256ripemd, bool skipTypeByte = false) const;
 
+    /// Computes the public key hashes of many keys at once, see `hash`.
+    /// Uses `Hash::batch`, so SHA256 and Keccak256 based hashers process several keys in parallel.
+    static std::vector<Data> hashes(const std::vector<PublicKey>& publicKeys, const Data& prefix,
+                                    Hash::Hasher hasher = Hash::HasherSha256ripemd, bool skipTypeByte = false);
+
     /// Recover public key (SECP256k1Extended) from signature R, S, V values
     /// signatureRS: 2x32 bytes with the R and S values
     /// recId: the recovery ID, a.k.a. V value, 0 <= v < 4
@@ -95,6 +102,21 @@ class PublicKey {
     /// Naming is kept for backwards compatibility.
     static PublicKey recover(const Data& signature, const Data& messageDigest);
 
+    /// Verifies many signatures at once, entry `i` checking `signatures[i]` over `messageDigests[i]` with `publicKeys[i]`.
+    /// Gives the same result as `verify` (or `verifyAsDER` if `asDER` is set) for every entry, signatures shorter than 64 bytes
+    /// and digests shorter than 32 bytes are rejected.
+    /// SECP256k1 and NIST256p1 entries share a single scalar inversion per curve, other key types are verified one by one.
+    /// The batch is split over `threads` threads; 0 uses one thread per core.
+    /// Throws if the spans have different sizes.
+    static std::vector<bool> verifyBatch(std::span<const PublicKey> publicKeys, std::span<const Data> signatures,
+                                         std::span<const Data> messageDigests, bool asDER = false, std::size_t threads = 1);
+
+    /// Recovers many public keys (SECP256k1Extended) at once, see `recover`; entries that cannot be recovered are empty.
+    /// The `r` inversions are shared across the batch, which is split over `threads` threads; 0 uses one thread per core.
+    /// Throws if the spans have different sizes.
+    static std::vector<std::optional<PublicKey>> recoverBatch(std::span<const Data> signatures, std::span<const Data> messageDigests,
+                                                              std::size_t threads = 1);
+
     /// Check if this key makes a valid ED25519 key (it is on the curve)
     bool isValidED25519() const;
 };
@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "PublicKey.h"
+#include "memory/memzero_wrapper.h"
+
+#include <TrezorCrypto/bignum.h>
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+/// Size of an (r, s) signature and of a message digest.
+constexpr std::size_t rsSize = 64;
+constexpr std::size_t digestSize = 32;
+
+/// Do not spawn a thread for fewer entries than this.
+constexpr std::size_t minEntriesPerThread = 16;
+
+/// One ECDSA equation of a batch, `scalar` is the value to invert (s for verification, r for recovery).
+struct Equation {
+    std::size_t index;
+    const ecdsa_curve* curve;
+    bignum256 r;
+    bignum256 scalar;
+    bignum256 digest;
+    curve_point point;
+};
+
+/// Replaces the scalar of every equation by its inverse modulo the curve order, with a single inversion for the whole batch
+/// (Montgomery's trick). All equations must be on `curve`, with nonzero scalars.
+void invertScalars(std::vector<Equation*>& equations, const ecdsa_curve* curve) {
+    if (equations.empty()) {
+        return;
+    }
+    const auto* order = &curve->order;
+    std::vector<bignum256> prefix(equations.size());
+    prefix[0] = equations[0]->scalar;
+    for (std::size_t i = 1; i < equations.size(); ++i) {
+        prefix[i] = prefix[i - 1];
+        bn_multiply(&equations[i]->scalar, &prefix[i], order);
+        bn_mod(&prefix[i], order);
+    }
+
+    auto inverse = prefix.back();
+    bn_inverse(&inverse, order);
+    for (auto i = equations.size() - 1; i > 0; --i) {
+        auto scalarInverse = prefix[i - 1];
+        bn_multiply(&inverse, &scalarInverse, order);
+        bn_mod(&scalarInverse, order);
+        bn_multiply(&equations[i]->scalar, &inverse, order);
+        bn_mod(&inverse, order);
+        equations[i]->scalar = scalarInverse;
+    }
+    equations[0]->scalar = inverse;
+    memzero(&inverse);
+}
+
+/// Inverts the scalars of all equations, one batch per curve.
+void invertScalars(std::vector<Equation>& equations) {
+    for (const auto* curve : {&secp256k1, &nist256p1}) {
+        std::vector<Equation*> onCurve;
+        for (auto& equation : equations) {
+            if (equation.curve == curve) {
+                onCurve.push_back(&equation);
+            }
+        }
+        invertScalars(onCurve, curve);
+    }
+}
+
+/// Reads r and the scalar s from an (r, s) signature and the digest, with the range checks of `ecdsa_verify_digest` and
+/// `ecdsa_recover_pub_from_sig`.
+bool readSignature(const byte* signature, const byte* digest, const ecdsa_curve* curve, Equation& equation) {
+    bn_read_be(signature, &equation.r);
+    bn_read_be(signature + 32, &equation.scalar);
+    bn_read_be(digest, &equation.digest);
+    return !bn_is_zero(&equation.r) && !bn_is_zero(&equation.scalar) && bn_is_less(&equation.r, &curve->order) &&
+           bn_is_less(&equation.scalar, &curve->order);
+}
+
+/// Runs `function(begin, end)` over consecutive chunks of `[0, count)`, concurrently when `threads` allows it.
+template <typename Function>
+void forEachChunk(std::size_t count, std::size_t threads, Function function) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<std::size_t>(1, std::min(threads, count / minEntriesPerThread));
+    if (threads == 1) {
+        function(std::size_t(0), count);
+        return;
+    }
+    const auto chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (std::size_t begin = 0; begin < count; begin += chunk) {
+        workers.emplace_back(function, begin, std::min(count, begin + chunk));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+const ecdsa_curve* ecdsaCurve(TWPublicKeyType type) {
+    switch (type) {
+    case TWPublicKeyTypeSECP256k1:
+    case TWPublicKeyTypeSECP256k1Extended:
+        return &secp256k1;
+    case TWPublicKeyTypeNIST256p1:
+    case TWPublicKeyTypeNIST256p1Extended:
+        return &nist256p1;
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace
+
+std::vector<bool> PublicKey::verifyBatch(std::span<const PublicKey> publicKeys, std::span<const Data> signatures,
+                                         std::span<const Data> messageDigests, bool asDER, std::size_t threads) {
+    if (publicKeys.size() != signatures.size() || publicKeys.size() != messageDigests.size()) {
+        throw std::invalid_argument("Mismatched batch sizes");
+    }
+    // not a vector<bool>, chunks are written concurrently
+    std::vector<char> results(publicKeys.size(), 0);
+
+    forEachChunk(publicKeys.size(), threads, [&](std::size_t begin, std::size_t end) {
+        std::vector<Equation> equations;
+        equations.reserve(end - begin);
+        for (auto i = begin; i < end; ++i) {
+            const auto& publicKey = publicKeys[i];
+            const auto& signature = signatures[i];
+            const auto& digest = messageDigests[i];
+            const auto* curve = ecdsaCurve(publicKey.type);
+            if (curve == nullptr || (asDER && curve != &secp256k1)) {
+                try {
+                    results[i] = asDER ? publicKey.verifyAsDER(signature, digest) : publicKey.verify(signature, digest);
+                } catch (...) {
+                    results[i] = false;
+                }
+                continue;
+            }
+
+            std::array<byte, rsSize> rs;
+            if (asDER) {
+                if (ecdsa_sig_from_der(signature.data(), signature.size(), rs.data()) != 0) {
+                    continue;
+                }
+            } else if (signature.size() >= rsSize) {
+                std::copy(signature.begin(), signature.begin() + rsSize, rs.begin());
+            } else {
+                continue;
+            }
+            if (digest.size() < digestSize) {
+                continue;
+            }
+
+            Equation equation{i, curve};
+            if (!ecdsa_read_pubkey(curve, publicKey.bytes.data(), &equation.point) ||
+                !readSignature(rs.data(), digest.data(), curve, equation) || bn_is_zero(&equation.digest)) {
+                continue;
+            }
+            equations.push_back(equation);
+        }
+
+        invertScalars(equations);
+
+        for (auto& equation : equations) {
+            const auto* curve = equation.curve;
+            // u1 = z * s^-1, u2 = r * s^-1, R = u1 * G + u2 * Q
+            auto& u1 = equation.digest;
+            bn_multiply(&equation.scalar, &u1, &curve->order);
+            bn_mod(&u1, &curve->order);
+            auto& u2 = equation.scalar;
+            bn_multiply(&equation.r, &u2, &curve->order);
+            bn_mod(&u2, &curve->order);
+
+            curve_point result;
+            scalar_multiply(curve, &u1, &result);
+            point_multiply(curve, &u2, &equation.point, &equation.point);
+            point_add(curve, &equation.point, &result);
+            if (point_is_infinity(&result)) {
+                continue;
+            }
+            bn_mod(&result.x, &curve->order);
+            results[equation.index] = bn_is_equal(&result.x, &equation.r);
+        }
+    });
+
+    return {results.begin(), results.end()};
+}
+
+std::vector<std::optional<PublicKey>> PublicKey::recoverBatch(std::span<const Data> signatures, std::span<const Data> messageDigests,
+                                                              std::size_t threads) {
+    if (signatures.size() != messageDigests.size()) {
+        throw std::invalid_argument("Mismatched batch sizes");
+    }
+    std::vector<std::optional<PublicKey>> results(signatures.size());
+
+    forEachChunk(signatures.size(), threads, [&](std::size_t begin, std::size_t end) {
+        const auto* curve = &secp256k1;
+        std::vector<Equation> equations;
+        equations.reserve(end - begin);
+        for (auto i = begin; i < end; ++i) {
+            const auto& signature = signatures[i];
+            const auto& digest = messageDigests[i];
+            if (signature.size() < secp256k1SignatureSize || digest.size() < digestSize) {
+                continue;
+            }
+            auto recId = signature[secp256k1SignatureSize - 1];
+            // same V handling as `recover`
+            if (recId >= PublicKey::SignatureVOffset) {
+                recId = !(recId & 0x01);
+            }
+            if (recId >= 4) {
+                continue;
+            }
+
+            Equation equation{i, curve};
+            if (!readSignature(signature.data(), digest.data(), curve, equation)) {
+                continue;
+            }
+            // R = k * G, recovered from its x coordinate
+            auto& point = equation.point;
+            point.x = equation.r;
+            if ((recId & 2) != 0) {
+                bn_add(&point.x, &curve->order);
+                if (!bn_is_less(&point.x, &curve->prime)) {
+                    continue;
+                }
+            }
+            // r is the scalar to invert for recovery, keep s in place of r
+            std::swap(equation.r, equation.scalar);
+            uncompress_coords(curve, recId & 1, &point.x, &point.y);
+            if (!ecdsa_validate_pubkey(curve, &point)) {
+                continue;
+            }
+            equations.push_back(equation);
+        }
+
+        invertScalars(equations);
+
+        for (auto& equation : equations) {
+            // e = -digest * r^-1, s = s * r^-1, Q = s * R + e * G
+            auto& e = equation.digest;
+            bn_mod(&e, &curve->order);
+            bn_subtract(&curve->order, &e, &e);
+            bn_multiply(&equation.scalar, &e, &curve->order);
+            bn_mod(&e, &curve->order);
+            auto& s = equation.r;
+            bn_multiply(&equation.scalar, &s, &curve->order);
+            bn_mod(&s, &curve->order);
+
+            // e is 0 when the digest is 0 mod n, then scalar_multiply leaves the point untouched
+            curve_point generatorPart = {0};
+            point_multiply(curve, &s, &equation.point, &equation.point);
+            scalar_multiply(curve, &e, &generatorPart);
+            point_add(curve, &generatorPart, &equation.point);
+            if (point_is_infinity(&equation.point)) {
+                continue;
+            }
+            Data bytes(secp256k1SignatureSize);
+            bytes[0] = 0x04;
+            bn_write_be(&equation.point.x, bytes.data() + 1);
+            bn_write_be(&equation.point.y, bytes.data() + 33);
+            results[equation.index] = PublicKey(bytes, TWPublicKeyTypeSECP256k1Extended);
+        }
+    });
+
+    return results;
+}
+
+} // namespace TW
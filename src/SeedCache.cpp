@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "SeedCache.h"
+
+#include "HashContext.h"
+#include "memory/memzero_wrapper.h"
+
+#include <TrezorCrypto/bip39.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace TW {
+
+namespace {
+
+/// Maximum passphrase length used by `mnemonic_to_seed`.
+constexpr std::size_t maxPassphraseLength = 256;
+
+} // namespace
+
+SeedCache& SeedCache::shared() {
+    static SeedCache cache;
+    return cache;
+}
+
+void SeedCache::mnemonicToSeed(const std::string& mnemonic, const std::string& passphrase, std::span<byte, seedSize> seed) {
+    if (capacity == 0) {
+        mnemonic_to_seed(mnemonic.c_str(), passphrase.c_str(), seed.data(), nullptr);
+        return;
+    }
+
+    // key on the strings as seen by mnemonic_to_seed; a mnemonic has no NUL, so the separator is unambiguous
+    const auto* mnemonicChars = mnemonic.c_str();
+    const auto* passphraseChars = passphrase.c_str();
+    Key key;
+    Hash::Sha256Context()
+        .update(reinterpret_cast<const byte*>(mnemonicChars), std::strlen(mnemonicChars))
+        .update(reinterpret_cast<const byte*>("\0"), 1)
+        .update(reinterpret_cast<const byte*>(passphraseChars), strnlen(passphraseChars, maxPassphraseLength))
+        .final(key);
+
+    if (!find(key, seed)) {
+        mnemonic_to_seed(mnemonicChars, passphraseChars, seed.data(), nullptr);
+        insert(key, seed);
+    }
+    memzero(&key);
+}
+
+bool SeedCache::find(const Key& key, std::span<byte, seedSize> seed) {
+    auto& shard = shardOf(key);
+    std::lock_guard lock(shard.mutex);
+    auto found = shard.index.find(key);
+    if (found == shard.index.end()) {
+        return false;
+    }
+    shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+    std::copy(found->second->seed.begin(), found->second->seed.end(), seed.begin());
+    return true;
+}
+
+void SeedCache::insert(const Key& key, std::span<const byte, seedSize> seed) {
+    const auto maxEntries = shardCapacity();
+    if (maxEntries == 0) {
+        return;
+    }
+    auto& shard = shardOf(key);
+    std::lock_guard lock(shard.mutex);
+    if (shard.index.find(key) != shard.index.end()) {
+        // computed concurrently by another thread, result is the same
+        return;
+    }
+    trim(shard, maxEntries - 1);
+    shard.entries.push_front(Entry{key, {}});
+    std::copy(seed.begin(), seed.end(), shard.entries.front().seed.begin());
+    shard.index.emplace(key, shard.entries.begin());
+}
+
+void SeedCache::setCapacity(std::size_t newCapacity) {
+    capacity = newCapacity;
+    const auto maxEntries = shardCapacity();
+    for (auto& shard : shards) {
+        std::lock_guard lock(shard.mutex);
+        trim(shard, maxEntries);
+    }
+}
+
+void SeedCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard lock(shard.mutex);
+        trim(shard, 0);
+    }
+}
+
+std::size_t SeedCache::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard lock(shard.mutex);
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+void SeedCache::trim(Shard& shard, std::size_t maxEntries) {
+    while (shard.entries.size() > maxEntries) {
+        auto last = std::prev(shard.entries.end());
+        shard.index.erase(last->key);
+        memzero(&last->key);
+        memzero(&last->seed);
+        shard.entries.erase(last);
+    }
+}
+
+} // namespace TW
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "Data.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+
+namespace TW {
+
+/// Thread-safe, bounded LRU cache of BIP39 seeds, keyed by mnemonic and passphrase.
+/// Replaces the unsynchronized global cache of trezor-crypto `mnemonic_to_seed` (built with `USE_BIP39_CACHE` off),
+/// so that wallets can be created from many threads without paying the 2048-round PBKDF2 for every one.
+///
+/// Entries are spread over independently locked shards; a shard is locked only to look up or store a seed,
+/// never while computing one. Entries are keyed by a SHA-256 digest, the mnemonic itself is not stored.
+/// Cached seeds and keys are zeroized on eviction, on `clear()` and on destruction.
+class SeedCache {
+public:
+    static constexpr std::size_t seedSize = 64;
+    static constexpr std::size_t defaultCapacity = 16;
+    static constexpr std::size_t shardCount = 8;
+
+    using Seed = std::array<byte, seedSize>;
+
+    explicit SeedCache(std::size_t capacity = defaultCapacity) : capacity(capacity) {}
+
+    SeedCache(const SeedCache&) = delete;
+    SeedCache& operator=(const SeedCache&) = delete;
+
+    ~SeedCache() { clear(); }
+
+    /// The cache used by HDWallet.
+    static SeedCache& shared();
+
+    /// Writes the BIP39 seed of the mnemonic and passphrase into `seed`, computing it on a cache miss.
+    /// As with trezor-crypto `mnemonic_to_seed`, the passphrase is truncated to 256 characters.
+    void mnemonicToSeed(const std::string& mnemonic, const std::string& passphrase, std::span<byte, seedSize> seed);
+
+    /// Changes the maximum number of cached seeds, evicting the least recently used ones if needed.
+    /// A capacity of 0 disables caching.
+    void setCapacity(std::size_t newCapacity);
+
+    /// Removes and zeroizes all cached seeds.
+    void clear();
+
+    /// Number of cached seeds.
+    std::size_t size() const;
+
+    /// Maximum number of cached seeds. Each shard holds its share rounded up, so `size()` may exceed it
+    /// by less than `shardCount`.
+    std::size_t maxSize() const { return capacity; }
+
+private:
+    using Key = std::array<byte, 32>;
+
+    struct Entry {
+        Key key;
+        Seed seed;
+    };
+
+    using Entries = std::list<Entry>;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        /// Most recently used first
+        Entries entries;
+        std::map<Key, Entries::iterator> index;
+    };
+
+    bool find(const Key& key, std::span<byte, seedSize> seed);
+    void insert(const Key& key, std::span<const byte, seedSize> seed);
+    Shard& shardOf(const Key& key) { return shards[key[0] % shardCount]; }
+    std::size_t shardCapacity() const { return (capacity + shardCount - 1) / shardCount; }
+
+    /// Evicts entries beyond `maxEntries`; the shard lock must be held.
+    static void trim(Shard& shard, std::size_t maxEntries);
+
+    std::atomic<std::size_t> capacity;
+    std::array<Shard, shardCount> shards;
+};
+
+} // namespace TW
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "SigningContext.h"
+
+#include "Hash.h"
+#include "memory/memzero_wrapper.h"
+
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
+#include <TrezorCrypto/ed25519.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/secp256k1.h>
+#include <TrezorCrypto/sodium/keypair.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace TW {
+
+namespace {
+
+/// Hashes the secret into its ed25519 expanded form: the clamped scalar followed by the nonce prefix.
+template <typename Function>
+void expandSecret(const Data& key, std::array<byte, 32>& scalar, std::array<byte, 32>& prefix, Function hash) {
+    Hash::Digest<64> expanded;
+    hash(key.data(), PrivateKey::_size, expanded);
+    expanded[0] &= 248;
+    expanded[31] &= 127;
+    expanded[31] |= 64;
+    std::copy(expanded.begin(), expanded.begin() + 32, scalar.begin());
+    std::copy(expanded.begin() + 32, expanded.end(), prefix.begin());
+    memzero(&expanded);
+}
+
+} // namespace
+
+TWCurve SigningContext::checkedCurve(const PrivateKey& privateKey, TWCurve curve) {
+    if (privateKey._curve.has_value() && privateKey._curve.value() != curve) {
+        throw std::invalid_argument("Specified curve is different from the curve of the private key");
+    }
+    return curve;
+}
+
+TWCurve SigningContext::curveOf(const PrivateKey& privateKey) {
+    if (!privateKey._curve.has_value()) {
+        throw std::invalid_argument("Curve is not set");
+    }
+    return privateKey._curve.value();
+}
+
+SigningContext::SigningContext(const PrivateKey& privateKey, TWCurve curve)
+    : _curve(checkedCurve(privateKey, curve)), secret{}, secretExtension{}, edPublicKey{}, _publicKey(prepare(privateKey)) {
+}
+
+SigningContext::SigningContext(const PrivateKey& privateKey)
+    : SigningContext(privateKey, curveOf(privateKey)) {
+}
+
+SigningContext::~SigningContext() {
+    memzero(&secret);
+    memzero(&secretExtension);
+}
+
+PublicKey SigningContext::prepare(const PrivateKey& privateKey) {
+    const auto& bytes = privateKey.bytes;
+    switch (_curve) {
+    case TWCurveSECP256k1:
+    case TWCurveNIST256p1:
+        std::copy(bytes.begin(), bytes.begin() + PrivateKey::_size, secret.begin());
+        return privateKey.getPublicKey(_curve == TWCurveSECP256k1 ? TWPublicKeyTypeSECP256k1 : TWPublicKeyTypeNIST256p1);
+
+    case TWCurveED25519:
+    case TWCurveCurve25519: {
+        expandSecret(bytes, secret, secretExtension, [](const byte* data, std::size_t size, std::span<byte, 64> out) {
+            Hash::sha512(data, size, out);
+        });
+        ed25519_publickey_ext(secret.data(), edPublicKey.data());
+        if (_curve == TWCurveED25519) {
+            return PublicKey(Data(edPublicKey.begin(), edPublicKey.end()), TWPublicKeyTypeED25519);
+        }
+        Data montgomery(PublicKey::ed25519Size);
+        ed25519_pk_to_curve25519(montgomery.data(), edPublicKey.data());
+        return PublicKey(montgomery, TWPublicKeyTypeCURVE25519);
+    }
+
+    case TWCurveED25519Blake2bNano:
+        expandSecret(bytes, secret, secretExtension, [](const byte* data, std::size_t size, std::span<byte, 64> out) {
+            Hash::blake2b(data, size, out);
+        });
+        ed25519_publickey_ext(secret.data(), edPublicKey.data());
+        return PublicKey(Data(edPublicKey.begin(), edPublicKey.end()), TWPublicKeyTypeED25519Blake2b);
+
+    case TWCurveED25519ExtendedCardano: {
+        // the key is already expanded: key + extension + chain code, twice
+        auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519Cardano);
+        std::copy(bytes.begin(), bytes.begin() + 32, secret.begin());
+        std::copy(bytes.begin() + 32, bytes.begin() + 64, secretExtension.begin());
+        std::copy(publicKey.bytes.begin(), publicKey.bytes.begin() + 32, edPublicKey.begin());
+        return publicKey;
+    }
+
+    case TWCurveStarkex:
+    case TWCurveNone:
+    default:
+        throw std::invalid_argument("Curve is not supported by SigningContext");
+    }
+}
+
+std::size_t SigningContext::signatureSize() const {
+    switch (_curve) {
+    case TWCurveSECP256k1:
+    case TWCurveNIST256p1:
+        return maxSignatureSize;
+    default:
+        return 64;
+    }
+}
+
+bool SigningContext::sign(std::span<const byte> digest, std::span<byte> out) const {
+    if (out.size() < signatureSize()) {
+        throw std::invalid_argument("Signature buffer is too small");
+    }
+    switch (_curve) {
+    case TWCurveSECP256k1:
+    case TWCurveNIST256p1: {
+        if (digest.size() < 32) {
+            return false;
+        }
+        const auto* curve = _curve == TWCurveSECP256k1 ? &secp256k1 : &nist256p1;
+        return ecdsa_sign_digest(curve, secret.data(), digest.data(), out.data(), out.data() + 64, nullptr) == 0;
+    }
+
+    case TWCurveED25519:
+    case TWCurveED25519ExtendedCardano:
+        ed25519_sign_ext_pk(digest.data(), digest.size(), secret.data(), secretExtension.data(), edPublicKey.data(), out.data());
+        return true;
+
+    case TWCurveED25519Blake2bNano:
+        ed25519_sign_ext_pk_blake2b(digest.data(), digest.size(), secret.data(), secretExtension.data(), edPublicKey.data(), out.data());
+        return true;
+
+    case TWCurveCurve25519:
+        ed25519_sign_ext_pk(digest.data(), digest.size(), secret.data(), secretExtension.data(), edPublicKey.data(), out.data());
+        // carry the sign bit of the ed25519 public key, which the curve25519 key does not have
+        out[63] = (out[63] & 127) | (edPublicKey[31] & 0x80);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+} // namespace TW
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "Data.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <TrustWalletCore/TWCurve.h>
+
+#include <array>
+#include <span>
+
+namespace TW {
+
+/// A private key prepared for signing many digests on one curve.
+///
+/// The key material is copied into fixed buffers once, together with whatever the curve can precompute:
+/// the public key for all curves, and the expanded (hashed and clamped) secret for the ed25519 family,
+/// so a signature costs a single base point multiplication instead of two.
+/// Signatures are byte-identical to `PrivateKey::sign(digest, curve)` and `sign()` does not allocate.
+/// The key material is wiped on destruction; the context is neither copyable nor movable, so it is never duplicated.
+class SigningContext {
+public:
+    /// The largest signature produced, (r, s, v) for the ECDSA curves.
+    static const std::size_t maxSignatureSize = 65;
+
+    /// Prepares `privateKey` for signing with `curve`.
+    /// Throws if the curve differs from the one of the key, if the curve is not supported (Starkex), or if the key
+    /// is too short for the curve.
+    SigningContext(const PrivateKey& privateKey, TWCurve curve);
+
+    /// Prepares `privateKey` for signing with the curve it was constructed with.
+    explicit SigningContext(const PrivateKey& privateKey);
+
+    SigningContext(const SigningContext&) = delete;
+    SigningContext& operator=(const SigningContext&) = delete;
+
+    ~SigningContext();
+
+    TWCurve curve() const { return _curve; }
+
+    /// The public key, with the natural type of the curve (compressed for ECDSA).
+    const PublicKey& publicKey() const { return _publicKey; }
+
+    /// The size of a signature: 65 bytes for the ECDSA curves, 64 for the ed25519 family.
+    std::size_t signatureSize() const;
+
+    /// Signs `digest` into the first `signatureSize()` bytes of `out`.
+    /// Returns false if the digest cannot be signed (e.g. an ECDSA digest shorter than 32 bytes or all zero).
+    /// Throws if `out` is too small.
+    bool sign(std::span<const byte> digest, std::span<byte> out) const;
+
+private:
+    static TWCurve checkedCurve(const PrivateKey& privateKey, TWCurve curve);
+    static TWCurve curveOf(const PrivateKey& privateKey);
+
+    /// Fills the key buffers for the curve, and returns the public key.
+    PublicKey prepare(const PrivateKey& privateKey);
+
+    TWCurve _curve;
+    /// ECDSA: the private key. ed25519: the clamped scalar of the expanded secret.
+    std::array<byte, 32> secret;
+    /// ed25519: the nonce prefix of the expanded secret (the Cardano key extension).
+    std::array<byte, 32> secretExtension;
+    /// ed25519: the point of `secret`, hashed into every signature.
+    std::array<byte, 32> edPublicKey;
+    PublicKey _publicKey;
+};
+
+} // namespace TW
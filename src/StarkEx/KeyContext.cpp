@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include <StarkEx/KeyContext.h>
+#include <rust/Wrapper.h>
+
+#include <stdexcept>
+
+namespace TW::StarkEx {
+
+namespace {
+
+std::shared_ptr<Rust::TWPrivateKey> loadKey(const PrivateKey& privateKey) {
+    const auto& bytes = privateKey.bytes;
+    auto* key = Rust::tw_private_key_create_with_data(bytes.data(), bytes.size());
+    if (key == nullptr) {
+        throw std::invalid_argument("Invalid Stark private key");
+    }
+    return Rust::wrapTWPrivateKey(key);
+}
+
+PublicKey derivePublicKey(Rust::TWPrivateKey* key) {
+    auto* publicKey = Rust::tw_private_key_get_public_key_by_type(key, static_cast<uint32_t>(TWPublicKeyTypeStarkex));
+    if (publicKey == nullptr) {
+        throw std::invalid_argument("Invalid Stark private key");
+    }
+    const auto wrapped = Rust::wrapTWPublicKey(publicKey);
+    Rust::CByteArrayWrapper data = Rust::tw_public_key_data(wrapped.get());
+    return PublicKey(data.data, TWPublicKeyTypeStarkex);
+}
+
+} // namespace
+
+KeyContext::KeyContext(const PrivateKey& privateKey)
+    : key(loadKey(privateKey)), _publicKey(derivePublicKey(key.get())) {}
+
+Data KeyContext::sign(const Data& digest) const {
+    Rust::CByteArrayWrapper result = Rust::tw_private_key_sign(key.get(), digest.data(), digest.size(), static_cast<uint32_t>(TWCurveStarkex));
+    if (result.data.size() != 64) {
+        return {};
+    }
+    return result.data;
+}
+
+} // namespace TW::StarkEx
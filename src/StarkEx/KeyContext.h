@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#pragma once
+
+#include "Data.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <memory>
+
+namespace TW::Rust {
+struct TWPrivateKey;
+} // namespace TW::Rust
+
+namespace TW::StarkEx {
+
+/// A Stark private key prepared for signing many messages.
+///
+/// The key is loaded into the Rust keypair once, and its public key is derived once, so that signing does not
+/// create and delete a key object nor derive the public key again on every call.
+/// Signatures are the same as `PrivateKey::sign(digest, TWCurveStarkex)`.
+class KeyContext {
+public:
+    /// Prepares `privateKey` for signing on the Stark curve.
+    ///
+    /// \throws std::invalid_argument if the key is not a valid Stark private key.
+    explicit KeyContext(const PrivateKey& privateKey);
+
+    /// The Stark public key.
+    const PublicKey& publicKey() const { return _publicKey; }
+
+    /// Signs `digest`, returns the 64-byte (r, s) signature, or empty data if the digest cannot be signed.
+    Data sign(const Data& digest) const;
+
+private:
+    std::shared_ptr<Rust::TWPrivateKey> key;
+    PublicKey _publicKey;
+};
+
+} // namespace TW::StarkEx
+
+/// Wrapper for C interface.
+struct TWStarkExKeyContext {
+    TW::StarkEx::KeyContext impl;
+};
@@ -12,6 +12,11 @@ std::string MessageSigner::signMessage(const TW::PrivateKey& privateKey, const s
     return hex(privateKey.sign(digest, TWCurveStarkex));
 }
 
+std::string MessageSigner::signMessage(const KeyContext& context, const std::string& message) {
+    auto digest = parse_hex(message, true);
+    return hex(context.sign(digest));
+}
+
 bool MessageSigner::verifyMessage(const PublicKey& publicKey, const std::string& message, const std::string& signature) noexcept {
     auto starkSignature = parse_hex(signature, true);
     auto digest = parse_hex(message, true);
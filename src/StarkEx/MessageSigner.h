@@ -5,6 +5,7 @@
 #pragma once
 
 #include <PrivateKey.h>
+#include <StarkEx/KeyContext.h>
 #include <string>
 
 namespace TW::StarkEx {
@@ -16,6 +17,12 @@ public:
     /// \return hex signed message
     static std::string signMessage(const PrivateKey& privateKey, const std::string& message);;
 
+    /// Sign a message following StarkEx Curve, with a key prepared for repeated signing
+    /// \param context the prepared private key to sign with
+    /// \param message hex message to sign
+    /// \return hex signed message
+    static std::string signMessage(const KeyContext& context, const std::string& message);
+
     /// Verify a message following EIP-191
     /// \param publicKey publickey to verify the signed message
     /// \param message message to be verified as a string
@@ -31,7 +31,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index,
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
+        auto hashPrevouts = sighashCache.has_value() ? sighashCache->hashPrevouts : getPrevoutHash();
         std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -40,7 +40,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index,
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
         !Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
+        auto hashSequence = sighashCache.has_value() ? sighashCache->hashSequence : getSequenceHash();
         std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -57,7 +57,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index,
 
     // Outputs (none/one/all, depending on flags)
     if (!Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
+        auto hashOutputs = sighashCache.has_value() ? sighashCache->hashOutputs : getOutputsHash();
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else if (Bitcoin::hashTypeIsSingle(hashType) && index < outputs.size()) {
         Data outputData;
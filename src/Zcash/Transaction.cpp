@@ -8,16 +8,32 @@
 #include "../BinaryCoding.h"
 
 #include <cassert>
+#include <span>
 
 namespace TW::Zcash {
 
-const auto sigHashPersonalization = Data({'Z', 'c', 'a', 's', 'h', 'S', 'i', 'g', 'H', 'a', 's', 'h'});
-const auto prevoutsHashPersonalization = Data({'Z', 'c', 'a', 's', 'h', 'P', 'r', 'e', 'v', 'o', 'u', 't', 'H', 'a', 's', 'h'});
-const auto sequenceHashPersonalization = Data({'Z', 'c', 'a', 's', 'h', 'S', 'e', 'q', 'u', 'e', 'n', 'c', 'H', 'a', 's', 'h'});
-const auto outputsHashPersonalization = Data({'Z', 'c', 'a', 's', 'h', 'O', 'u', 't', 'p', 'u', 't', 's', 'H', 'a', 's', 'h'});
-const auto joinsplitsHashPersonalization = Data({'Z', 'c', 'a', 's', 'h', 'J', 'S', 'p', 'l', 'i', 't', 's', 'H', 'a', 's', 'h'});
-const auto shieldedSpendHashPersonalization = Data({'Z', 'c', 'a', 's', 'h', 'S', 'S', 'p', 'e', 'n', 'd', 's', 'H', 'a', 's', 'h'});
-const auto shieldedOutputsHashPersonalization = Data({'Z', 'c', 'a', 's', 'h', 'S', 'O', 'u', 't', 'p', 'u', 't', 'H', 'a', 's', 'h'});
+namespace {
+
+using Personalization = std::array<byte, 16>;
+
+/// Followed by the consensus branch id
+constexpr std::array<byte, 12> sigHashPersonalization = {'Z', 'c', 'a', 's', 'h', 'S', 'i', 'g', 'H', 'a', 's', 'h'};
+constexpr Personalization prevoutsHashPersonalization = {'Z', 'c', 'a', 's', 'h', 'P', 'r', 'e', 'v', 'o', 'u', 't', 'H', 'a', 's', 'h'};
+constexpr Personalization sequenceHashPersonalization = {'Z', 'c', 'a', 's', 'h', 'S', 'e', 'q', 'u', 'e', 'n', 'c', 'H', 'a', 's', 'h'};
+constexpr Personalization outputsHashPersonalization = {'Z', 'c', 'a', 's', 'h', 'O', 'u', 't', 'p', 'u', 't', 's', 'H', 'a', 's', 'h'};
+
+/// Version, version group id, six hashes, lock time, expiry height, value balance, hash type, then the input being
+/// signed without its script code: outpoint, amount and sequence
+constexpr size_t preImageFixedSize = 4 + 4 + 6 * 32 + 4 + 4 + 8 + 4 + 36 + 8 + 4;
+
+/// 32-byte personalized BLAKE2b hash
+Data hashPersonal(const Data& data, std::span<const byte> personal) {
+    Data hash(32);
+    Hash::blake2b(data.data(), data.size(), hash, personal);
+    return hash;
+}
+
+} // namespace
 
 /// See https://github.com/zcash/zips/blob/master/zips/zip-0205.rst#sapling-deployment BRANCH_ID section
 const std::array<TW::byte, 4> SaplingBranchID = {0xbb, 0x09, 0xb8, 0x76};
@@ -31,6 +47,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
     assert(index < inputs.size());
 
     auto data = Data{};
+    data.reserve(preImageFixedSize + varIntSize(scriptCode.bytes.size()) + scriptCode.bytes.size());
 
     // header
     encode32LE(_version, data);
@@ -40,8 +57,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
-        std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
+        append(data, sighashCache.has_value() ? sighashCache->hashPrevouts : getPrevoutHash());
     } else {
         std::fill_n(back_inserter(data), 32, 0);
     }
@@ -49,37 +65,34 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
         !Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
-        std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
+        append(data, sighashCache.has_value() ? sighashCache->hashSequence : getSequenceHash());
     } else {
         std::fill_n(back_inserter(data), 32, 0);
     }
 
     // Outputs (none/one/all, depending on flags)
     if (!Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
-        copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
+        append(data, sighashCache.has_value() ? sighashCache->hashOutputs : getOutputsHash());
     } else if (Bitcoin::hashTypeIsSingle(hashType) && index < outputs.size()) {
         auto outputData = Data{};
         outputs[index].encode(outputData);
-        auto hashOutputs =
-            TW::Hash::blake2b(outputData, outputData.size(), outputsHashPersonalization);
-        copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
+        // ZIP-243 specifies a 32-byte hash, but the hash size has always been the encoded output size here; kept
+        // as is so that existing SIGHASH_SINGLE signatures stay the same
+        Data hashOutputs(outputData.size());
+        Hash::blake2b(outputData.data(), outputData.size(), hashOutputs, outputsHashPersonalization);
+        append(data, hashOutputs);
     } else {
         fill_n(back_inserter(data), 32, 0);
     }
 
     // JoinSplits
-    auto hashJoinSplits = getJoinSplitsHash();
-    data.insert(std::end(data), std::begin(hashJoinSplits), std::end(hashJoinSplits));
+    append(data, sighashCache.has_value() ? sighashCache->hashJoinSplits : getJoinSplitsHash());
 
     // ShieldedSpends
-    auto hashShieldedSpends = getShieldedSpendsHash();
-    data.insert(std::end(data), std::begin(hashShieldedSpends), std::end(hashShieldedSpends));
+    append(data, sighashCache.has_value() ? sighashCache->hashShieldedSpends : getShieldedSpendsHash());
 
     // ShieldedOutputs
-    auto hashShieldedOutputs = getShieldedOutputsHash();
-    data.insert(std::end(data), std::begin(hashShieldedOutputs), std::end(hashShieldedOutputs));
+    append(data, sighashCache.has_value() ? sighashCache->hashShieldedOutputs : getShieldedOutputsHash());
 
     // Locktime
     encode32LE(lockTime, data);
@@ -111,8 +124,7 @@ Data Transaction::getPrevoutHash() const {
         auto& outpoint = input.previousOutput;
         outpoint.encode(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, prevoutsHashPersonalization);
-    return hash;
+    return hashPersonal(data, prevoutsHashPersonalization);
 }
 
 Data Transaction::getSequenceHash() const {
@@ -120,8 +132,7 @@ Data Transaction::getSequenceHash() const {
     for (auto& input : inputs) {
         encode32LE(input.sequence, data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, sequenceHashPersonalization);
-    return hash;
+    return hashPersonal(data, sequenceHashPersonalization);
 }
 
 Data Transaction::getOutputsHash() const {
@@ -129,8 +140,12 @@ Data Transaction::getOutputsHash() const {
     for (auto& output : outputs) {
         output.encode(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, outputsHashPersonalization);
-    return hash;
+    return hashPersonal(data, outputsHashPersonalization);
+}
+
+void Transaction::precomputeSighash() {
+    sighashCache = SighashCache{getPrevoutHash(), getSequenceHash(), getOutputsHash(),
+                                getJoinSplitsHash(), getShieldedSpendsHash(), getShieldedOutputsHash()};
 }
 
 Data Transaction::getJoinSplitsHash() const {
@@ -179,14 +194,10 @@ void Transaction::encode(Data& data) const {
 Data Transaction::getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount,
                                    [[maybe_unused]] Bitcoin::SignatureVersion version) const {
-    Data personalization;
-    personalization.reserve(16);
-    std::copy(sigHashPersonalization.begin(), sigHashPersonalization.begin() + 12,
-              std::back_inserter(personalization));
-    std::copy(branchId.begin(), branchId.end(), std::back_inserter(personalization));
-    auto preimage = getPreImage(scriptCode, index, hashType, amount);
-    auto hash = Hash::blake2b(preimage, 32, personalization);
-    return hash;
+    Personalization personalization;
+    std::copy(sigHashPersonalization.begin(), sigHashPersonalization.end(), personalization.begin());
+    std::copy(branchId.begin(), branchId.end(), personalization.begin() + sigHashPersonalization.size());
+    return hashPersonal(getPreImage(scriptCode, index, hashType, amount), personalization);
 }
 
 Bitcoin::Proto::Transaction Transaction::proto() const {
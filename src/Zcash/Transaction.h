@@ -11,6 +11,7 @@
 #include "../proto/Bitcoin.pb.h"
 
 #include <array>
+#include <optional>
 #include <vector>
 
 namespace TW::Zcash {
@@ -19,6 +20,16 @@ extern const std::array<byte, 4> SaplingBranchID;
 extern const std::array<byte, 4> BlossomBranchID;
 extern const std::array<byte, 4> Nu6BranchID;
 
+/// ZIP-243 signature hash components that are shared by all inputs of a transaction.
+struct SighashCache {
+    Data hashPrevouts;
+    Data hashSequence;
+    Data hashOutputs;
+    Data hashJoinSplits;
+    Data hashShieldedSpends;
+    Data hashShieldedOutputs;
+};
+
 /// Only supports transparent transaction right now
 /// See also https://github.com/zcash/zips/blob/master/zip-0243.rst
 struct Transaction {
@@ -35,6 +46,10 @@ struct Transaction {
     /// Used for diagnostics; store previously estimated virtual size (if any; size in bytes)
     int previousEstimatedVirtualSize = 0;
 
+    /// Precomputed ZIP-243 sighash components, see `precomputeSighash()`.
+    /// Must be reset if the inputs or outputs are changed afterwards.
+    std::optional<SighashCache> sighashCache;
+
     Transaction() = default;
 
     Transaction(uint32_t version, uint32_t versionGroupId, uint32_t lockTime, uint32_t expiryHeight,
@@ -56,6 +71,9 @@ struct Transaction {
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the sighash components shared by all inputs once.
+    void precomputeSighash();
+
     Data getJoinSplitsHash() const;
     Data getShieldedSpendsHash() const;
     Data getShieldedOutputsHash() const;
@@ -95,6 +95,21 @@ struct TWPrivateKey *_Nonnull TWHDWalletGetDerivedKey(struct TWHDWallet *_Nonnul
     return new TWPrivateKey{ wallet->impl.getKey(coin, derivationPath) };
 }
 
+struct TWDataVector *_Nonnull TWHDWalletGetAddressRange(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, uint32_t account, uint32_t change, uint32_t start, uint32_t count) {
+    auto* result = TWDataVectorCreate();
+    try {
+        for (const auto& address : wallet->impl.deriveAddresses(coin, account, change, start, count)) {
+            auto* addressData = TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(address.data()), address.size());
+            TWDataVectorAdd(result, addressData);
+            TWDataDelete(addressData);
+        }
+    } catch (...) {
+        TWDataVectorDelete(result);
+        return TWDataVectorCreate();
+    }
+    return result;
+}
+
 struct TWPrivateKey *_Nonnull TWHDWalletGetKeyByCurve(struct TWHDWallet *_Nonnull wallet, enum TWCurve curve, TWString *_Nonnull derivationPath) {
     auto& s = *reinterpret_cast<const std::string*>(derivationPath);
     const auto path = DerivationPath(s);
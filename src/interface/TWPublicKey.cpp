@@ -4,6 +4,7 @@
 
 #include <TrustWalletCore/TWPublicKey.h>
 
+#include "../DataVector.h"
 #include "../HexCoding.h"
 #include "../PublicKey.h"
 
@@ -81,3 +82,50 @@ struct TWPublicKey *_Nullable TWPublicKeyRecover(TWData *_Nonnull signature, TWD
         return nullptr;
     }
 }
+
+TWData *_Nonnull TWPublicKeyVerifyBatch(const struct TWDataVector *_Nonnull publicKeys, enum TWPublicKeyType type, const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull messages, bool asDER, uint32_t threads) {
+    const auto keys = TW::createFromTWDataVector(publicKeys);
+    auto signaturesVec = TW::createFromTWDataVector(signatures);
+    auto messagesVec = TW::createFromTWDataVector(messages);
+    if (keys.size() != signaturesVec.size() || keys.size() != messagesVec.size()) {
+        return TWDataCreateWithSize(0);
+    }
+
+    // invalid keys fail their entry only
+    std::vector<PublicKey> validKeys;
+    std::vector<TW::Data> validSignatures;
+    std::vector<TW::Data> validMessages;
+    std::vector<std::size_t> positions;
+    for (auto i = 0ul; i < keys.size(); ++i) {
+        if (!PublicKey::isValid(keys[i], type)) {
+            continue;
+        }
+        validKeys.emplace_back(keys[i], type);
+        validSignatures.push_back(std::move(signaturesVec[i]));
+        validMessages.push_back(std::move(messagesVec[i]));
+        positions.push_back(i);
+    }
+
+    TW::Data result(keys.size(), 0);
+    try {
+        const auto verified = PublicKey::verifyBatch(validKeys, validSignatures, validMessages, asDER, threads);
+        for (auto i = 0ul; i < verified.size(); ++i) {
+            result[positions[i]] = verified[i] ? 1 : 0;
+        }
+    } catch (...) {} // all invalid
+    return TWDataCreateWithBytes(result.data(), result.size());
+}
+
+struct TWDataVector *_Nonnull TWPublicKeyRecoverBatch(const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull messages, uint32_t threads) {
+    auto* result = TWDataVectorCreate();
+    try {
+        const auto recovered = PublicKey::recoverBatch(TW::createFromTWDataVector(signatures), TW::createFromTWDataVector(messages), threads);
+        for (const auto& publicKey : recovered) {
+            const auto bytes = publicKey.has_value() ? publicKey->bytes : TW::Data();
+            auto* data = TWDataCreateWithBytes(bytes.data(), bytes.size());
+            TWDataVectorAdd(result, data);
+            TWDataDelete(data);
+        }
+    } catch (...) {} // return empty
+    return result;
+}
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include <TrustWalletCore/TWStarkExKeyContext.h>
+
+#include "PrivateKey.h"
+#include "PublicKey.h"
+#include "StarkEx/KeyContext.h"
+
+struct TWStarkExKeyContext* _Nullable TWStarkExKeyContextCreate(const struct TWPrivateKey* _Nonnull privateKey) {
+    try {
+        return new TWStarkExKeyContext{ TW::StarkEx::KeyContext(privateKey->impl) };
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void TWStarkExKeyContextDelete(struct TWStarkExKeyContext* _Nonnull context) {
+    delete context;
+}
+
+struct TWPublicKey* _Nonnull TWStarkExKeyContextPublicKey(const struct TWStarkExKeyContext* _Nonnull context) {
+    return new TWPublicKey{ context->impl.publicKey() };
+}
@@ -15,6 +15,15 @@ TWString* _Nonnull TWStarkExMessageSignerSignMessage(const struct TWPrivateKey*
     }
 }
 
+TWString* _Nonnull TWStarkExMessageSignerSignMessageWithContext(const struct TWStarkExKeyContext* _Nonnull context, TWString* _Nonnull message) {
+    try {
+        const auto signature = TW::StarkEx::MessageSigner::signMessage(context->impl, TWStringUTF8Bytes(message));
+        return TWStringCreateWithUTF8Bytes(signature.c_str());
+    } catch (...) {
+        return TWStringCreateWithUTF8Bytes("");
+    }
+}
+
 bool TWStarkExMessageSignerVerifyMessage(const struct TWPublicKey* _Nonnull publicKey, TWString* _Nonnull message, TWString* _Nonnull signature) {
     return TW::StarkEx::MessageSigner::verifyMessage(publicKey->impl, TWStringUTF8Bytes(message), TWStringUTF8Bytes(signature));
 }
@@ -8,6 +8,7 @@
 #include "Data.h"
 #include "../HDWallet.h"
 #include "../Keystore/StoredKey.h"
+#include "../Keystore/UnlockSession.h"
 #include "../HexCoding.h"
 #include <stdexcept>
 #include <cassert>
@@ -297,6 +298,60 @@ bool TWStoredKeyUpdateAddress(struct TWStoredKey* _Nonnull key, enum TWCoinType
     }
 }
 
+TWData* _Nullable TWStoredKeyDecryptPrivateKeyWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session) {
+    try {
+        const auto data = session->impl.decrypt(key->impl.payload);
+        return TWDataCreateWithBytes(data.data(), data.size());
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+TWString* _Nullable TWStoredKeyDecryptPrivateKeyEncodedWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session) {
+    try {
+        const auto encodedStr = key->impl.decryptPrivateKeyEncoded(session->impl);
+        return TWStringCreateWithUTF8Bytes(encodedStr.c_str());
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+TWString* _Nullable TWStoredKeyDecryptMnemonicWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session) {
+    try {
+        const auto data = session->impl.decrypt(key->impl.payload);
+        const auto string = std::string(data.begin(), data.end());
+        return TWStringCreateWithUTF8Bytes(string.c_str());
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+struct TWPrivateKey* _Nullable TWStoredKeyPrivateKeyWithSession(struct TWStoredKey* _Nonnull key, enum TWCoinType coin, struct TWStoredKeyUnlockSession* _Nonnull session) {
+    try {
+        return new TWPrivateKey{ key->impl.privateKey(coin, session->impl) };
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+struct TWHDWallet* _Nullable TWStoredKeyWalletWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session) {
+    try {
+        // the C interface hands over a wallet of its own to the caller
+        return new TWHDWallet{ *key->impl.wallet(session->impl) };
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+bool TWStoredKeyFixAddressesWithSession(struct TWStoredKey* _Nonnull key, struct TWStoredKeyUnlockSession* _Nonnull session) {
+    try {
+        key->impl.fixAddresses(session->impl);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 TWString* _Nullable TWStoredKeyEncryptionParameters(struct TWStoredKey* _Nonnull key) {
     if (!key->impl.id) {
         return nullptr;
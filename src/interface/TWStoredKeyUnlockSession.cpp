@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include <TrustWalletCore/TWStoredKeyUnlockSession.h>
+
+#include "Data.h"
+#include "../Keystore/UnlockSession.h"
+
+#include <chrono>
+
+namespace KeyStore = TW::Keystore;
+
+struct TWStoredKeyUnlockSession* _Nullable TWStoredKeyUnlockSessionCreate(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, uint32_t lifetimeSeconds) {
+    try {
+        const auto passwordData = TW::data(TWDataBytes(password), TWDataSize(password));
+        return new TWStoredKeyUnlockSession{ KeyStore::UnlockSession(key->impl, passwordData, std::chrono::seconds(lifetimeSeconds)) };
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void TWStoredKeyUnlockSessionDelete(struct TWStoredKeyUnlockSession* _Nonnull session) {
+    delete session;
+}
+
+bool TWStoredKeyUnlockSessionIsExpired(struct TWStoredKeyUnlockSession* _Nonnull session) {
+    return session->impl.isExpired();
+}
+
+bool TWStoredKeyUnlockSessionIsMemoryLocked(struct TWStoredKeyUnlockSession* _Nonnull session) {
+    return session->impl.isMemoryLocked();
+}
+
+void TWStoredKeyUnlockSessionLock(struct TWStoredKeyUnlockSession* _Nonnull session) {
+    session->impl.lock();
+}
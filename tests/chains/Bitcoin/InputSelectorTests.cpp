@@ -432,6 +432,72 @@ TEST(BitcoinInputSelector, SelectZcashMaxUnspents2) {
     EXPECT_TRUE(verifySelectedUTXOs(selected, {2592, 73774, 100000}));
 }
 
+TEST(BitcoinInputSelector, SelectBranchAndBoundExact) {
+    auto utxos = buildTestUTXOs({10'000, 20'000, 30'000, 45'000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+    // fee 41 for the transaction, 102 for each input
+    auto selected = selector.selectBranchAndBound(49'755, 1);
+
+    EXPECT_TRUE(verifySelectedUTXOs(selected, {30'000, 20'000}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundExcessBelowCostOfChange) {
+    auto utxos = buildTestUTXOs({10'000, 20'000, 30'000, 45'000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+    // an excess of 55, below the cost of change (31 for the output, 102 to spend it), goes to the fee
+    auto selected = selector.selectBranchAndBound(49'700, 1);
+
+    EXPECT_TRUE(verifySelectedUTXOs(selected, {30'000, 20'000}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundNoChangeless) {
+    auto utxos = buildTestUTXOs({10'000, 20'000, 30'000, 45'000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(49'600, 1), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(200'000, 1), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(0, 1), {}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundIterationBudget) {
+    auto utxos = buildTestUTXOs({10'000, 20'000, 30'000, 45'000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(49'755, 1, 1, 0, 3), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(49'755, 1, 1, 0, 100), {30'000, 20'000}));
+}
+
+TEST(BitcoinInputSelector, SelectKnapsack) {
+    auto utxos = buildTestUTXOs({10'000, 20'000, 30'000, 45'000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+
+    // exact match, no change
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(49'755, 1), {30'000, 20'000}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(60'000, 1), {45'000, 20'000}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(5'000, 1), {10'000}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(100'000, 1), {45'000, 30'000, 20'000, 10'000}));
+    // insufficient
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(200'000, 1), {}));
+}
+
+TEST(BitcoinInputSelector, SelectKnapsackWaste) {
+    auto utxos = buildTestUTXOs({100'000, 10'000, 20'000, 30'000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+
+    // same waste, fewer inputs
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(25'000, 1), {30'000}));
+    // fee rate below the long-term one, spending more inputs now saves fees
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(25'000, 1, 1, 10), {20'000, 10'000}));
+    // high fee rate, paying for a change output wastes less than leaving the excess of 30'000 to the fee
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(25'000, 20, 1, 1), {100'000}));
+}
+
 TEST(BitcoinInputSelector, ManyUtxos_900) {
     const auto n = 900;
     const auto byteFee = 10;
@@ -462,6 +528,36 @@ TEST(BitcoinInputSelector, ManyUtxos_900) {
     EXPECT_TRUE(verifySelectedUTXOs(selected, subset));
 }
 
+TEST(BitcoinInputSelector, ManyUtxos_100000) {
+    const auto n = 100'000;
+    const auto byteFee = 10;
+    std::vector<int64_t> values;
+    uint64_t valueSum = 0;
+    for (int i = 0; i < n; ++i) {
+        const uint64_t val = (i + 1) * 100;
+        values.push_back(val);
+        valueSum += val;
+    }
+    const uint64_t requestedAmount = valueSum / 8;
+    EXPECT_EQ(requestedAmount, 62'500'625'000ul);
+    auto utxos = buildTestUTXOs(values);
+
+    auto selector = InputSelector<UTXO>(utxos);
+    auto selected = selector.select(requestedAmount, byteFee);
+
+    // expected result: 6460 utxos, with the largest amounts
+    std::vector<int64_t> subset;
+    uint64_t subsetSum = 0;
+    for (int i = n - 6460; i < n; ++i) {
+        const uint64_t val = (i + 1) * 100;
+        subset.push_back(val);
+        subsetSum += val;
+    }
+    EXPECT_EQ(subset.size(), 6460ul);
+    EXPECT_EQ(subsetSum, 62'513'743'000ul);
+    EXPECT_TRUE(verifySelectedUTXOs(selected, subset));
+}
+
 TEST(BitcoinInputSelector, ManyUtxos_5000_simple) {
     const auto n = 5000;
     const auto byteFee = 10;
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "TxComparisonHelper.h"
+#include "Bitcoin/OpCodes.h"
+#include "Bitcoin/Script.h"
+#include "Bitcoin/SizeEstimator.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin {
+
+namespace {
+
+const auto privateKey2 = PrivateKey(parse_hex("0a0b2a3c7ea3b3a2ea1a3e6e2e5a1f0c8f4d2b6b0e0a0b0c0d0e0f1011121314"), TWCurveSECP256k1);
+const auto privateKey3 = PrivateKey(parse_hex("3c0a2b4d6e8f0a1b2c3d4e5f60718293a4b5c6d7e8f90a1b2c3d4e5f60718293"), TWCurveSECP256k1);
+
+TransactionPlan buildPlan(const UTXOs& utxos, Amount amount, Amount change) {
+    TransactionPlan plan;
+    plan.utxos = utxos;
+    plan.availableAmount = sumUTXOs(utxos);
+    plan.amount = amount;
+    plan.change = change;
+    plan.fee = plan.availableAmount - amount - change;
+    return plan;
+}
+
+void addUTXOs(UTXOs& utxos, const Script& script, size_t count) {
+    for (auto i = 0ul; i < count; ++i) {
+        auto utxo = buildTestUTXO(10'000 + utxos.size());
+        utxo.outPoint.index = static_cast<uint32_t>(utxos.size());
+        utxo.script = script;
+        utxos.push_back(utxo);
+    }
+}
+
+Data keyHash(const PrivateKey& key, TWPublicKeyType type = TWPublicKeyTypeSECP256k1) {
+    const auto publicKey = key.getPublicKey(type);
+    return Hash::sha256ripemd(publicKey.bytes.data(), publicKey.bytes.size());
+}
+
+/// 2-of-3 multisig of the test keys
+Script buildMultisigScript(const SigningInput& input) {
+    Data script{OP_2};
+    for (const auto& key : {input.privateKeys[0], privateKey2, privateKey3}) {
+        const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+        script.push_back(static_cast<byte>(publicKey.bytes.size()));
+        append(script, publicKey.bytes);
+    }
+    script.push_back(OP_3);
+    script.push_back(OP_CHECKMULTISIG);
+    return Script(script);
+}
+
+/// Adds the P2SH redeem script, and returns the P2SH script
+Script addPayToScriptHash(SigningInput& input, const Script& redeemScript) {
+    const auto scriptHash = Hash::sha256ripemd(redeemScript.bytes.data(), redeemScript.bytes.size());
+    input.scripts[hex(scriptHash)] = redeemScript;
+    return Script::buildPayToScriptHash(scriptHash);
+}
+
+/// Adds the P2WSH witness script, and returns the P2WSH script
+Script addPayToWitnessScriptHash(SigningInput& input, const Script& witnessScript) {
+    const auto scriptHash = Hash::sha256(witnessScript.bytes);
+    input.scripts[hex(Hash::ripemd(scriptHash))] = witnessScript;
+    return Script::buildPayToWitnessScriptHash(scriptHash);
+}
+
+/// Virtual size of the transaction signed with placeholder signatures
+uint64_t signedVirtualSize(SigningInput input, const TransactionPlan& plan) {
+    input.plan = plan;
+    auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(input, true);
+    EXPECT_TRUE(result);
+    const auto transaction = result.payload();
+    const auto size = getEncodedTxSize(transaction);
+    return transaction.hasWitness() ? size.virtualBytes : size.nonSegwit;
+}
+
+std::optional<uint64_t> estimatedVirtualSize(const SigningInput& input, const TransactionPlan& plan) {
+    auto transaction = TransactionBuilder::build<Transaction>(plan, input);
+    EXPECT_TRUE(transaction);
+    return SizeEstimator::virtualSize(transaction.payload(), plan.utxos, input);
+}
+
+void expectSameSize(const SigningInput& input, const TransactionPlan& plan) {
+    const auto estimated = estimatedVirtualSize(input, plan);
+    ASSERT_TRUE(estimated.has_value());
+    EXPECT_EQ(estimated.value(), signedVirtualSize(input, plan));
+}
+
+} // namespace
+
+TEST(BitcoinSizeEstimator, PayToWitnessPublicKeyHash) {
+    auto utxos = buildTestUTXOs({100'000});
+    auto input = buildSigningInput(50'000, 1, utxos);
+
+    const auto plan = buildPlan(utxos, 50'000, 49'000);
+    EXPECT_EQ(estimatedVirtualSize(input, plan), 147ul);
+    expectSameSize(input, plan);
+    expectSameSize(input, buildPlan(utxos, 50'000, 0));
+}
+
+TEST(BitcoinSizeEstimator, PayToPublicKeyHash) {
+    auto input = buildSigningInput(50'000, 1, {});
+    input.privateKeys.push_back(privateKey2);
+    UTXOs utxos;
+    addUTXOs(utxos, Script::buildPayToPublicKeyHash(keyHash(input.privateKeys[0])), 3);
+    // uncompressed public key
+    addUTXOs(utxos, Script::buildPayToPublicKeyHash(keyHash(privateKey2, TWPublicKeyTypeSECP256k1Extended)), 2);
+    // missing private key
+    addUTXOs(utxos, Script::buildPayToPublicKeyHash(keyHash(privateKey3)), 1);
+    input.utxos = utxos;
+
+    const auto plan = buildPlan(utxos, 50'000, 10'000);
+    EXPECT_EQ(estimatedVirtualSize(input, plan), 1030ul);
+    expectSameSize(input, plan);
+}
+
+TEST(BitcoinSizeEstimator, PayToScriptHashWitnessPublicKeyHash) {
+    auto input = buildSigningInput(50'000, 1, {});
+    const auto script = addPayToScriptHash(input, Script::buildPayToWitnessPublicKeyHash(keyHash(input.privateKeys[0])));
+    UTXOs utxos;
+    addUTXOs(utxos, script, 4);
+    input.utxos = utxos;
+
+    expectSameSize(input, buildPlan(utxos, 30'000, 10'000));
+}
+
+TEST(BitcoinSizeEstimator, PayToWitnessScriptHashMultisig) {
+    auto input = buildSigningInput(50'000, 1, {});
+    const auto multisig = buildMultisigScript(input);
+    UTXOs utxos;
+    addUTXOs(utxos, addPayToWitnessScriptHash(input, multisig), 3);
+    // wrapped in P2SH
+    addUTXOs(utxos, addPayToScriptHash(input, addPayToWitnessScriptHash(input, multisig)), 2);
+    input.utxos = utxos;
+
+    expectSameSize(input, buildPlan(utxos, 30'000, 10'000));
+}
+
+TEST(BitcoinSizeEstimator, Mixed) {
+    auto input = buildSigningInput(50'000, 1, {});
+    input.outputOpReturn = parse_hex("00112233445566778899");
+    input.extraOutputs.emplace_back("bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4", 1'000);
+    const auto& key = input.privateKeys[0];
+    UTXOs utxos;
+    addUTXOs(utxos, Script::buildPayToWitnessPublicKeyHash(keyHash(key)), 2);
+    addUTXOs(utxos, Script::buildPayToPublicKeyHash(keyHash(key)), 2);
+    addUTXOs(utxos, addPayToScriptHash(input, Script::buildPayToWitnessPublicKeyHash(keyHash(key))), 2);
+    addUTXOs(utxos, addPayToWitnessScriptHash(input, buildMultisigScript(input)), 2);
+    input.utxos = utxos;
+
+    auto plan = buildPlan(utxos, 30'000, 10'000);
+    plan.outputOpReturn = input.outputOpReturn;
+    expectSameSize(input, plan);
+
+    input.hashType = TWBitcoinSigHashTypeSingle;
+    expectSameSize(input, plan);
+}
+
+TEST(BitcoinSizeEstimator, ManyInputs) {
+    UTXOs utxos;
+    addUTXOs(utxos, buildTestUTXO(0).script, 1'000);
+    auto input = buildSigningInput(1'000'000, 1, utxos);
+
+    expectSameSize(input, buildPlan(utxos, 1'000'000, 0));
+}
+
+TEST(BitcoinSizeEstimator, PayToTaproot) {
+    auto input = buildSigningInput(50'000, 1, {});
+    const auto publicKey = input.privateKeys[0].getPublicKey(TWPublicKeyTypeSECP256k1);
+    UTXOs utxos;
+    addUTXOs(utxos, Script::buildPayToV1WitnessProgram(subData(publicKey.bytes, 1)), 1);
+    input.utxos = utxos;
+
+    // not signed by `SignatureBuilder`, so not estimated either: planning falls back to the simple estimate
+    const auto plan = buildPlan(utxos, 5'000, 4'000);
+    EXPECT_FALSE(estimatedVirtualSize(input, plan).has_value());
+    input.plan = plan;
+    const auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(input, true);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), Common::Proto::Error_script_output);
+}
+
+TEST(BitcoinSizeEstimator, Unsupported) {
+    auto input = buildSigningInput(50'000, 1, {});
+    // P2SH multisig, and P2SH without redeem script
+    UTXOs utxos;
+    addUTXOs(utxos, addPayToScriptHash(input, buildMultisigScript(input)), 1);
+    EXPECT_FALSE(estimatedVirtualSize(input, buildPlan(utxos, 5'000, 0)).has_value());
+    utxos.clear();
+    addUTXOs(utxos, Script::buildPayToScriptHash(Data(20, 1)), 1);
+    EXPECT_FALSE(estimatedVirtualSize(input, buildPlan(utxos, 5'000, 0)).has_value());
+}
+
+TEST(BitcoinSizeEstimator, PlanUsesEstimate) {
+    UTXOs utxos;
+    addUTXOs(utxos, buildTestUTXO(0).script, 1'000);
+    auto input = buildSigningInput(0, 3, utxos, true);
+
+    const auto plan = TransactionBuilder::plan(input);
+    ASSERT_EQ(plan.error, Common::Proto::OK);
+    EXPECT_EQ(plan.fee, 3 * static_cast<int64_t>(signedVirtualSize(input, plan)));
+}
+
+} // namespace TW::Bitcoin
@@ -731,6 +731,29 @@ TEST(BitcoinSigning, SignP2PKH) {
     );
 }
 
+TEST(BitcoinSigning, SignP2PKH_ManyUnrelatedKeys) {
+    auto input = buildInputP2PKH();
+    auto reference = TransactionSigner<Transaction, TransactionBuilder>::sign(input);
+    ASSERT_TRUE(reference) << std::to_string(reference.error());
+
+    // Unrelated keys before and after the matching ones must not change the result
+    std::vector<PrivateKey> keys;
+    for (auto i = 1; i <= 50; ++i) {
+        keys.emplace_back(Hash::sha256(Data{static_cast<byte>(i)}), TWCurveSECP256k1);
+    }
+    keys.insert(keys.begin() + 25, input.privateKeys.rbegin(), input.privateKeys.rend());
+    input.privateKeys = keys;
+
+    auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(input);
+    ASSERT_TRUE(result) << std::to_string(result.error());
+
+    Data expected;
+    reference.payload().encode(expected);
+    Data serialized;
+    result.payload().encode(serialized);
+    EXPECT_EQ(hex(serialized), hex(expected));
+}
+
 TEST(BitcoinSigning, SignP2PKH_NegativeMissingKey) {
     auto input = buildInputP2PKH(true);
 
@@ -2,6 +2,7 @@
 //
 // Copyright © 2017 Trust Wallet.
 
+#include "Bitcoin/SigHashType.h"
 #include "Bitcoin/Transaction.h"
 #include "HexCoding.h"
 
@@ -34,4 +35,41 @@ TEST(BitcoinTransaction, Encode) {
               "02000000035897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f0000000000ffffffffbf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c1200000000ffffffff22a6f904655d53ae2ff70e701a0bbd90aa3975c0f40bfc6cc996a9049e31cdfc0100000000ffffffff0280a81201000000001976a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac0084d717000000001976a914f2d4db28cad6502226ee484ae24505c2885cb12d88ac00000000");
 }
 
+TEST(BitcoinTransaction, PrecomputedSighash) {
+    auto transaction = Transaction(2, 0);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("5897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f"), 0), Script(), 4294967295);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("bf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c"), 18), Script(), 4294967294);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("22a6f904655d53ae2ff70e701a0bbd90aa3975c0f40bfc6cc996a9049e31cdfc"), 1), Script(), 4294967295);
+    transaction.outputs.emplace_back(18000000, Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac")));
+    transaction.outputs.emplace_back(400000000, Script(parse_hex("76a914f2d4db28cad6502226ee484ae24505c2885cb12d88ac")));
+
+    const auto scriptCode = Script::buildPayToPublicKeyHash(parse_hex("1d0f172a0ecb48aee1be1f2687d2963ae33f71a1"));
+    const std::vector<TWBitcoinSigHashType> hashTypes = {
+        TWBitcoinSigHashTypeAll,
+        TWBitcoinSigHashTypeNone,
+        TWBitcoinSigHashTypeSingle,
+        TWBitcoinSigHashType(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay),
+    };
+
+    std::vector<Data> expected;
+    for (auto hashType : hashTypes) {
+        for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+            expected.push_back(transaction.getSignatureHash(scriptCode, i, hashType, 100'000 + i, WITNESS_V0));
+        }
+    }
+
+    transaction.precomputeSighash();
+    ASSERT_TRUE(transaction.sighashCache.has_value());
+    EXPECT_EQ(transaction.sighashCache->hashPrevouts, transaction.getPrevoutHash());
+    EXPECT_EQ(transaction.sighashCache->hashSequence, transaction.getSequenceHash());
+    EXPECT_EQ(transaction.sighashCache->hashOutputs, transaction.getOutputsHash());
+
+    auto n = 0ul;
+    for (auto hashType : hashTypes) {
+        for (auto i = 0ul; i < transaction.inputs.size(); ++i) {
+            EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, i, hashType, 100'000 + i, WITNESS_V0)), hex(expected[n++]));
+        }
+    }
+}
+
 } // namespace TW::Bitcoin
@@ -358,6 +358,43 @@ TEST(TransactionPlan, Inputs5_33Req13Fee20) {
     EXPECT_EQ(feeCalculator.calculateSingleInput(byteFee), 2040);
 }
 
+TEST(TransactionPlan, BranchAndBoundChangeless) {
+    auto utxos = buildTestUTXOs({10'000, 20'000, 30'000, 45'000});
+    auto sigingInput = buildSigningInput(49'755, 1, utxos);
+    sigingInput.coinSelection = Proto::BranchAndBound;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    // no change output, the excess is left to the fee
+    EXPECT_TRUE(verifyPlan(txPlan, {30'000, 20'000}, 49'755, 245));
+    EXPECT_EQ(txPlan.change, 0);
+}
+
+TEST(TransactionPlan, BranchAndBoundFallbackKnapsack) {
+    auto utxos = buildTestUTXOs({10'000, 20'000, 30'000, 45'000});
+    auto sigingInput = buildSigningInput(60'000, 1, utxos);
+    sigingInput.coinSelection = Proto::BranchAndBound;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    EXPECT_EQ(txPlan.error, Common::Proto::OK);
+    EXPECT_TRUE(verifySelectedUTXOs(txPlan.utxos, {45'000, 20'000}));
+    EXPECT_EQ(txPlan.amount, 60'000);
+    EXPECT_GT(txPlan.change, 0);
+    EXPECT_EQ(txPlan.amount + txPlan.change + txPlan.fee, 65'000);
+}
+
+TEST(TransactionPlan, KnapsackInsufficient) {
+    auto utxos = buildTestUTXOs({10'000, 20'000, 30'000, 45'000});
+    auto sigingInput = buildSigningInput(104'900, 1, utxos);
+    sigingInput.coinSelection = Proto::Knapsack;
+    sigingInput.coinSelectionMaxIterations = 10;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    EXPECT_TRUE(verifyPlan(txPlan, {}, 0, 0, Common::Proto::Error_not_enough_utxos));
+}
+
 TEST(TransactionPlan, NoUTXOs) {
     auto utxos = buildTestUTXOs({});
     auto sigingInput = buildSigningInput(15000, 1, utxos);
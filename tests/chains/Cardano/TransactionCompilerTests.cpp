@@ -2,6 +2,7 @@
 //
 // Copyright © 2017 Trust Wallet.
 
+#include "Cardano/Transaction.h"
 #include "Coin.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
@@ -66,6 +67,14 @@ TEST(CardanoCompiler, CompileWithSignaturesAndPubKeyType) {
     preOut.ParseFromArray(preImageHash.data(), (int)preImageHash.size());
     EXPECT_EQ(hex(preOut.data_hash()), "3e5a7c1d1afbc7e3ca783daba1beb12010fc4ecc748722558697509212c9f186");
 
+    // The pre-image is the transaction body, it decodes back to the same transaction
+    const auto body = data(preOut.data());
+    const auto decoded = Cardano::Transaction::decode(body);
+    ASSERT_EQ(decoded.outputs.size(), 2ul);
+    EXPECT_EQ(decoded.outputs[1].tokenBundle.size(), 3ul);
+    EXPECT_EQ(hex(decoded.encode()), hex(body));
+    EXPECT_EQ(hex(decoded.getId()), hex(preOut.data_hash()));
+
     // Simulate signature, normally obtained from signature server
     const auto publicKeyData = parse_hex("17c55d712152ccabf28215fe2d008d615f94796e098a97f1aa43d986ac3cb946");
     const PublicKey publicKey = PublicKey(publicKeyData, TWPublicKeyTypeED25519);
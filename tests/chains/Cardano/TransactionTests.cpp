@@ -4,6 +4,7 @@
 
 #include "Cardano/Transaction.h"
 #include "Cardano/AddressV3.h"
+#include "Cardano/TxSizeModel.h"
 #include <TrustWalletCore/TWCardano.h>
 
 #include "HexCoding.h"
@@ -52,6 +53,78 @@ TEST(CardanoTransaction, GetId) {
     EXPECT_EQ(hex(txid), "cc262713a3e15a0fa245b062f33ffc6c2aa5a64c3ae7bfa793414069914e1bbf");
 }
 
+TEST(CardanoTransaction, Decode) {
+    const auto encoded = createTx().encode();
+
+    const auto tx = Transaction::decode(encoded);
+    ASSERT_EQ(tx.inputs.size(), 2ul);
+    EXPECT_EQ(hex(tx.inputs[0].txHash), "f074134aabbfb13b8aec7cf5465b1e5a862bde5cb88532cc7e64619179b3e767");
+    EXPECT_EQ(tx.inputs[0].outputIndex, 1ul);
+    ASSERT_EQ(tx.outputs.size(), 2ul);
+    EXPECT_EQ(AddressV3(tx.outputs[1].address).string(), "addr1q92cmkgzv9h4e5q7mnrzsuxtgayvg4qr7y3gyx97ukmz3dfx7r9fu73vqn25377ke6r0xk97zw07dqr9y5myxlgadl2s0dgke5");
+    EXPECT_EQ(tx.outputs[1].amount, 16749189ul);
+    EXPECT_EQ(tx.fee, 165555ul);
+    EXPECT_EQ(tx.ttl, 53333345ul);
+    EXPECT_EQ(hex(tx.encode()), hex(encoded));
+}
+
+TEST(CardanoTransaction, DecodeSignedWithCertificates) {
+    // staking key registration and delegation, see CardanoStaking tests
+    const auto encoded = parse_hex("83a500828258209b06de86b253549b99f6a050b61217d8824085ca5ed4eb107a5e7cce4f93802e008258209b06de86b253549b99f6a050b61217d8824085ca5ed4eb107a5e7cce4f93802e01018182583901df58ee97ce7a46cd8bdeec4e5f3a03297eb197825ed5681191110804df22424b6880b39e4bac8c58de9fe6d23d79aaf44756389d827aa09b1a01b2607a021a0002ceb6031a042a5c99048282008200581cdf22424b6880b39e4bac8c58de9fe6d23d79aaf44756389d827aa09b83028200581cdf22424b6880b39e4bac8c58de9fe6d23d79aaf44756389d827aa09b581c7d7ac07a2f2a25b7a4db868a40720621c4939cf6aefbb9a11464f1a6a100828258206d8a0b425bd2ec9692af39b1c0cf0e51caa07a603550e22f54091e872c7df29058405d8b21c993aec7a7bdf0c832e5688920b64b665e1e36a2e6040d6dd8ad195e7774df3c1377047737d8b676fa4115e38fbf6ef854904db6d9c8ee3e26e8561408825820e554163344aafc2bbefe778a6953ddce0583c2f8e0a0686929c020ca33e06932584088a3f6387693f9077d11a6e245e024b791074bcaa26c034e687d67f3324b6f90a437d33d0343e11c7dee1a28270c223e02080e452fe97cdc93d26c720ab6b805f6");
+
+    // the body is the first element, witnesses are skipped without being parsed
+    Cbor::Reader reader(encoded);
+    EXPECT_EQ(reader.readArray(), 3ul);
+    const auto body = reader.skip();
+    const auto tx = Transaction::decode(body);
+
+    ASSERT_EQ(tx.certificates.size(), 2ul);
+    EXPECT_EQ(tx.certificates[0].type, Certificate::SkatingKeyRegistration);
+    EXPECT_EQ(hex(tx.certificates[0].certKey.key), "df22424b6880b39e4bac8c58de9fe6d23d79aaf44756389d827aa09b");
+    EXPECT_EQ(tx.certificates[1].type, Certificate::Delegation);
+    EXPECT_EQ(hex(tx.certificates[1].poolId), "7d7ac07a2f2a25b7a4db868a40720621c4939cf6aefbb9a11464f1a6");
+    EXPECT_EQ(hex(tx.getId()), "23e1d1bc27f6de57e323d232d44c909fb41ee2ebfff28b82ca8cae6947866ea7");
+    EXPECT_EQ(hex(tx.encode()), hex(body));
+}
+
+TEST(CardanoTransaction, DecodeInvalid) {
+    EXPECT_THROW(Transaction::decode(parse_hex("a40082")), std::invalid_argument);
+    EXPECT_THROW(Transaction::decode(parse_hex("8100")), std::invalid_argument);
+}
+
+TEST(CardanoTransaction, SizeModel) {
+    Transaction tx = createTx();
+    EXPECT_EQ(TxSizeModel(tx).bodySize(), tx.encode().size());
+
+    // crossing the one-byte array header boundary at 24 elements
+    for (auto i = 0; i < 30; ++i) {
+        tx.inputs.emplace_back(Data(32, static_cast<byte>(i)), i);
+        ASSERT_EQ(TxSizeModel(tx).bodySize(), tx.encode().size());
+    }
+
+    tx.outputs[1] = TxOutput(tx.outputs[1].address, 1500000,
+        TokenBundle({TokenAmount("9a9693a9a37912a5097918f97918d15240c92ab729a0b7c4aa144d77", data("SUNDAE"), 80996569)}));
+    TxSizeModel model(tx);
+    EXPECT_EQ(model.bodySize(), tx.encode().size());
+
+    tx.fee = 0xFFFFFFFF + 1ul;
+    model.setFee(tx.fee);
+    EXPECT_EQ(model.bodySize(), tx.encode().size());
+}
+
+TEST(CardanoTransaction, SizeModelSigned) {
+    // staking key registration and delegation, two witnesses, see DecodeSignedWithCertificates
+    const auto encoded = parse_hex("83a500828258209b06de86b253549b99f6a050b61217d8824085ca5ed4eb107a5e7cce4f93802e008258209b06de86b253549b99f6a050b61217d8824085ca5ed4eb107a5e7cce4f93802e01018182583901df58ee97ce7a46cd8bdeec4e5f3a03297eb197825ed5681191110804df22424b6880b39e4bac8c58de9fe6d23d79aaf44756389d827aa09b1a01b2607a021a0002ceb6031a042a5c99048282008200581cdf22424b6880b39e4bac8c58de9fe6d23d79aaf44756389d827aa09b83028200581cdf22424b6880b39e4bac8c58de9fe6d23d79aaf44756389d827aa09b581c7d7ac07a2f2a25b7a4db868a40720621c4939cf6aefbb9a11464f1a6a100828258206d8a0b425bd2ec9692af39b1c0cf0e51caa07a603550e22f54091e872c7df29058405d8b21c993aec7a7bdf0c832e5688920b64b665e1e36a2e6040d6dd8ad195e7774df3c1377047737d8b676fa4115e38fbf6ef854904db6d9c8ee3e26e8561408825820e554163344aafc2bbefe778a6953ddce0583c2f8e0a0686929c020ca33e06932584088a3f6387693f9077d11a6e245e024b791074bcaa26c034e687d67f3324b6f90a437d33d0343e11c7dee1a28270c223e02080e452fe97cdc93d26c720ab6b805f6");
+    Cbor::Reader reader(encoded);
+    reader.readArray();
+    const auto tx = Transaction::decode(reader.skip());
+
+    TxSizeModel model(tx);
+    model.setWitnesses(2, false);
+    EXPECT_EQ(model.size(), encoded.size());
+    EXPECT_EQ(model.size(), 461ul);
+}
+
 TEST(CardanoTransaction, minAdaAmount) {
     const auto policyId = "9a9693a9a37912a5097918f97918d15240c92ab729a0b7c4aa144d77";
 
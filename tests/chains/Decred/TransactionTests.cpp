@@ -81,4 +81,60 @@ TEST(DecredTransaction, SignatureHash) {
     transaction.encode(result);
     EXPECT_EQ(hex(result), "0100020003000000000000000000000000ffffffff00000000000000000000000000fff"
                            "fffff00000000000000000000000000ffffffff00");
-}
\ No newline at end of file
+}
+
+TEST(DecredTransaction, PrecomputedSignatureHash) {
+    Decred::Transaction transaction;
+    for (auto i = 0u; i < 3; ++i) {
+        auto outPoint = OutPoint(parse_hex("5897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f"), i, 0);
+        transaction.inputs.emplace_back(outPoint, Bitcoin::Script(), 4294967295);
+    }
+    auto script = Bitcoin::Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac"));
+    transaction.outputs.emplace_back(18000000, 0, script);
+    transaction.outputs.emplace_back(400000000, 0, script);
+
+    const auto preOutScript = Bitcoin::Script(parse_hex("a914f5916158e3e2c4551c1796708db8367207ed13bb87"));
+    // Hashes of every input, except inputs without a matching output for Single
+    const std::vector<std::pair<TWBitcoinSigHashType, std::vector<std::string>>> expected = {
+        {TWBitcoinSigHashTypeAll, {
+            "2e2475716cb2afc863606ae113750d92215ad24c67067252508862bb2c825e54",
+            "8579cbb84c7a1fa25795d59a4232ead5a6776cfc79fe3848cd002926c062d6cd",
+            "e382182b8b4d1d9359968182828a66f274650e3ec382b3e5d115c226f9984216",
+        }},
+        {TWBitcoinSigHashTypeNone, {
+            "0867af91a8c30aa0ccfb4fc709638e784bdb0474b4047b5fc737b036fa25cb17",
+            "0a4660d2fcde7813ed85397d67bd513d093df1dcc4952f14b89ce33bbcabcc83",
+            "cc11bc90fb65983073d332ad7ac2b7dbf2b6fc30a472620f4374f7e8fc04f12b",
+        }},
+        {TWBitcoinSigHashTypeSingle, {
+            "844eccd38c3479c0fc4dd1634492cb1bfe3ad00219afc4b734d36f82c08b234e",
+            "cd389f55dd858be600855754978103f4734208bef46c34fc529bfbfa66b892ba",
+        }},
+        {TWBitcoinSigHashType(TWBitcoinSigHashTypeAnyoneCanPay | TWBitcoinSigHashTypeAll), {
+            "eafa3d424d36d0bd7b7814d76bd7a2e3f4acf0df5632a4f024c2c46a82fc538a",
+            "5f5fed7a1385303aefa17f5b2fb317265f6858156bba57eb1acf2a72a068e3ce",
+            "9ec8cc432ccc99386ef9bb05180e13e83781f06d5cdd07213cc1bcce3f47fbbf",
+        }},
+        {TWBitcoinSigHashType(TWBitcoinSigHashTypeAnyoneCanPay | TWBitcoinSigHashTypeNone), {
+            "950273e41972f2ba9f88664a6f99ba4379a7228f07d5ec32931c050574c83702",
+            "6e203ab1594ce987dfad142fae83d71b58ca2ea63c32fe332c71b709b150b96c",
+            "24eb7b65d6dda4e14c82058588dc09f71ec2b476e1527b4ae0533c393d0b648d",
+        }},
+        {TWBitcoinSigHashType(TWBitcoinSigHashTypeAnyoneCanPay | TWBitcoinSigHashTypeSingle), {
+            "3d7f135e7d221c52cc03ed7bb5f959acc3310f7e37b76485f76a9ebd24e65e64",
+            "9f415784e0327ab77ba08b00dac99eb3ff88fab045b5f80e9400c83c257f2ddd",
+        }},
+    };
+
+    // Without, then with the precomputed hashes
+    for (auto precomputed : {false, true}) {
+        if (precomputed) {
+            transaction.precomputeSighash();
+        }
+        for (const auto& [hashType, hashes] : expected) {
+            for (auto index = 0ul; index < hashes.size(); ++index) {
+                EXPECT_EQ(hex(transaction.computeSignatureHash(preOutScript, index, hashType)), hashes[index]) << hashType << " " << index;
+            }
+        }
+    }
+}
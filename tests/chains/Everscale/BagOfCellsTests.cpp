@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Base64.h"
+#include "Crc.h"
+#include "HexCoding.h"
+
+#include "Everscale/CommonTON/BagOfCells.h"
+#include "Everscale/CommonTON/Cell.h"
+#include "Everscale/CommonTON/CellArena.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::CommonTON {
+
+// Wallet v3r2 code, serialized with a CRC32C checksum
+static constexpr auto WALLET_V3R2 = "te6cckEBAQEAcQAA3v8AIN0gggFMl7ohggEznLqxn3Gw7UTQ0x/THzHXC//jBOCk8mCDCNcYINMf0x/TH/gjE7vyY+1E0NMf0x/T/9FRMrryoVFEuvKiBPkBVBBV+RDyo/gAkyDXSpbTB9QC+wDo0QGkyMsfyx/L/8ntVBC9ba0=";
+
+TEST(EverscaleBagOfCells, Crc32c) {
+    const std::string check = "123456789";
+    EXPECT_EQ(Crc::crc32c(reinterpret_cast<const uint8_t*>(check.data()), check.size()), 0xe3069283u);
+    EXPECT_EQ(Crc::crc32c(nullptr, 0), 0u);
+
+    // RFC 3720, B.4
+    const Data zeros(32, 0x00);
+    EXPECT_EQ(Crc::crc32c(zeros.data(), zeros.size()), 0x8a9136aau);
+    const Data ones(32, 0xff);
+    EXPECT_EQ(Crc::crc32c(ones.data(), ones.size()), 0x62a8ab43u);
+    const auto ascending = parse_hex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    EXPECT_EQ(Crc::crc32c(ascending.data(), ascending.size()), 0x46dd794eu);
+}
+
+TEST(EverscaleBagOfCells, WithCrc) {
+    const auto boc = Base64::decode(WALLET_V3R2);
+
+    CellArena arena;
+    BocReader reader(boc, arena);
+    EXPECT_EQ(reader.cellCount(), 1ul);
+    EXPECT_EQ(reader.rootCount(), 1ul);
+    EXPECT_FALSE(reader.hasIndex());
+    const auto root = reader.loadRoot(0);
+    EXPECT_EQ(hex(arena.hash(root)), "84dafa449f98a6987789ba232358072bc0f76dc4524002a5d0918b9a75d2d599");
+
+    Data os;
+    const std::array roots{root};
+    serializeBoc(arena, roots, os, BocOptions{.hasCrc = true});
+    EXPECT_EQ(os, boc);
+
+    // Checksum mismatch
+    auto corrupted = boc;
+    corrupted[20] ^= 1;
+    EXPECT_THROW(BocReader(corrupted, arena), std::runtime_error);
+}
+
+TEST(EverscaleBagOfCells, MultipleRoots) {
+    CellArena arena;
+    const auto leaf = arena.add(parse_hex("aa"), 8, {});
+    const auto other = arena.add(parse_hex("bbc0"), 9, {});
+    const std::array leafRef{leaf};
+    const auto left = arena.add(parse_hex("01"), 8, leafRef);
+    const std::array bothRefs{leaf, other};
+    const auto right = arena.add(parse_hex("02"), 8, bothRefs);
+
+    const std::array roots{left, right};
+    Data os;
+    serializeBoc(arena, roots, os, BocOptions{.indexIncluded = true, .hasCrc = true, .hasCacheBits = true});
+
+    CellArena loaded;
+    BocReader reader(os, loaded);
+    EXPECT_EQ(reader.cellCount(), 4ul);
+    ASSERT_EQ(reader.rootCount(), 2ul);
+    EXPECT_TRUE(reader.hasIndex());
+
+    // Only the leaf shared by both roots is marked for caching
+    size_t cached = 0;
+    for (size_t i = 0; i < reader.cellCount(); ++i) {
+        cached += reader.shouldCache(i) ? 1 : 0;
+    }
+    EXPECT_EQ(cached, 1ul);
+
+    // Loading a root only decodes its own subtree
+    const auto loadedLeft = reader.loadRoot(0);
+    EXPECT_EQ(loaded.size(), 2ul);
+    EXPECT_EQ(loaded.hash(loadedLeft), arena.hash(left));
+
+    const auto loadedRight = reader.loadRoot(1);
+    EXPECT_EQ(loaded.size(), 4ul);
+    EXPECT_EQ(loaded.hash(loadedRight), arena.hash(right));
+    EXPECT_EQ(loaded.references(loadedRight)[0], loaded.references(loadedLeft)[0]);
+
+    // Same roots through `CellArena::deserialize`
+    CellArena another;
+    const auto deserialized = another.deserialize(os.data(), os.size());
+    ASSERT_EQ(deserialized.size(), 2ul);
+    EXPECT_EQ(another.hash(deserialized[0]), arena.hash(left));
+    EXPECT_EQ(another.hash(deserialized[1]), arena.hash(right));
+
+    // `Cell` only accepts a BOC with a single root
+    EXPECT_THROW(Cell::deserialize(os.data(), os.size()), std::runtime_error);
+}
+
+TEST(EverscaleBagOfCells, Index) {
+    const auto cell = Cell::fromBase64(WALLET_V3R2);
+    CellArena arena;
+    const std::array roots{arena.add(*cell)};
+
+    Data withIndex;
+    serializeBoc(arena, roots, withIndex, BocOptions{.indexIncluded = true});
+    Data withoutIndex;
+    serializeBoc(arena, roots, withoutIndex);
+    // One offset entry per cell
+    EXPECT_EQ(withIndex.size(), withoutIndex.size() + 1);
+
+    CellArena loaded;
+    BocReader reader(withIndex, loaded);
+    EXPECT_TRUE(reader.hasIndex());
+    EXPECT_FALSE(reader.shouldCache(0));
+    EXPECT_EQ(loaded.hash(reader.loadRoot(0)), cell->hash);
+
+    // Offset that does not match the cell
+    withIndex[11] += 1;
+    CellArena invalid;
+    EXPECT_THROW(BocReader(withIndex, invalid).loadRoot(0), std::runtime_error);
+}
+
+TEST(EverscaleBagOfCells, AbsentCells) {
+    Cell::CellHash prunedHash{};
+    prunedHash.fill(0x5a);
+
+    CellArena arena;
+    const auto absent = arena.addAbsent(prunedHash, 7);
+    EXPECT_TRUE(arena.isAbsent(absent));
+    EXPECT_EQ(arena.depth(absent), 7);
+
+    const std::array refs{absent};
+    const auto root = arena.add(parse_hex("e0"), 2, refs);
+    EXPECT_EQ(arena.depth(root), 8);
+
+    const std::array roots{root};
+    Data os;
+    serializeBoc(arena, roots, os, BocOptions{.hasCrc = true});
+
+    CellArena loaded;
+    const auto deserialized = loaded.deserialize(os.data(), os.size());
+    ASSERT_EQ(deserialized.size(), 1ul);
+    EXPECT_EQ(loaded.hash(deserialized[0]), arena.hash(root));
+    const auto child = loaded.references(deserialized[0])[0];
+    EXPECT_TRUE(loaded.isAbsent(child));
+    EXPECT_EQ(loaded.hash(child), prunedHash);
+    EXPECT_EQ(loaded.depth(child), 7);
+
+    EXPECT_THROW(loaded.toCell(deserialized[0]), std::runtime_error);
+}
+
+TEST(EverscaleBagOfCells, InvalidOptions) {
+    CellArena arena;
+    const std::array roots{arena.add(parse_hex("ff"), 8, {})};
+    Data os;
+
+    // Cache bits are stored in the index
+    EXPECT_THROW(serializeBoc(arena, roots, os, BocOptions{.hasCacheBits = true}), std::invalid_argument);
+    EXPECT_THROW(serializeBoc(arena, roots, os, BocOptions{.refSize = 5}), std::invalid_argument);
+    EXPECT_THROW(serializeBoc(arena, roots, os, BocOptions{.offsetSize = 9}), std::invalid_argument);
+    EXPECT_THROW(serializeBoc(arena, {}, os), std::invalid_argument);
+    const std::array missing{CellArena::Index{1}};
+    EXPECT_THROW(serializeBoc(arena, missing, os), std::invalid_argument);
+    const std::array duplicate{roots[0], roots[0]};
+    EXPECT_THROW(serializeBoc(arena, duplicate, os), std::invalid_argument);
+}
+
+} // namespace TW::CommonTON
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Base64.h"
+#include "HexCoding.h"
+
+#include "Everscale/CommonTON/Cell.h"
+#include "Everscale/CommonTON/CellArena.h"
+#include "Everscale/Wallet.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::CommonTON {
+
+static constexpr auto TX = "te6ccgECDgEAAyUAA7V6uRyM7ESqbjssMUQyAqYyQTlEkfDkEhWjBiC1fvKLabAAAaKsEuhQGeqOSyMlWG32ehDzoVCXMh6ugfMLr6pOPj3b6KD4DR/wAAGirA4jnSYtmdCAADR6V/lIBQQBAg8MQQYcxc1EQAMCAG/JkrcETDHn2AAAAAAAAgAAAAAAAop8XDVxQ98+QpgCzzW0U0opAulbEzfySLp3wLLoHzboQRA6FACdROMjE4gAAAAAAAAAACHAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAIACCcgkc5v5RyBDaeDdbY8Q+SpmX5OOkhzxFyB/ug4o/bJwJXDMKjAeOEr9OvfcJlgyx80ukSBl43/FO2DXIt1+SuAQCAeAJBgEB3wcBsWgBVyORnYiVTcdlhiiGQFTGSCcokj4cgkK0YMQWr95RbTcAIXxdqfc1KmavZDEIGsfjdBuS4lE5Ox4rJZ+Z+rauOxDRZaC8AAYx6CQAADRVgl0KBMWzOhDACAF7C04VCAAAAAAvMK5pAAAAAAAAAAAAAAAAAA7xIIAFdGVusOGq5cSrATb2hH5h5turvUDrer4E0Mf51wPlefAMAd2IAVcjkZ2IlU3HZYYohkBUxkgnKJI+HIJCtGDEFq/eUW02AMrbR14n5UXrp1deXDU5rl8kQvDfSKbnA+d09dtQe2mo8t94jbtllx/DjCgucIpvywjhJBhWNQjtWXh4dP6qiDAAAAADFszqDukuhIYKAQTQAwsB42IAQvi7U+5qVM1eyGIQNY/G6DclxKJydjxWSz8z9W1cdiGiy0F4AAAAAAAAAAAAAAAAAAALThUIAAAAAC8wrmkAAAAAAAAAAAAAAAAADvEggAV0ZW6w4arlxKsBNvaEfmHm26u9QOt6vgTQx/nXA+V58AwBY4AUk5qcKxU0Kqq8xI6zxcnOzaRMAW8AGxI8jfJSPgiVJ6AAAAAAAAAAAAAARVadlK9wDQBDgBVyORnYiVTcdlhiiGQFTGSCcokj4cgkK0YMQWr95RbTcA==";
+
+TEST(EverscaleCellArena, Deserialize) {
+    const auto boc = Base64::decode(TX);
+
+    CellArena arena;
+    const auto roots = arena.deserialize(boc.data(), boc.size());
+    ASSERT_EQ(roots.size(), 1ul);
+    const auto root = roots[0];
+    EXPECT_EQ(hex(arena.hash(root)), "88a02e7bd8833d384f37d63d4d01deef9a1806937b94a313cc5e8c3cc7643032");
+    EXPECT_EQ(arena.size(), 14ul);
+    EXPECT_EQ(arena.references(root).size(), 3ul);
+
+    // Cells are stored once
+    EXPECT_EQ(arena.deserialize(boc.data(), boc.size()), roots);
+    EXPECT_EQ(arena.size(), 14ul);
+
+    const auto cell = arena.toCell(root);
+    EXPECT_TRUE(cell->finalized);
+    EXPECT_EQ(cell->depth, arena.depth(root));
+    EXPECT_EQ(hex(cell->hash), hex(arena.hash(root)));
+}
+
+TEST(EverscaleCellArena, AddTree) {
+    const auto cell = Cell::deserialize(Everscale::Wallet::code.data(), Everscale::Wallet::code.size());
+
+    CellArena arena;
+    const auto root = arena.add(*cell);
+    EXPECT_EQ(hex(arena.hash(root)), "84dafa449f98a6987789ba232358072bc0f76dc4524002a5d0918b9a75d2d599");
+    EXPECT_EQ(arena.bitLen(root), cell->bitLen);
+    EXPECT_EQ(hex(arena.data(root)), hex(cell->data));
+}
+
+TEST(EverscaleCellArena, HashConsing) {
+    const auto leaf = std::make_shared<Cell>(8, Data{0xab}, 0, Cell::Refs{});
+    const auto other = std::make_shared<Cell>(8, Data{0xab}, 0, Cell::Refs{});
+    auto parent = std::make_shared<Cell>(0, Data{}, 2, Cell::Refs{leaf, other});
+
+    CellArena arena;
+    const auto root = arena.add(*parent);
+    ASSERT_EQ(arena.size(), 2ul);
+    const auto references = arena.references(root);
+    ASSERT_EQ(references.size(), 2ul);
+    EXPECT_EQ(references[0], references[1]);
+    EXPECT_EQ(arena.add(Data{0xab}, 8, {}), references[0]);
+
+    parent->finalize();
+    EXPECT_EQ(parent->depth, 1);
+    EXPECT_EQ(hex(parent->hash), hex(arena.hash(root)));
+}
+
+TEST(EverscaleCellArena, AddOwnData) {
+    CellArena arena;
+    auto index = arena.add(parse_hex("0123456789abcdef"), 64, {});
+    auto cell = std::make_shared<Cell>(64, parse_hex("0123456789abcdef"), 0, Cell::Refs{});
+    // each cell copies the data of the previous one, growing the arena data until it is reallocated
+    for (auto i = 0; i < 100; ++i) {
+        const std::array references{index};
+        index = arena.add(arena.data(index), 64, references);
+        cell = std::make_shared<Cell>(64, parse_hex("0123456789abcdef"), 1, Cell::Refs{cell});
+        ASSERT_EQ(hex(arena.data(index)), "0123456789abcdef");
+    }
+    cell->finalize();
+    EXPECT_EQ(hex(arena.hash(index)), hex(cell->hash));
+}
+
+TEST(EverscaleCellArena, DepthLimit) {
+    auto cell = std::make_shared<Cell>();
+    for (auto i = 0; i < Cell::MAX_DEPTH; ++i) {
+        cell = std::make_shared<Cell>(0, Data{}, 1, Cell::Refs{cell});
+    }
+    cell->finalize();
+    EXPECT_EQ(cell->depth, Cell::MAX_DEPTH);
+
+    Data boc;
+    cell->serialize(boc);
+    EXPECT_EQ(Cell::deserialize(boc.data(), boc.size())->depth, Cell::MAX_DEPTH);
+
+    const auto deeper = std::make_shared<Cell>(0, Data{}, 1, Cell::Refs{cell});
+    EXPECT_THROW(deeper->finalize(), std::invalid_argument);
+    EXPECT_THROW(CellArena().add(*deeper), std::runtime_error);
+}
+
+TEST(EverscaleCellArena, Invalid) {
+    CellArena arena;
+    // missing child
+    EXPECT_THROW(arena.add(Data{}, 0, std::vector<CellArena::Index>{0}), std::invalid_argument);
+    // not enough data
+    EXPECT_THROW(arena.add(Data{0x01}, 9, {}), std::invalid_argument);
+    EXPECT_THROW(arena.toCell(0), std::invalid_argument);
+}
+
+} // namespace TW::CommonTON
@@ -75,18 +75,24 @@ TEST(EverscaleCell, InvalidCell) {
     ASSERT_THROW(Cell::fromBase64("aGVsbG8gd29ybGQK"), std::runtime_error);
     // refSize > 4
     ASSERT_THROW(Cell::fromBase64("te6ccgUCAAAAAAEAAAAAAQAAAAAAFD4AAAAAAAO3etQ="), std::runtime_error);
-    // unsupported root count
+    // unexpected eof (header sizes run past the input)
     ASSERT_THROW(Cell::fromBase64("te6ccgECdRIAFD4AA7d61A=="), std::runtime_error);
+    // unsupported root count
+    ASSERT_THROW(Cell::fromBase64("te6ccgEBAQAAAgAA"), std::runtime_error);
+    // invalid offset size
+    ASSERT_THROW(Cell::fromBase64("te6ccgEJAQEAAAAAAAAAAAACAAAA"), std::runtime_error);
     // root count is greater than cell count
     ASSERT_THROW(Cell::fromBase64("te6ccgECAAEAFD4AA7d61A=="), std::runtime_error);
-    // absent cells are not supported
+    // absent count is greater than cell count
     ASSERT_THROW(Cell::fromBase64("te6ccgECAQESFD4AA7d61A=="), std::runtime_error);
     // non-zero level is not supported
     ASSERT_THROW(Cell::fromBase64("te6ccgECAQEAFD4AY7d61FeCHf8yG3+VsHLEilQ6UuYy8wcpWi1+/Q=="), std::runtime_error);
     // exotic cells are not supported
     ASSERT_THROW(Cell::fromBase64("te6ccgECAQEAFD4AC7d61FeCHf8yG3+VsHLEilQ6UuYy8wcpWi1+/Q=="), std::runtime_error);
-    // absent cells are not supported
+    // unexpected eof (the stored hash of an absent cell runs past the input)
     ASSERT_THROW(Cell::fromBase64("te6ccgECAQEAFD4AF7d61FeCHf8yG3+VsHLEilQ6UuYy8wcpWi1+/Q=="), std::runtime_error);
+    // absent cell not counted in the header
+    ASSERT_THROW(Cell::fromBase64("te6ccgEBAQEAJAAXAFpaWlpaWlpaWlpaWlpaWlpaWlpaWlpaWlpaWlpaWlpaAAA="), std::runtime_error);
     // invalid ref count
     ASSERT_THROW(Cell::fromBase64("te6ccgEBAQEAAwAFAA=="), std::runtime_error);
     // invalid child index
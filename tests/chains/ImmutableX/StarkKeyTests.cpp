@@ -35,6 +35,12 @@ TEST(ImmutableX, GrindKey) {
     ASSERT_EQ(res, "5c8c8683596c732541a59e03007b2d30dbbbb873556fe65b5fb63c16688f941");
 }
 
+TEST(ImmutableX, GrindKeyBytes) {
+    auto seed = parse_hex("86F3E7293141F20A8BAFF320E8EE4ACCB9D4A4BF2B4D295E8CEE784DB46E0519");
+    // the key is padded to 32 bytes
+    ASSERT_EQ(hex(grindKeyBytes(seed)), "05c8c8683596c732541a59e03007b2d30dbbbb873556fe65b5fb63c16688f941");
+}
+
 TEST(ImmutableX, GetPrivateKeySignature) {
     std::string signature = "0x21fbf0696d5e0aa2ef41a2b4ffb623bcaf070461d61cf7251c74161f82fec3a4370854bc0a34b3ab487c1bc021cd318c734c51ae29374f2beb0e6f2dd49b4bf41c";
     auto data = parse_hex(signature);
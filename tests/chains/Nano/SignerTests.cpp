@@ -5,9 +5,11 @@
 
 #include "HexCoding.h"
 #include "Nano/Signer.h"
+#include "Nano/Work.h"
 
 #include "TestAccounts.h"
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 using namespace TW;
 
@@ -109,6 +111,53 @@ TEST(NanoSigner, sign4) {
     ASSERT_EQ(hex(signature), "bcb806e140c9e2bc71c51ebbd941b4d99cee3d97fd50e3006eabc5e325c712662e2dc163ee32660875d67815ce4721e122389d2e64f1c9ad4555a9d3d8c33802");
 }
 
+TEST(NanoSigner, signGenerateWork) {
+    const auto privateKey = PrivateKey(parse_hex(kPrivateKey), TWCurveED25519Blake2bNano);
+    const auto parentBlock = parse_hex("1ca240212838d053ecaa9dceee598c52a6080067edecaeede3319eb0b7db6525");
+
+    auto input = Proto::SigningInput();
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+    input.set_parent_block(parentBlock.data(), parentBlock.size());
+    input.set_link_recipient("xrb_3wm37qz19zhei7nzscjcopbrbnnachs4p1gnwo5oroi3qonw6inwgoeuufdp");
+    input.set_representative(kRepNanode);
+    input.set_balance("126242336390000000000000000000");
+    // low threshold, to keep the test fast
+    const uint64_t threshold = 0xfff0000000000000;
+    input.set_work_threshold(threshold);
+
+    const auto out = Signer::sign(input);
+    EXPECT_EQ(hex(out.block_hash()), "32ac7d8f5a16a498abf203b8dfee623c9e111ff25e7339f8cd69ec7492b23edd");
+    const auto work = nlohmann::json::parse(out.json())["work"].get<std::string>();
+    ASSERT_EQ(work.size(), 16ul);
+    std::array<byte, 32> root;
+    std::copy(parentBlock.begin(), parentBlock.end(), root.begin());
+    EXPECT_GE(workDifficulty(std::stoull(work, nullptr, 16), root), threshold);
+
+    // a given work is kept
+    input.set_work("123456789");
+    EXPECT_EQ(nlohmann::json::parse(Signer::sign(input).json())["work"].get<std::string>(), "123456789");
+}
+
+TEST(NanoSigner, signGenerateWorkTimeout) {
+    const auto privateKey = PrivateKey(parse_hex(kPrivateKey), TWCurveED25519Blake2bNano);
+    const auto parentBlock = parse_hex("1ca240212838d053ecaa9dceee598c52a6080067edecaeede3319eb0b7db6525");
+
+    auto input = Proto::SigningInput();
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+    input.set_parent_block(parentBlock.data(), parentBlock.size());
+    input.set_link_recipient("xrb_3wm37qz19zhei7nzscjcopbrbnnachs4p1gnwo5oroi3qonw6inwgoeuufdp");
+    input.set_representative(kRepNanode);
+    input.set_balance("126242336390000000000000000000");
+    // unreachable threshold
+    input.set_work_threshold(0xffffffffffffffff);
+    input.set_work_timeout_ms(1);
+
+    const auto out = Signer::sign(input);
+    EXPECT_EQ(out.error(), Common::Proto::Error_general);
+    EXPECT_EQ(out.error_message(), "Work generation timed out");
+    EXPECT_TRUE(out.json().empty());
+}
+
 TEST(NanoSigner, signInvalid1) {
     const auto privateKey = PrivateKey(parse_hex(kPrivateKey), TWCurveED25519Blake2bNano);
 
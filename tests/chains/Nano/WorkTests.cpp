@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Nano/Work.h"
+
+#include "BinaryCoding.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Nano::tests {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+const auto gRoot = parse_hex("1ca240212838d053ecaa9dceee598c52a6080067edecaeede3319eb0b7db6525");
+
+std::array<byte, 32> root() {
+    std::array<byte, 32> result;
+    std::copy(gRoot.begin(), gRoot.end(), result.begin());
+    return result;
+}
+
+} // namespace
+
+TEST(NanoWork, Difficulty) {
+    for (const uint64_t work : {0ull, 1ull, 0x2bf29ef00786a6bcull, 0xffffffffffffffffull}) {
+        Data message;
+        encode64LE(work, message);
+        append(message, gRoot);
+        const auto hash = Hash::blake2b(message, 8);
+        EXPECT_EQ(workDifficulty(work, root()), decode64LE(hash.data())) << work;
+    }
+}
+
+TEST(NanoWork, Generate) {
+    const uint64_t threshold = 0xffff000000000000;
+    for (const std::size_t threads : {1, 4}) {
+        WorkOptions options;
+        options.threads = threads;
+        // ~2^16 hashes are expected, so hitting the bound means the search is broken rather than slow
+        options.timeout = 30s;
+        const auto work = generateWork(root(), threshold, options);
+        ASSERT_TRUE(work.has_value()) << "timed out with " << threads << " threads";
+        EXPECT_GE(workDifficulty(*work, root()), threshold);
+    }
+}
+
+TEST(NanoWork, Timeout) {
+    WorkOptions options;
+    options.threads = 2;
+    options.timeout = 20ms;
+    EXPECT_FALSE(generateWork(root(), 0xffffffffffffffff, options).has_value());
+}
+
+TEST(NanoWork, Cancel) {
+    const std::atomic<bool> cancel = true;
+    WorkOptions options;
+    options.cancel = &cancel;
+    EXPECT_FALSE(generateWork(root(), 0xffffffffffffffff, options).has_value());
+}
+
+} // namespace TW::Nano::tests
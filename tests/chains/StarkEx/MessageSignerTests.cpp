@@ -4,6 +4,7 @@
 
 #include <StarkEx/MessageSigner.h>
 #include <HexCoding.h>
+#include <TrustWalletCore/TWStarkExKeyContext.h>
 #include <TrustWalletCore/TWStarkExMessageSigner.h>
 #include <TrustWalletCore/TWPrivateKey.h>
 #include "TestUtilities.h"
@@ -32,4 +33,28 @@ TEST(TWStarkExMessageSigner, SignAndVerify) {
     delete pubKey;
 }
 
+TEST(StarkExMessageSigner, SignWithContext) {
+    PrivateKey starkPrivKey(parse_hex("04be51a04e718c202e4dca60c2b72958252024cfc1070c090dd0f170298249de", true));
+    const KeyContext context(starkPrivKey);
+    EXPECT_EQ(hex(context.publicKey().bytes), hex(starkPrivKey.getPublicKey(TWPublicKeyTypeStarkex).bytes));
+    auto starkMsg = "463a2240432264a3aa71a5713f2a4e4c1b9e12bbb56083cd56af6d878217cf";
+    for (auto i = 0; i < 2; ++i) {
+        const auto starkSignature = StarkEx::MessageSigner::signMessage(context, starkMsg);
+        EXPECT_EQ(starkSignature, "04cf5f21333dd189ada3c0f2a51430d733501a9b1d5e07905273c1938cfb261e05b6013d74adde403e8953743a338c8d414bb96bf69d2ca1a91a85ed2700a528");
+    }
+}
+
+TEST(TWStarkExMessageSigner, SignWithContext) {
+    const auto privKeyData = "04be51a04e718c202e4dca60c2b72958252024cfc1070c090dd0f170298249de";
+    const auto privateKey = WRAP(TWPrivateKey, TWPrivateKeyCreateWithData(DATA(privKeyData).get()));
+    const auto context = WRAP(TWStarkExKeyContext, TWStarkExKeyContextCreate(privateKey.get()));
+    ASSERT_NE(context.get(), nullptr);
+    const auto message = STRING("463a2240432264a3aa71a5713f2a4e4c1b9e12bbb56083cd56af6d878217cf");
+
+    const auto pubKey = WRAP(TWPublicKey, TWStarkExKeyContextPublicKey(context.get()));
+    const auto signature = WRAPS(TWStarkExMessageSignerSignMessageWithContext(context.get(), message.get()));
+    EXPECT_EQ(std::string(TWStringUTF8Bytes(signature.get())), "04cf5f21333dd189ada3c0f2a51430d733501a9b1d5e07905273c1938cfb261e05b6013d74adde403e8953743a338c8d414bb96bf69d2ca1a91a85ed2700a528");
+    EXPECT_TRUE(TWStarkExMessageSignerVerifyMessage(pubKey.get(), message.get(), signature.get()));
+}
+
 }
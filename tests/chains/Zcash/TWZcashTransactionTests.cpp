@@ -98,6 +98,66 @@ TEST(TWZcashTransaction, Encode) {
     EXPECT_EQ(hex(sighash), "1e747b6a4a96aa9e7c1d7968221ec916bd30b514f8bca14b6f74d7c11c0742c2");
 }
 
+TEST(TWZcashTransaction, PrecomputedSignatureHash) {
+    auto transaction = Zcash::Transaction();
+    transaction.lockTime = 0x0004b029;
+    transaction.expiryHeight = 0x0004b048;
+    transaction.branchId = Zcash::SaplingBranchID;
+    for (auto i = 0u; i < 3; ++i) {
+        auto outpoint = Bitcoin::OutPoint(parse_hex("a8c685478265f4c14dada651969c45a65e1aeb8cd6791f2f5bb6a1d9952104d9"), i);
+        transaction.inputs.emplace_back(outpoint, Bitcoin::Script(), 0xfffffffe);
+    }
+    transaction.outputs.emplace_back(0x02625a00, Bitcoin::Script(parse_hex("76a9148132712c3ff19f3a151234616777420a6d7ef22688ac")));
+    transaction.outputs.emplace_back(0x0098958b, Bitcoin::Script(parse_hex("76a9145453e4698f02a38abdaa521cd1ff2dee6fac187188ac")));
+
+    const auto scriptCode = Bitcoin::Script(parse_hex("76a914507173527b4c3318a2aecd793bf1cfed705950cf88ac"));
+    // Hashes of every input; the third one has no matching output for Single
+    const std::vector<std::pair<TWBitcoinSigHashType, std::vector<std::string>>> expected = {
+        {TWBitcoinSigHashTypeAll, {
+            "b3299089c6364ff9542372ce0023c8ce0f1da9fd0fe73f7eb769d483f4c8cecb",
+            "22096a91bd88b82f148bed02f2e3eed1108d10233cc9be3931d4907b3186ad9d",
+            "63b7af58cba33c624d3239be6fb596df540d10d51a8404ec9327102249977a24",
+        }},
+        {TWBitcoinSigHashTypeNone, {
+            "aebe439a6afaad091f3487f593d2b7bb7d102b5855e319aeb8ba3abb8e2bdc01",
+            "524b1a0e72f8c18b023c101c743073ef3dfe504b5531b79ab4931bb42b99bd65",
+            "c2253332114d9cbd64d8f8b4bcdbbc5f84da809c2949f4d2bb55a9f0790c244b",
+        }},
+        {TWBitcoinSigHashTypeSingle, {
+            "5427ae2823ce2d91e4f36c314f7fbc23bb3d8be551a13623ef147993e49bc8a0",
+            "0068c7c2607e0b0ca9b8759155728dc279f6367bec64a876bc8daa0c1b933dd7",
+            "8cf6663185a265549623d7404467dfccd151f7b1c8612819841d3625d0510fc5",
+        }},
+        {TWBitcoinSigHashType(TWBitcoinSigHashTypeAnyoneCanPay | TWBitcoinSigHashTypeAll), {
+            "4b33303f1f952befa3f6bc17d948301d52bc7729144118b07f46e0920d40503c",
+            "310c0c94e32f685d7656edf030bef15e443119cd0ea341dbe5bde9ffb342df67",
+            "6f176075744af50376f71fefffedcb65d023a7d98b56763753f181fa51a7d4cc",
+        }},
+        {TWBitcoinSigHashType(TWBitcoinSigHashTypeAnyoneCanPay | TWBitcoinSigHashTypeNone), {
+            "acc8442f5ca46964a3b26ce3fc23356c3d5dfd9fa6fc2657daaffe981a33c332",
+            "5ccea8d6d22d2b81d16e05e8f04b226bf60326c025e9f8b4e32ce8736cb5a5ad",
+            "92c63a6964ecdd939e66e57ed29e9b158be34e8e8717b82e72f99ec0ed77a208",
+        }},
+        {TWBitcoinSigHashType(TWBitcoinSigHashTypeAnyoneCanPay | TWBitcoinSigHashTypeSingle), {
+            "4dd5d5567d62a6a7917317b7e82794da723e695d297ff9d611c30d641d549371",
+            "f61c7f9b38b5bd5ccee9e33e47033ad765fcb34e54b2c9520c6b1d4bee48465b",
+            "5b8a4878e2217f17de9488d59f8ba28b576bb9fdfdd518af20331b02af22bbdb",
+        }},
+    };
+
+    // Without, then with the precomputed hashes
+    for (auto precomputed : {false, true}) {
+        if (precomputed) {
+            transaction.precomputeSighash();
+        }
+        for (const auto& [hashType, hashes] : expected) {
+            for (auto index = 0ul; index < hashes.size(); ++index) {
+                EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, index, hashType, 0x02faf080, Bitcoin::BASE)), hashes[index]) << hashType << " " << index;
+            }
+        }
+    }
+}
+
 TEST(TWZcashTransaction, SaplingSigning) {
     // tx on mainnet
     // https://explorer.zcha.in/transactions/ec9033381c1cc53ada837ef9981c03ead1c7c41700ff3a954389cfaddc949256
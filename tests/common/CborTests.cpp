@@ -517,5 +517,215 @@ TEST(Cbor, GetTagElementNotTag) {
     }
     FAIL() << "Expected exception";
 }
+
+TEST(Cbor, WriterSample1) {
+    Writer cbor;
+    cbor.array(2)
+        .uint(5)
+        .map(2)
+            .string("x").uint(100)
+            .string("y").negInt(50);
+    EXPECT_EQ("8205a26178186461793831", hex(cbor.encoded()));
+}
+
+TEST(Cbor, WriterMatchesEncode) {
+    const auto encode = Encode::array({
+        Encode::uint(0),
+        Encode::uint(24),
+        Encode::uint(0x1234),
+        Encode::uint(0x12345678),
+        Encode::uint(0x123456789a),
+        Encode::negInt(0),
+        Encode::negInt(1000),
+        Encode::string(""),
+        Encode::bytes(Data(300, 0xab)),
+        Encode::tag(24, Encode::bytes(parse_hex("0102"))),
+        Encode::null(),
+        Encode::version(21),
+    });
+    Writer cbor;
+    cbor.array(12)
+        .uint(0)
+        .uint(24)
+        .uint(0x1234)
+        .uint(0x12345678)
+        .uint(0x123456789a)
+        .negInt(0)
+        .negInt(1000)
+        .string("")
+        .bytes(Data(300, 0xab))
+        .tag(24).bytes(parse_hex("0102"))
+        .null()
+        .version(21);
+    EXPECT_EQ(hex(encode.encoded()), hex(cbor.encoded()));
+}
+
+TEST(Cbor, WriterCanonicalMap) {
+    const auto encode = Encode::map({
+        make_pair(Encode::bytes(parse_hex("0102")), Encode::uint(1)),
+        make_pair(Encode::bytes(parse_hex("01")), Encode::array({Encode::uint(2), Encode::uint(3)})),
+        make_pair(Encode::uint(7), Encode::map({
+            make_pair(Encode::string("b"), Encode::uint(4)),
+            make_pair(Encode::string("a"), Encode::uint(5)),
+        })),
+    });
+    Writer cbor;
+    cbor.beginMap()
+        .bytes(parse_hex("0102")).uint(1)
+        .bytes(parse_hex("01")).array(2).uint(2).uint(3)
+        .uint(7).beginMap()
+            .string("b").uint(4)
+            .string("a").uint(5)
+        .endMap()
+    .endMap();
+    EXPECT_EQ(hex(encode.encoded()), hex(cbor.encoded()));
+    EXPECT_EQ("a307a2616105616204410182020342010201", hex(cbor.encoded()));
+}
+
+TEST(Cbor, WriterCanonicalMapDuplicateKeys) {
+    Writer cbor;
+    cbor.beginMap()
+        .uint(2).string("first")
+        .uint(1).uint(0)
+        .uint(2).string("second")
+    .endMap();
+    EXPECT_EQ("a2010002656669727374", hex(cbor.encoded()));
+    EXPECT_EQ(R"({1: 0, 2: "first"})", Decode(cbor.encoded()).dumpToString());
+}
+
+TEST(Cbor, WriterMapEmpty) {
+    Writer cbor;
+    cbor.beginMap().endMap();
+    EXPECT_EQ("a0", hex(cbor.encoded()));
+}
+
+TEST(Cbor, WriterArrayIndef) {
+    Writer cbor;
+    cbor.beginIndefArray()
+        .uint(1)
+        .beginMap().uint(1).uint(2).endMap()
+        .endIndefArray();
+    EXPECT_EQ("9f01a10102ff", hex(cbor.encoded()));
+    EXPECT_TRUE(Decode(cbor.encoded()).isValid());
+    EXPECT_EQ("9f01a10102ff", hex(cbor.release()));
+    EXPECT_EQ(0ul, cbor.size());
+}
+
+TEST(Cbor, WriterRaw) {
+    Writer cbor;
+    cbor.array(2).raw(Encode::uint(100).encoded()).null();
+    EXPECT_EQ("821864f6", hex(cbor.encoded()));
+}
+
+TEST(Cbor, WriterErrors) {
+    EXPECT_THROW(Writer().endMap(), invalid_argument);
+    EXPECT_THROW(Writer().endIndefArray(), invalid_argument);
+    EXPECT_THROW(Writer().beginIndefArray().endMap(), invalid_argument);
+    EXPECT_THROW(Writer().beginMap().endIndefArray(), invalid_argument);
+    EXPECT_THROW(Writer().beginMap().uint(1).encoded(), invalid_argument);
+    EXPECT_THROW(Writer().beginIndefArray().uint(1).encoded(), invalid_argument);
+    // key without value
+    EXPECT_THROW(Writer().beginMap().uint(1).uint(2).uint(3).endMap(), invalid_argument);
+}
+
+TEST(Cbor, ReaderSample1) {
+    const Data cbor = parse_hex("8205a26178186461793831");
+    Reader reader(cbor);
+    EXPECT_EQ(2ul, reader.readArray().value());
+    EXPECT_EQ(5ul, reader.readValue());
+    EXPECT_EQ(2ul, reader.readMap().value());
+    EXPECT_EQ("x", reader.readString());
+    EXPECT_EQ(100ul, reader.readValue());
+    EXPECT_EQ("y", reader.readString());
+    EXPECT_EQ(49ul, reader.readValue());
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(Cbor, ReaderSkip) {
+    const Data cbor = parse_hex("8301820203820405");
+    Reader reader(cbor);
+    EXPECT_EQ(3ul, reader.readArray().value());
+    EXPECT_EQ(Decode::MT_uint, reader.peek().majorType);
+    EXPECT_EQ(1ul, reader.readValue());
+    EXPECT_EQ("820203", hex(reader.skip()));
+    EXPECT_EQ(5ul, reader.position());
+    EXPECT_EQ(2ul, reader.readArray().value());
+    EXPECT_EQ(4ul, reader.readValue());
+    EXPECT_EQ(5ul, reader.readValue());
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(Cbor, ReaderBytesNoCopy) {
+    const Data cbor = parse_hex("824301020363616263");
+    Reader reader(cbor);
+    reader.readArray();
+    const auto bytes = reader.readBytes();
+    EXPECT_EQ("010203", hex(bytes));
+    EXPECT_EQ(cbor.data() + 2, bytes.data());
+    const auto str = reader.readString();
+    EXPECT_EQ("abc", str);
+    EXPECT_EQ(reinterpret_cast<const char*>(cbor.data() + 6), str.data());
+}
+
+TEST(Cbor, ReaderIndef) {
+    const Data cbor = parse_hex("9f01bf0102ff5f4201024103ffff");
+    Reader reader(cbor);
+    EXPECT_FALSE(reader.readArray().has_value());
+    EXPECT_FALSE(reader.readBreak());
+    EXPECT_EQ(1ul, reader.readValue());
+    EXPECT_FALSE(reader.readMap().has_value());
+    EXPECT_EQ(1ul, reader.readValue());
+    EXPECT_EQ(2ul, reader.readValue());
+    EXPECT_TRUE(reader.readBreak());
+    // chunked bytes can only be skipped
+    EXPECT_THROW(Reader(reader).readBytes(), invalid_argument);
+    EXPECT_EQ("5f4201024103ff", hex(reader.skip()));
+    EXPECT_TRUE(reader.readBreak());
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_TRUE(Decode(cbor).isValid());
+}
+
+TEST(Cbor, ReaderTagSpecial) {
+    const Data cbor = parse_hex("83d818420102f6f815");
+    Reader reader(cbor);
+    reader.readArray();
+    EXPECT_EQ(24ul, reader.readTag());
+    EXPECT_EQ("0102", hex(reader.readBytes()));
+    EXPECT_EQ(0x16ul, reader.readSpecial());
+    EXPECT_EQ(21ul, reader.readSpecial());
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(Cbor, ReaderErrors) {
+    const Data uint = parse_hex("1864");
+    EXPECT_THROW(Reader(uint).readBytes(), invalid_argument);
+    EXPECT_THROW(Reader(uint).readArray(), invalid_argument);
+    const Data tooShort = parse_hex("43010");
+    EXPECT_THROW(Reader(tooShort).readBytes(), invalid_argument);
+    const Data empty;
+    EXPECT_THROW(Reader(empty).readValue(), invalid_argument);
+    EXPECT_THROW(Reader(empty).readBreak(), invalid_argument);
+    const Data unexpectedBreak = parse_hex("ff");
+    EXPECT_THROW(Reader(unexpectedBreak).skip(), invalid_argument);
+    EXPECT_FALSE(Decode(unexpectedBreak).isValid());
+}
+
+TEST(Cbor, ReaderRejectsDeepNesting) {
+    Data cbor(Reader::maxDepth + 1, 0x81);
+    cbor.push_back(0x00);
+    EXPECT_THROW(Reader(cbor).skip(), invalid_argument);
+    EXPECT_FALSE(Decode(cbor).isValid());
+
+    Data shallow(Reader::maxDepth, 0x81);
+    shallow.push_back(0x00);
+    EXPECT_EQ(shallow.size(), Reader(shallow).skip().size());
+}
+
+TEST(Cbor, ReaderRejectsHugeCount) {
+    // array claiming 2^32 elements, with only 2 present
+    const Data cbor = parse_hex("9b00000001000000000102");
+    EXPECT_THROW(Reader(cbor).skip(), invalid_argument);
+    EXPECT_FALSE(Decode(cbor).isValid());
+}
 // clang-format on
 } // namespace TW::Cbor::tests
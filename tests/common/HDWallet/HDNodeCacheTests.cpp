@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "HDNodeCache.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace TW::HDNodeCacheTests {
+
+const auto mnemonic1 = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+HDNode makeNode(uint8_t fill) {
+    HDNode node{};
+    node.depth = fill;
+    std::fill(std::begin(node.private_key), std::end(node.private_key), fill);
+    return node;
+}
+
+TEST(HDNodeCache, LongestPrefix) {
+    HDNodeCache cache;
+    const std::vector<uint32_t> path = {0x8000002c, 0x80000000, 0x80000000, 0, 5};
+    cache.insert(TWCurveSECP256k1, path, 2, makeNode(2));
+    cache.insert(TWCurveSECP256k1, path, 3, makeNode(3));
+    EXPECT_EQ(cache.size(), 2ul);
+
+    HDNode node{};
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveSECP256k1, path, 4, node), 3ul);
+    EXPECT_EQ(node.depth, 3u);
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveSECP256k1, path, 2, node), 2ul);
+    EXPECT_EQ(node.depth, 2u);
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveSECP256k1, path, 1, node), 0ul);
+    // different curve, same path
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveNIST256p1, path, 4, node), 0ul);
+    // different account
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveSECP256k1, {0x8000002c, 0x80000000, 0x80000001, 0, 5}, 4, node), 2ul);
+}
+
+TEST(HDNodeCache, EvictsLeastRecentlyUsed) {
+    HDNodeCache cache(2);
+    cache.insert(TWCurveSECP256k1, {1}, 1, makeNode(1));
+    cache.insert(TWCurveSECP256k1, {2}, 1, makeNode(2));
+
+    HDNode node{};
+    // touch {1}, so that {2} is evicted next
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveSECP256k1, {1}, 1, node), 1ul);
+    cache.insert(TWCurveSECP256k1, {3}, 1, makeNode(3));
+    EXPECT_EQ(cache.size(), 2ul);
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveSECP256k1, {1}, 1, node), 1ul);
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveSECP256k1, {2}, 1, node), 0ul);
+    EXPECT_EQ(cache.findLongestPrefix(TWCurveSECP256k1, {3}, 1, node), 1ul);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0ul);
+}
+
+TEST(HDNodeCache, CopyIsEmpty) {
+    HDNodeCache cache(8);
+    cache.insert(TWCurveSECP256k1, {1}, 1, makeNode(1));
+    HDNodeCache copy(cache);
+    EXPECT_EQ(copy.size(), 0ul);
+    EXPECT_EQ(copy.maxSize(), 8ul);
+}
+
+TEST(HDNodeCache, RootsAreNotEvicted) {
+    HDNodeCache cache(1);
+    cache.insertRoot(TWCurveED25519ExtendedCardano, makeNode(7));
+    cache.insert(TWCurveSECP256k1, {1}, 1, makeNode(1));
+    cache.insert(TWCurveSECP256k1, {2}, 1, makeNode(2));
+    EXPECT_EQ(cache.size(), 1ul);
+
+    HDNode node{};
+    ASSERT_TRUE(cache.findRoot(TWCurveED25519ExtendedCardano, node));
+    EXPECT_EQ(node.depth, 7u);
+    EXPECT_FALSE(cache.findRoot(TWCurveSECP256k1, node));
+
+    cache.clear();
+    EXPECT_FALSE(cache.findRoot(TWCurveED25519ExtendedCardano, node));
+}
+
+TEST(HDNodeCache, CardanoDerivationUnchanged) {
+    const auto wallet = HDWallet(mnemonic1, "");
+    for (auto i = 0u; i < 5; ++i) {
+        const auto path = DerivationPath(TWPurposeBIP1852, 1815, 0, 0, i);
+        const auto cached = wallet.getKey(TWCoinTypeCardano, path);
+        const auto uncached = HDWallet(wallet).getKey(TWCoinTypeCardano, path);
+        EXPECT_EQ(hex(cached.bytes), hex(uncached.bytes));
+    }
+}
+
+TEST(HDNodeCache, WalletDerivationUnchanged) {
+    const auto wallet = HDWallet(mnemonic1, "");
+    for (auto i = 0u; i < 20; ++i) {
+        const auto path = DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(TWCoinTypeBitcoin), 0, 0, i);
+        const auto cached = wallet.getKey(TWCoinTypeBitcoin, path);
+        // fresh copy has an empty cache, derives from the master node
+        const auto uncached = HDWallet(wallet).getKey(TWCoinTypeBitcoin, path);
+        EXPECT_EQ(hex(cached.bytes), hex(uncached.bytes));
+    }
+}
+
+TEST(HDNodeCache, ConcurrentDerivation) {
+    const auto wallet = HDWallet(mnemonic1, "");
+    constexpr auto count = 16u;
+    std::vector<std::string> expected;
+    for (auto i = 0u; i < count; ++i) {
+        expected.push_back(hex(HDWallet(wallet).getKey(TWCoinTypeEthereum, DerivationPath(TWPurposeBIP44, 60, 0, 0, i)).bytes));
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<std::vector<std::string>> results(4);
+    for (auto t = 0u; t < results.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (auto i = 0u; i < count; ++i) {
+                results[t].push_back(hex(wallet.getKey(TWCoinTypeEthereum, DerivationPath(TWPurposeBIP44, 60, 0, 0, i)).bytes));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& result : results) {
+        EXPECT_EQ(result, expected);
+    }
+}
+
+} // namespace TW::HDNodeCacheTests
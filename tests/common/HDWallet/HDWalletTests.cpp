@@ -24,6 +24,7 @@
 #include "TrustWalletCore/TWEthereum.h"
 
 #include <gtest/gtest.h>
+#include <set>
 
 extern std::string TESTS_ROOT;
 
@@ -248,6 +249,35 @@ TEST(HDWallet, privateKeyFromXPRVForDGB) {
     EXPECT_EQ(address.string(), "D9Gv7jWSVsS9Y5q98C79WyfEj6P2iM5Nzs");
 }
 
+TEST(HDWallet, DeriveAddresses) {
+    const HDWallet wallet = HDWallet(mnemonic1, "");
+    for (auto coin : {TWCoinTypeBitcoin, TWCoinTypeLitecoin, TWCoinTypeEthereum, TWCoinTypeSmartChain, TWCoinTypePolygon, TWCoinTypeNEO, TWCoinTypeCosmos}) {
+        for (auto change : {0u, 1u}) {
+            const auto addresses = wallet.deriveAddresses(coin, 1, change, 0, 10);
+            ASSERT_EQ(addresses.size(), 10ul);
+            for (auto i = 0u; i < addresses.size(); ++i) {
+                const auto key = wallet.getKey(coin, DerivationPath(TW::purpose(coin), TW::slip44Id(coin), 1, change, i));
+                EXPECT_EQ(addresses[i], TW::deriveAddress(coin, key)) << TW::slip44Id(coin) << " " << i;
+            }
+        }
+    }
+
+    // ed25519 has hardened derivation only
+    for (auto coin : {TWCoinTypeStellar, TWCoinTypeSolana, TWCoinTypeNano}) {
+        const auto addresses = wallet.deriveAddresses(coin, 0, 0, 3, 5);
+        ASSERT_EQ(addresses.size(), 5ul);
+        EXPECT_EQ(std::set<std::string>(addresses.begin(), addresses.end()).size(), addresses.size());
+        for (auto i = 0u; i < addresses.size(); ++i) {
+            const auto path = DerivationPath("m/" + std::to_string(TW::purpose(coin)) + "'/" + std::to_string(TW::slip44Id(coin)) + "'/0'/0'/" + std::to_string(3 + i) + "'");
+            EXPECT_EQ(addresses[i], TW::deriveAddress(coin, wallet.getKey(coin, path))) << TW::slip44Id(coin) << " " << i;
+        }
+    }
+    EXPECT_TRUE(wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 0, 5, 0).empty());
+    EXPECT_THROW(wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 0, 0x7fffffff, 2), std::invalid_argument);
+    EXPECT_THROW(wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 2, 0, 2), std::invalid_argument);
+    EXPECT_THROW(wallet.deriveAddresses(TWCoinTypeSolana, 0, 0x80000000, 0, 2), std::invalid_argument);
+}
+
 TEST(HDWallet, DeriveWithLeadingZerosEth) {
     // Derivation test case with leading zeroes, see  https://blog.polychainlabs.com/bitcoin,/bip32,/bip39,/kdf/2021/05/17/inconsistent-bip32-derivations.html
     const auto mnemonic = "name dash bleak force moral disease shine response menu rescue more will";
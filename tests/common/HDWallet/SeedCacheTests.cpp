@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "HDWallet.h"
+#include "HexCoding.h"
+#include "SeedCache.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace TW::SeedCacheTests {
+
+const auto mnemonic1 = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+const auto seed1 = "143cd5fc27ae46eb423efebc41610473f5e24a80f2ca2e2fa7bf167e537f58f4c68310ae487fce82e25bad29bab2530cf77fd724a5ebfc05a45872773d7ee2d6";
+const auto seed1NoPassphrase = "354c22aedb9a37407adc61f657a6f00d10ed125efa360215f36c6919abd94d6dbc193a5f9c495e21ee74118661e327e84a5f5f11fa373ec33b80897d4697557d";
+
+std::string seedHex(SeedCache& cache, const std::string& mnemonic, const std::string& passphrase) {
+    SeedCache::Seed seed{};
+    cache.mnemonicToSeed(mnemonic, passphrase, seed);
+    return hex(seed);
+}
+
+TEST(SeedCache, HitReturnsSameSeed) {
+    SeedCache cache;
+    EXPECT_EQ(seedHex(cache, mnemonic1, "passphrase"), seed1);
+    EXPECT_EQ(cache.size(), 1ul);
+    EXPECT_EQ(seedHex(cache, mnemonic1, "passphrase"), seed1);
+    EXPECT_EQ(cache.size(), 1ul);
+    // the passphrase is part of the key
+    EXPECT_EQ(seedHex(cache, mnemonic1, ""), seed1NoPassphrase);
+    EXPECT_EQ(cache.size(), 2ul);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0ul);
+    EXPECT_EQ(seedHex(cache, mnemonic1, ""), seed1NoPassphrase);
+}
+
+TEST(SeedCache, Capacity) {
+    SeedCache cache(0);
+    EXPECT_EQ(seedHex(cache, mnemonic1, ""), seed1NoPassphrase);
+    EXPECT_EQ(cache.size(), 0ul);
+
+    cache.setCapacity(SeedCache::shardCount);
+    for (int i = 0; i < 40; ++i) {
+        seedHex(cache, mnemonic1, std::to_string(i));
+    }
+    EXPECT_LE(cache.size(), SeedCache::shardCount);
+    EXPECT_GT(cache.size(), 0ul);
+
+    cache.setCapacity(0);
+    EXPECT_EQ(cache.maxSize(), 0ul);
+    EXPECT_EQ(cache.size(), 0ul);
+}
+
+TEST(SeedCache, WalletSeedUnchanged) {
+    SeedCache::shared().clear();
+    for (int i = 0; i < 2; ++i) {
+        const auto wallet = HDWallet(mnemonic1, "passphrase");
+        EXPECT_EQ(hex(wallet.getSeed()), seed1);
+    }
+}
+
+/// Many threads creating wallets from a few mnemonics through a cache smaller than the working set,
+/// so that lookups, inserts and evictions race. Meant to be run under ThreadSanitizer (TW_CLANG_TSAN).
+TEST(SeedCache, ConcurrentWallets) {
+    constexpr auto threadCount = 8;
+    constexpr auto iterations = 6;
+    const std::vector<std::string> passphrases = {"", "passphrase", "a", "b", "c", "d", "e", "f", "g", "h"};
+    std::vector<std::string> expected;
+    for (const auto& passphrase : passphrases) {
+        expected.push_back(hex(HDWallet(mnemonic1, passphrase).getSeed()));
+    }
+
+    SeedCache::shared().setCapacity(4);
+    std::vector<int> mismatches(threadCount, 0);
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            for (auto i = 0; i < iterations; ++i) {
+                const auto which = static_cast<std::size_t>(t + i) % passphrases.size();
+                const auto wallet = HDWallet(mnemonic1, passphrases[which]);
+                mismatches[t] += hex(wallet.getSeed()) != expected[which];
+                if (i % 3 == 2) {
+                    SeedCache::shared().clear();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    SeedCache::shared().setCapacity(SeedCache::defaultCapacity);
+
+    for (auto t = 0; t < threadCount; ++t) {
+        EXPECT_EQ(mismatches[t], 0) << "thread " << t;
+    }
+}
+
+} // namespace TW::SeedCacheTests
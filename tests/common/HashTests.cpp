@@ -3,6 +3,7 @@
 // Copyright © 2017 Trust Wallet.
 
 #include "Hash.h"
+#include "HashContext.h"
 #include "HexCoding.h"
 
 #include <gtest/gtest.h>
@@ -91,4 +92,119 @@ TEST(HashTests, allHashEnum) {
     }
 }
 
+TEST(HashTests, allHashEnumFixedOutput) {
+    const auto hashers = {
+        Hash::HasherSha1, Hash::HasherSha256, Hash::HasherSha512, Hash::HasherSha512_256,
+        Hash::HasherKeccak256, Hash::HasherKeccak512, Hash::HasherSha3_256, Hash::HasherSha3_512,
+        Hash::HasherRipemd, Hash::HasherBlake2b, Hash::HasherBlake256, Hash::HasherGroestl512,
+        Hash::HasherSha256d, Hash::HasherSha256ripemd, Hash::HasherSha3_256ripemd,
+        Hash::HasherBlake256d, Hash::HasherBlake256ripemd, Hash::HasherGroestl512d,
+    };
+    const Data input(1000, 0x5a);
+
+    for (auto hasher : hashers) {
+        for (const auto& data : {TW::data(""), TW::data(brownFox), input}) {
+            Hash::Digest<Hash::maxHashSize> digest;
+            const auto size = Hash::hash(hasher, data, digest);
+            EXPECT_EQ(hex(Data(digest.begin(), digest.begin() + size)), hex(Hash::hash(hasher, data))) << hasher;
+        }
+    }
+}
+
+TEST(HashTests, Blake2bFixedOutput) {
+    const auto content = TW::data("the same content");
+    const auto personal = TW::data("MyApp Files Hash");
+
+    Hash::Digest<64> digest;
+    Hash::blake2b(content.data(), content.size(), digest);
+    EXPECT_EQ(hex(digest), hex(Hash::blake2b(content, 64)));
+
+    Hash::Digest<32> personalized;
+    Hash::blake2b(content.data(), content.size(), personalized, personal);
+    EXPECT_EQ(hex(personalized), "20d9cd024d4fb086aae819a1432dd2466de12947831b75c5a30cf2676095d3b4");
+}
+
+template <typename Context>
+void expectStreamingMatches(Hash::Hasher hasher) {
+    Data input(300);
+    for (auto i = 0ul; i < input.size(); ++i) {
+        input[i] = static_cast<TW::byte>(i);
+    }
+
+    // Feed the data in uneven chunks that straddle the block boundaries.
+    Context context;
+    for (std::size_t offset = 0, chunk = 1; offset < input.size(); offset += chunk, chunk = chunk * 3 + 1) {
+        context.update(input.data() + offset, std::min(chunk, input.size() - offset));
+    }
+    const auto digest = context.final();
+    EXPECT_EQ(hex(digest), hex(Hash::hash(hasher, input))) << hasher;
+
+    // The context can be reused after a reset.
+    context.reset();
+    EXPECT_EQ(hex(context.update(TW::data(brownFox)).final()), hex(Hash::hash(hasher, brownFox))) << hasher;
+}
+
+TEST(HashTests, StreamingContexts) {
+    expectStreamingMatches<Hash::Sha1Context>(Hash::HasherSha1);
+    expectStreamingMatches<Hash::Sha256Context>(Hash::HasherSha256);
+    expectStreamingMatches<Hash::Sha512Context>(Hash::HasherSha512);
+    expectStreamingMatches<Hash::Keccak256Context>(Hash::HasherKeccak256);
+    expectStreamingMatches<Hash::Keccak512Context>(Hash::HasherKeccak512);
+    expectStreamingMatches<Hash::Sha3_256Context>(Hash::HasherSha3_256);
+    expectStreamingMatches<Hash::Sha3_512Context>(Hash::HasherSha3_512);
+    expectStreamingMatches<Hash::RipemdContext>(Hash::HasherRipemd);
+    expectStreamingMatches<Hash::Blake256Context>(Hash::HasherBlake256);
+    expectStreamingMatches<Hash::Groestl512Context>(Hash::HasherGroestl512);
+}
+
+TEST(HashTests, StreamingContextCopy) {
+    Hash::Sha256Context prefix;
+    prefix.update(TW::data("The quick brown fox "));
+
+    auto copy = prefix;
+    EXPECT_EQ(hex(copy.update(TW::data("jumps over the lazy dog")).final()), hex(Hash::sha256(brownFox)));
+    EXPECT_EQ(hex(prefix.update(TW::data("jumps over the lazy dog.")).final()), hex(Hash::sha256(brownFoxDot)));
+}
+
+TEST(HashTests, StreamingBlake2b) {
+    const auto personal = TW::data("MyApp Files Hash");
+    Hash::Blake2bContext context(32, personal);
+    context.update(TW::data("the same ")).update(TW::data("content"));
+    Hash::Digest<32> digest;
+    context.final(digest);
+    EXPECT_EQ(hex(digest), "20d9cd024d4fb086aae819a1432dd2466de12947831b75c5a30cf2676095d3b4");
+
+    EXPECT_THROW(Hash::Blake2bContext(32, TW::data("short")), std::invalid_argument);
+    Hash::Digest<64> wrongSize;
+    EXPECT_THROW(Hash::Blake2bContext(32).final(wrongSize), std::invalid_argument);
+}
+
+TEST(HashTests, Batch) {
+    // lengths around the SHA256 (64) and Keccak256 (136) block and padding boundaries
+    vector<Data> inputs;
+    for (auto size = 0ul; size < 300; size += 1) {
+        inputs.emplace_back(size, static_cast<TW::byte>(size));
+    }
+    vector<span<const TW::byte>> spans(inputs.begin(), inputs.end());
+
+    const auto hashers = {
+        Hash::HasherSha256, Hash::HasherKeccak256, Hash::HasherSha256d, Hash::HasherSha256ripemd,
+        Hash::HasherRipemd, Hash::HasherBlake2b, Hash::HasherSha512,
+    };
+    for (auto hasher : hashers) {
+        const auto hashSize = Hash::hashSize(hasher);
+        for (auto count : {1ul, 3ul, 8ul, 13ul, spans.size()}) {
+            Data out(count * hashSize);
+            Hash::batch(hasher, span(spans).first(count), out);
+            for (auto i = 0ul; i < count; ++i) {
+                const Data digest(out.begin() + i * hashSize, out.begin() + (i + 1) * hashSize);
+                ASSERT_EQ(hex(digest), hex(Hash::hash(hasher, inputs[i]))) << hasher << " " << count << " " << i;
+            }
+        }
+    }
+
+    Data tooSmall(31);
+    EXPECT_THROW(Hash::batch(Hash::HasherSha256, span(spans).first(1), tooSmall), std::invalid_argument);
+}
+
 // More tests in TWHashTests
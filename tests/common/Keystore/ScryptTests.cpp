@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Keystore/Scrypt.h"
+
+#include "HexCoding.h"
+
+#include <TrezorCrypto/scrypt.h>
+
+#include <gtest/gtest.h>
+
+namespace TW::Keystore::tests {
+
+// https://www.rfc-editor.org/rfc/rfc7914#section-12
+TEST(Scrypt, RFC7914) {
+    const auto params = ScryptParameters(TW::data("NaCl"), 1024, 8, 16, 64);
+    const auto expected = "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640";
+    for (const std::size_t threads : {1, 2, 3, 16, 0}) {
+        Data derivedKey(64);
+        deriveScryptKey(TW::data("password"), params, derivedKey, threads);
+        EXPECT_EQ(hex(derivedKey), expected) << threads << " threads";
+    }
+}
+
+TEST(Scrypt, RFC7914SingleLane) {
+    const auto params = ScryptParameters(Data(), 16, 1, 1, 64);
+    Data derivedKey(64);
+    deriveScryptKey(Data(), params, derivedKey, 4);
+    EXPECT_EQ(hex(derivedKey), "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906");
+}
+
+TEST(Scrypt, SameAsSequential) {
+    const auto password = TW::data("password");
+    const auto params = ScryptParameters(parse_hex("ab0c7876052600dd703518d6fc3fe8984592145b591fc8fb5c6d43190334ba19"), ScryptParameters::minimalN, ScryptParameters::defaultR, ScryptParameters::minimalP, ScryptParameters::defaultDesiredKeyLength);
+    Data expected(params.desiredKeyLength);
+    ASSERT_EQ(scrypt(password.data(), password.size(), params.salt.data(), params.salt.size(), params.n, params.r, params.p, expected.data(), expected.size()), 0);
+
+    Data derivedKey(params.desiredKeyLength);
+    deriveScryptKey(password, params, derivedKey, 4);
+    EXPECT_EQ(hex(derivedKey), hex(expected));
+}
+
+} // namespace TW::Keystore::tests
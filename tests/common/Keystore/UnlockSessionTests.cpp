@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Keystore/UnlockSession.h"
+#include "Keystore/StoredKey.h"
+
+#include "HexCoding.h"
+#include "TestUtilities.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+
+#if defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#endif
+
+namespace TW::Keystore::tests {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+const auto gPassword = TW::data(std::string("password"));
+const auto gMnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+const auto gPrivateKey = parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
+
+#if defined(__linux__)
+/// Memory locked by the process, in kB
+std::size_t lockedMemory() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmLck:", 0) == 0) {
+            return std::stoul(line.substr(6));
+        }
+    }
+    return 0;
+}
+#endif
+
+} // namespace
+
+TEST(UnlockSession, Mnemonic) {
+    auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
+    const UnlockSession session(key, gPassword, 1min);
+    EXPECT_FALSE(session.isExpired());
+
+    EXPECT_EQ(key.wallet(session)->getMnemonic(), gMnemonic);
+    // the wallet is the one of the session, not a copy
+    EXPECT_EQ(key.wallet(session), session.wallet(key.payload));
+    EXPECT_EQ(hex(key.privateKey(TWCoinTypeBitcoin, session).bytes), hex(key.privateKey(TWCoinTypeBitcoin, gPassword).bytes));
+    EXPECT_EQ(hex(key.privateKey(TWCoinTypeSolana, TWDerivationSolanaSolana, session).bytes),
+              hex(key.privateKey(TWCoinTypeSolana, TWDerivationSolanaSolana, gPassword).bytes));
+    const auto data = session.decrypt(key.payload);
+    EXPECT_EQ(std::string(data.begin(), data.end()), gMnemonic);
+
+    // the wallet is created once
+    EXPECT_EQ(session.wallet(key.payload), session.wallet(key.payload));
+    key.fixAddresses(session);
+}
+
+TEST(UnlockSession, PrivateKey) {
+    auto key = StoredKey::createWithPrivateKeyAddDefaultAddress("name", gPassword, TWCoinTypeBitcoin, gPrivateKey);
+    const UnlockSession session(key, gPassword, 1min);
+
+    EXPECT_EQ(hex(key.privateKey(TWCoinTypeBitcoin, session).bytes), hex(gPrivateKey));
+    EXPECT_EQ(key.decryptPrivateKeyEncoded(session), hex(gPrivateKey));
+    EXPECT_THROW(key.wallet(session), std::invalid_argument);
+    key.fixAddresses(session);
+}
+
+TEST(UnlockSession, EncodedPrivateKey) {
+    const auto encoded = "A7psj2GW7ZMdY4E5hJq14KMeYg7HFjULSsWSrTXZLvYr";
+    auto key = StoredKey::createWithEncodedPrivateKeyAddDefaultAddress("name", gPassword, TWCoinTypeSolana, encoded);
+    {
+        const UnlockSession session(key, gPassword, 1min);
+        EXPECT_EQ(key.decryptPrivateKeyEncoded(session), encoded);
+        EXPECT_EQ(hex(key.privateKey(TWCoinTypeSolana, session).bytes), "8778cc93c6596387e751d2dc693bbd93e434bd233bc5b68a826c56131821cb63");
+    }
+
+    // encoded payload with its own salt
+    const auto encodedData = TW::data(std::string(encoded));
+    key.encodedPayload = EncryptedPayload(gPassword, encodedData, EncryptionParameters::getPreset(TWStoredKeyEncryptionLevelMinimal));
+    const UnlockSession session(key, gPassword, 1min);
+    EXPECT_EQ(key.decryptPrivateKeyEncoded(session), encoded);
+}
+
+TEST(UnlockSession, PBKDF2) {
+    const auto key = StoredKey::load(TESTS_ROOT + "/common/Keystore/Data/pbkdf2.json");
+    const UnlockSession session(key, TW::data("testpassword"), 1min);
+    EXPECT_EQ(hex(session.decrypt(key.payload)), "7a28b5ba57c53603b0b07b56bba752f7784bf506fa95edc395f5cf6c7514fe9d");
+}
+
+TEST(UnlockSession, InvalidPassword) {
+    const auto key = StoredKey::createWithPrivateKey("name", gPassword, gPrivateKey);
+    EXPECT_THROW(UnlockSession(key, TW::data("wrong"), 1min), DecryptionError);
+}
+
+TEST(UnlockSession, OtherKey) {
+    const auto key = StoredKey::createWithPrivateKey("name", gPassword, gPrivateKey);
+    auto otherKey = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
+    const UnlockSession session(key, gPassword, 1min);
+    try {
+        otherKey.wallet(session);
+        FAIL() << "Expected DecryptionError";
+    } catch (DecryptionError error) {
+        EXPECT_EQ(error, DecryptionError::invalidPassword);
+    }
+}
+
+TEST(UnlockSession, Expiry) {
+    auto key = StoredKey::createWithPrivateKey("name", gPassword, gPrivateKey);
+    const UnlockSession session(key, gPassword, 1h);
+    EXPECT_FALSE(session.isExpired());
+    EXPECT_EQ(hex(key.privateKey(TWCoinTypeBitcoin, session).bytes), hex(gPrivateKey));
+
+    // without lifetime, the session expires as soon as it is unlocked: the clock is monotonic
+    const UnlockSession expired(key, gPassword, UnlockSession::Clock::duration::zero());
+    EXPECT_TRUE(expired.isExpired());
+    // checking the expiry wipes the derived keys
+    EXPECT_FALSE(expired.isMemoryLocked());
+    try {
+        expired.decrypt(key.payload);
+        FAIL() << "Expected DecryptionError";
+    } catch (DecryptionError error) {
+        EXPECT_EQ(error, DecryptionError::sessionExpired);
+    }
+}
+
+TEST(UnlockSession, Lock) {
+    auto key = StoredKey::createWithMnemonic("name", gPassword, gMnemonic, TWStoredKeyEncryptionLevelDefault);
+    UnlockSession session(key, gPassword, 1min);
+    const auto wallet = session.wallet(key.payload);
+
+    session.lock();
+    EXPECT_TRUE(session.isExpired());
+    EXPECT_THROW(key.privateKey(TWCoinTypeBitcoin, session), DecryptionError);
+    // a wallet obtained before stays usable
+    EXPECT_EQ(wallet->getMnemonic(), gMnemonic);
+}
+
+TEST(UnlockSession, MemoryLock) {
+    const auto key = StoredKey::createWithPrivateKey("name", gPassword, gPrivateKey);
+    std::optional<UnlockSession> first;
+    first.emplace(key, gPassword, 1min);
+    UnlockSession second(key, gPassword, 1min);
+    const auto locked = first->isMemoryLocked() && second.isMemoryLocked();
+#if defined(__linux__)
+    const auto lockedBefore = lockedMemory();
+#endif
+
+    // each session locks pages of its own, ending one leaves the other locked
+    first.reset();
+    EXPECT_EQ(second.isMemoryLocked(), locked);
+#if defined(__linux__)
+    if (locked) {
+        EXPECT_EQ(lockedMemory(), lockedBefore - static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) / 1024);
+    }
+#endif
+
+    second.lock();
+    EXPECT_FALSE(second.isMemoryLocked());
+}
+
+} // namespace TW::Keystore::tests
@@ -366,3 +366,120 @@ TEST(PublicKeyTests, isValidED25519) {
     EXPECT_FALSE(PublicKey::isValid(parse_hex("0101beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"), TWPublicKeyTypeED25519));
     EXPECT_FALSE(PublicKey(parse_hex("0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1"), TWPublicKeyTypeSECP256k1).isValidED25519());
 }
+
+TEST(PublicKeyTests, Hashes) {
+    std::vector<PublicKey> compressed;
+    std::vector<PublicKey> extended;
+    for (auto i = 1; i <= 11; ++i) {
+        const auto privateKey = PrivateKey(Hash::sha256(Data{static_cast<byte>(i)}));
+        compressed.push_back(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1));
+        extended.push_back(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+    }
+    const auto prefix = parse_hex("00");
+
+    const auto ripemdHashes = PublicKey::hashes(compressed, prefix);
+    const auto keccakHashes = PublicKey::hashes(extended, {}, Hash::HasherKeccak256, true);
+    ASSERT_EQ(ripemdHashes.size(), compressed.size());
+    ASSERT_EQ(keccakHashes.size(), extended.size());
+    for (auto i = 0ul; i < compressed.size(); ++i) {
+        EXPECT_EQ(hex(ripemdHashes[i]), hex(compressed[i].hash(prefix)));
+        EXPECT_EQ(hex(keccakHashes[i]), hex(extended[i].hash({}, Hash::HasherKeccak256, true)));
+    }
+    EXPECT_TRUE(PublicKey::hashes({}, prefix).empty());
+}
+
+TEST(PublicKeyTests, VerifyBatch) {
+    std::vector<PublicKey> publicKeys;
+    std::vector<Data> signatures;
+    std::vector<Data> derSignatures;
+    std::vector<Data> digests;
+    for (auto i = 1; i <= 40; ++i) {
+        const auto curve = i % 3 == 0 ? TWCurveNIST256p1 : TWCurveSECP256k1;
+        const auto type = i % 3 == 0 ? TWPublicKeyTypeNIST256p1Extended : (i % 2 == 0 ? TWPublicKeyTypeSECP256k1 : TWPublicKeyTypeSECP256k1Extended);
+        const auto privateKey = PrivateKey(Hash::sha256(Data{static_cast<byte>(i)}), curve);
+        const auto digest = Hash::sha256(Data{static_cast<byte>(i), 0x01});
+        auto signature = privateKey.sign(digest);
+        // DER verification is secp256k1 only, the NIST256p1 entries are expected to fail
+        auto derSignature = curve == TWCurveSECP256k1 ? privateKey.signAsDER(digest) : signature;
+        if (i % 5 == 0) {
+            signature[10] ^= 0x01;
+            derSignature[10] ^= 0x01;
+        }
+        publicKeys.push_back(privateKey.getPublicKey(type));
+        signatures.push_back(signature);
+        derSignatures.push_back(derSignature);
+        digests.push_back(i % 11 == 0 ? Hash::sha256(digest) : digest);
+    }
+    // an ed25519 entry goes through `verify`
+    const auto ed25519Key = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"), TWCurveED25519);
+    publicKeys.push_back(ed25519Key.getPublicKey(TWPublicKeyTypeED25519));
+    signatures.push_back(ed25519Key.sign(digests[0]));
+    derSignatures.push_back(signatures.back());
+    digests.push_back(digests[0]);
+
+    for (auto threads : {1ul, 4ul, 0ul}) {
+        const auto verified = PublicKey::verifyBatch(publicKeys, signatures, digests, false, threads);
+        const auto verifiedDER = PublicKey::verifyBatch(publicKeys, derSignatures, digests, true, threads);
+        ASSERT_EQ(verified.size(), publicKeys.size());
+        ASSERT_EQ(verifiedDER.size(), publicKeys.size());
+        for (auto i = 0ul; i < publicKeys.size(); ++i) {
+            EXPECT_EQ(verified[i], publicKeys[i].verify(signatures[i], digests[i])) << i;
+            EXPECT_EQ(verifiedDER[i], publicKeys[i].verifyAsDER(derSignatures[i], digests[i])) << i;
+        }
+        EXPECT_TRUE(verified[0]);
+        EXPECT_FALSE(verified[4]);
+        EXPECT_TRUE(verified.back());
+    }
+
+    EXPECT_TRUE(PublicKey::verifyBatch({}, {}, {}).empty());
+    EXPECT_THROW(PublicKey::verifyBatch(publicKeys, signatures, {}), std::invalid_argument);
+}
+
+TEST(PublicKeyTests, RecoverBatch) {
+    std::vector<Data> signatures;
+    std::vector<Data> digests;
+    for (auto i = 1; i <= 40; ++i) {
+        const auto privateKey = PrivateKey(Hash::sha256(Data{static_cast<byte>(i)}), TWCurveSECP256k1);
+        const auto digest = Hash::sha256(Data{static_cast<byte>(i), 0x02});
+        auto signature = privateKey.sign(digest);
+        if (i % 2 == 0) {
+            // Ethereum style V
+            signature[64] += 27;
+        }
+        signatures.push_back(signature);
+        digests.push_back(digest);
+    }
+    // unrecoverable entries: r out of range, too short
+    signatures.push_back(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff0100"));
+    digests.push_back(digests[0]);
+    signatures.push_back(parse_hex("0102"));
+    digests.push_back(digests[0]);
+
+    for (auto threads : {1ul, 4ul, 0ul}) {
+        const auto recovered = PublicKey::recoverBatch(signatures, digests, threads);
+        ASSERT_EQ(recovered.size(), signatures.size());
+        for (auto i = 0ul; i < 40; ++i) {
+            ASSERT_TRUE(recovered[i].has_value()) << i;
+            EXPECT_EQ(hex(recovered[i]->bytes), hex(PublicKey::recover(signatures[i], digests[i]).bytes)) << i;
+        }
+        EXPECT_FALSE(recovered[40].has_value());
+        EXPECT_FALSE(recovered[41].has_value());
+    }
+}
+
+TEST(PublicKeyTests, RecoverBatchZeroDigest) {
+    // Digests equal to 0 mod n; an all-zero digest cannot be signed, but a signature can still be recovered against it
+    const auto privateKey = PrivateKey(Hash::sha256(Data{0x01}), TWCurveSECP256k1);
+    const auto order = parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+    const auto signature = privateKey.sign(order);
+    const std::vector<Data> signatures{signature, signature};
+    const std::vector<Data> digests{order, Data(32, 0)};
+
+    const auto recovered = PublicKey::recoverBatch(signatures, digests, 1);
+    ASSERT_EQ(recovered.size(), 2ul);
+    for (auto i = 0ul; i < recovered.size(); ++i) {
+        ASSERT_TRUE(recovered[i].has_value()) << i;
+        EXPECT_EQ(hex(recovered[i]->bytes), hex(PublicKey::recover(signatures[i], digests[i]).bytes)) << i;
+    }
+    EXPECT_EQ(hex(recovered[0]->bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes));
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Copyright © 2017 Trust Wallet.
+
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "SigningContext.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::tests {
+
+namespace {
+
+const auto privateKeyHex = "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5";
+const auto cardanoKeyHex =
+    "b0884d248cb301edd1b34cf626ba6d880bb3ae8fd91b4696446999dc4f0b5744309941d56938e943980d11643c535e046653ca6f498c014b88f2ad9fd6e71effbf36a8fa9f5e11eb7a852c41e185e3969d518e66e6893c81d3fc7227009952d4"
+    "639aadd8b6499ae39b78018b79255fbd8f585cbda9cbb9e907a72af86afb7a05d41a57c2dec9a6a19d6bf3b1fa784f334f3a0048d25ccb7b78a7b44066f9ba7bed7f28be986cbe06819165f2ee41b403678a098961013cf4a2f3e9ea61fb6c1a";
+
+Data signWithContext(const SigningContext& context, const Data& digest) {
+    std::array<byte, SigningContext::maxSignatureSize> out{};
+    if (!context.sign(digest, out)) {
+        return {};
+    }
+    return Data(out.begin(), out.begin() + context.signatureSize());
+}
+
+} // namespace
+
+TEST(SigningContext, MatchesPrivateKeySign) {
+    const auto digests = {Hash::keccak256(TW::data("hello")), Hash::sha256(TW::data("world")), TW::data("a longer message, signed as is by ed25519")};
+    for (auto curve : {TWCurveSECP256k1, TWCurveNIST256p1, TWCurveED25519, TWCurveED25519Blake2bNano, TWCurveCurve25519, TWCurveED25519ExtendedCardano}) {
+        const auto privateKey = PrivateKey(parse_hex(curve == TWCurveED25519ExtendedCardano ? cardanoKeyHex : privateKeyHex), curve);
+        const auto context = SigningContext(privateKey);
+        EXPECT_EQ(context.curve(), curve);
+        for (const auto& digest : digests) {
+            EXPECT_EQ(hex(signWithContext(context, digest)), hex(privateKey.sign(digest))) << "curve " << curve;
+        }
+    }
+}
+
+TEST(SigningContext, KnownSignatures) {
+    const auto digest = Hash::keccak256(TW::data("hello"));
+    {
+        const auto context = SigningContext(PrivateKey(parse_hex(privateKeyHex)), TWCurveSECP256k1);
+        EXPECT_EQ(context.signatureSize(), 65ul);
+        EXPECT_EQ(hex(signWithContext(context, digest)),
+                  "8720a46b5b3963790d94bcc61ad57ca02fd153584315bfa161ed3455e336ba624d68df010ed934b8792c5b6a57ba86c3da31d039f9612b44d1bf054132254de901");
+    }
+    {
+        const auto context = SigningContext(PrivateKey(parse_hex(cardanoKeyHex)), TWCurveED25519ExtendedCardano);
+        EXPECT_EQ(context.signatureSize(), 64ul);
+        EXPECT_EQ(hex(signWithContext(context, digest)),
+                  "375df53b6a4931dcf41e062b1c64288ed4ff3307f862d5c1b1c71964ce3b14c99422d0fdfeb2807e9900a26d491d5e8a874c24f98eec141ed694d7a433a90f08");
+    }
+}
+
+TEST(SigningContext, PublicKey) {
+    const auto privateKey = PrivateKey(parse_hex(privateKeyHex));
+    EXPECT_EQ(hex(SigningContext(privateKey, TWCurveSECP256k1).publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes));
+    EXPECT_EQ(hex(SigningContext(privateKey, TWCurveNIST256p1).publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeNIST256p1).bytes));
+    EXPECT_EQ(hex(SigningContext(privateKey, TWCurveED25519).publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes));
+    EXPECT_EQ(hex(SigningContext(privateKey, TWCurveED25519Blake2bNano).publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeED25519Blake2b).bytes));
+    EXPECT_EQ(hex(SigningContext(privateKey, TWCurveCurve25519).publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeCURVE25519).bytes));
+
+    const auto cardanoKey = PrivateKey(parse_hex(cardanoKeyHex));
+    EXPECT_EQ(hex(SigningContext(cardanoKey, TWCurveED25519ExtendedCardano).publicKey().bytes), hex(cardanoKey.getPublicKey(TWPublicKeyTypeED25519Cardano).bytes));
+}
+
+TEST(SigningContext, InvalidDigest) {
+    const auto context = SigningContext(PrivateKey(parse_hex(privateKeyHex), TWCurveSECP256k1));
+    EXPECT_EQ(signWithContext(context, parse_hex("0102")), Data());
+    EXPECT_EQ(signWithContext(context, Data(32)), Data());
+}
+
+TEST(SigningContext, Errors) {
+    const auto digest = Hash::sha256(TW::data("hello"));
+    // curve mismatch, curve not set, unsupported curve
+    EXPECT_THROW(SigningContext(PrivateKey(parse_hex(privateKeyHex), TWCurveED25519), TWCurveSECP256k1), std::invalid_argument);
+    EXPECT_THROW(SigningContext(PrivateKey(parse_hex(privateKeyHex))), std::invalid_argument);
+    EXPECT_THROW(SigningContext(PrivateKey(parse_hex(privateKeyHex)), TWCurveStarkex), std::invalid_argument);
+    // Cardano needs the double extended key
+    EXPECT_THROW(SigningContext(PrivateKey(parse_hex(privateKeyHex)), TWCurveED25519ExtendedCardano), std::invalid_argument);
+
+    const auto context = SigningContext(PrivateKey(parse_hex(privateKeyHex), TWCurveSECP256k1));
+    std::array<byte, 64> tooSmall{};
+    EXPECT_THROW(context.sign(digest, tooSmall), std::invalid_argument);
+}
+
+} // namespace TW::tests
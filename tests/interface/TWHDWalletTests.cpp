@@ -24,6 +24,7 @@
 #include "HexCoding.h"
 
 #include <gtest/gtest.h>
+#include <set>
 #include <thread>
 
 using namespace TW;
@@ -503,6 +504,34 @@ TEST(HDWallet, GetDerivedKey) {
     assertHexEqual(privateKeyData, "1901b5994f075af71397f65bd68a9fff8d3025d65f5a2c731cf90f5e259d6aac");
 }
 
+TEST(HDWallet, GetAddressRange) {
+    auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(gWords.get(), gPassphrase.get()));
+    for (auto coin : {TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeSolana}) {
+        const auto addresses = WRAP(TWDataVector, TWHDWalletGetAddressRange(wallet.get(), coin, 0, 0, 3, 5));
+        ASSERT_EQ(TWDataVectorSize(addresses.get()), 5ul);
+        std::set<std::string> distinct;
+        for (auto i = 0u; i < 5; ++i) {
+            // ed25519 has hardened derivation only
+            const auto privateKey = coin == TWCoinTypeSolana
+                ? WRAP(TWPrivateKey, TWHDWalletGetKey(wallet.get(), coin, STRING(("m/44'/501'/0'/0'/" + std::to_string(3 + i) + "'").c_str()).get()))
+                : WRAP(TWPrivateKey, TWHDWalletGetDerivedKey(wallet.get(), coin, 0, 0, 3 + i));
+            const auto expected = WRAPS(TWCoinTypeDeriveAddress(coin, privateKey.get()));
+            const auto address = WRAPD(TWDataVectorGet(addresses.get(), i));
+            const auto addressString = std::string(TWDataBytes(address.get()), TWDataBytes(address.get()) + TWDataSize(address.get()));
+            EXPECT_EQ(addressString, std::string(TWStringUTF8Bytes(expected.get())));
+            distinct.insert(addressString);
+        }
+        EXPECT_EQ(distinct.size(), 5ul);
+    }
+
+    // range reaching hardened indices
+    const auto invalid = WRAP(TWDataVector, TWHDWalletGetAddressRange(wallet.get(), TWCoinTypeBitcoin, 0, 0, 0x7fffffff, 2));
+    EXPECT_EQ(TWDataVectorSize(invalid.get()), 0ul);
+    // change other than external (0) or internal (1)
+    const auto invalidChange = WRAP(TWDataVector, TWHDWalletGetAddressRange(wallet.get(), TWCoinTypeBitcoin, 0, 2, 0, 2));
+    EXPECT_EQ(TWDataVectorSize(invalidChange.get()), 0ul);
+}
+
 TEST(HDWallet, GetKeyByCurve) {
     const auto derivPath = STRING("m/44'/539'/0'/0/0");
 
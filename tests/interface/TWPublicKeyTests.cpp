@@ -130,3 +130,47 @@ TEST(TWPublicKeyTests, RecoverInvalid) {
     const auto publicKey = WRAP(TWPublicKey, TWPublicKeyRecover(deadbeef.get(), deadbeef.get()));
     EXPECT_EQ(publicKey.get(), nullptr);
 }
+
+TEST(TWPublicKeyTests, VerifyBatch) {
+    const PrivateKey key(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"), TWCurveSECP256k1);
+    const auto digest = parse_hex("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    auto wrongSignature = key.sign(digest);
+    wrongSignature[5] ^= 0x01;
+
+    const auto publicKeys = WRAP(TWDataVector, TWDataVectorCreate());
+    const auto signatures = WRAP(TWDataVector, TWDataVectorCreate());
+    const auto messages = WRAP(TWDataVector, TWDataVectorCreate());
+    for (const auto& [keyData, signature] : {
+             std::make_pair(publicKey.bytes, key.sign(digest)),
+             std::make_pair(publicKey.bytes, wrongSignature),
+             std::make_pair(parse_hex("deadbeef"), key.sign(digest)),
+         }) {
+        TWDataVectorAdd(publicKeys.get(), WRAPD(TWDataCreateWithBytes(keyData.data(), keyData.size())).get());
+        TWDataVectorAdd(signatures.get(), WRAPD(TWDataCreateWithBytes(signature.data(), signature.size())).get());
+        TWDataVectorAdd(messages.get(), WRAPD(TWDataCreateWithBytes(digest.data(), digest.size())).get());
+    }
+
+    const auto result = WRAPD(TWPublicKeyVerifyBatch(publicKeys.get(), TWPublicKeyTypeSECP256k1, signatures.get(), messages.get(), false, 1));
+    EXPECT_EQ(hex(*reinterpret_cast<const Data*>(result.get())), "010000");
+
+    const auto mismatched = WRAPD(TWPublicKeyVerifyBatch(publicKeys.get(), TWPublicKeyTypeSECP256k1, signatures.get(), WRAP(TWDataVector, TWDataVectorCreate()).get(), false, 1));
+    EXPECT_EQ(TWDataSize(mismatched.get()), 0ul);
+}
+
+TEST(TWPublicKeyTests, RecoverBatch) {
+    const auto signatures = WRAP(TWDataVector, TWDataVectorCreate());
+    const auto messages = WRAP(TWDataVector, TWDataVectorCreate());
+    TWDataVectorAdd(signatures.get(), DATA("00000000000000000000000000000000000000000000000000000000000000020123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef80").get());
+    TWDataVectorAdd(messages.get(), DATA("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432").get());
+    TWDataVectorAdd(signatures.get(), DATA("deadbeef").get());
+    TWDataVectorAdd(messages.get(), DATA("deadbeef").get());
+
+    const auto publicKeys = WRAP(TWDataVector, TWPublicKeyRecoverBatch(signatures.get(), messages.get(), 0));
+    ASSERT_EQ(TWDataVectorSize(publicKeys.get()), 2ul);
+    const auto first = WRAPD(TWDataVectorGet(publicKeys.get(), 0));
+    EXPECT_EQ(hex(*reinterpret_cast<const Data*>(first.get())),
+        "0456d8089137b1fd0d890f8c7d4a04d0fd4520a30b19518ee87bd168ea12ed8090329274c4c6c0d9df04515776f2741eeffc30235d596065d718c3973e19711ad0");
+    const auto second = WRAPD(TWDataVectorGet(publicKeys.get(), 1));
+    EXPECT_EQ(TWDataSize(second.get()), 0ul);
+}
@@ -620,3 +620,95 @@ TEST(TWStoredKey, encryptionParameters) {
         }        
     )");
 }
+
+TEST(TWStoredKey, unlockSessionMnemonic) {
+    const auto passwordString = WRAPS(TWStringCreateWithUTF8Bytes("password"));
+    const auto password = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(TWStringUTF8Bytes(passwordString.get())), TWStringSize(passwordString.get())));
+    const auto key = createDefaultStoredKey();
+
+    const auto session = WRAP(TWStoredKeyUnlockSession, TWStoredKeyUnlockSessionCreate(key.get(), password.get(), 3600));
+    ASSERT_NE(session.get(), nullptr);
+    EXPECT_FALSE(TWStoredKeyUnlockSessionIsExpired(session.get()));
+
+    const auto mnemonic = WRAPS(TWStoredKeyDecryptMnemonicWithSession(key.get(), session.get()));
+    ASSERT_NE(mnemonic.get(), nullptr);
+    EXPECT_EQ(string(TWStringUTF8Bytes(mnemonic.get())), "team engine square letter hero song dizzy scrub tornado fabric divert saddle");
+
+    const auto payload = WRAPD(TWStoredKeyDecryptPrivateKeyWithSession(key.get(), session.get()));
+    const auto payload2 = WRAPD(TWStoredKeyDecryptPrivateKey(key.get(), password.get()));
+    ASSERT_NE(payload.get(), nullptr);
+    EXPECT_TRUE(TWDataEqual(payload.get(), payload2.get()));
+
+    const auto wallet = WRAP(TWHDWallet, TWStoredKeyWalletWithSession(key.get(), session.get()));
+    ASSERT_NE(wallet.get(), nullptr);
+    assertStringsEqual(WRAPS(TWHDWalletMnemonic(wallet.get())), TWStringUTF8Bytes(mnemonic.get()));
+
+    const auto privateKey = WRAP(TWPrivateKey, TWStoredKeyPrivateKeyWithSession(key.get(), TWCoinTypeBitcoin, session.get()));
+    const auto privateKey2 = WRAP(TWPrivateKey, TWStoredKeyPrivateKey(key.get(), TWCoinTypeBitcoin, password.get()));
+    ASSERT_NE(privateKey.get(), nullptr);
+    EXPECT_TRUE(TWDataEqual(WRAPD(TWPrivateKeyData(privateKey.get())).get(), WRAPD(TWPrivateKeyData(privateKey2.get())).get()));
+
+    EXPECT_TRUE(TWStoredKeyFixAddressesWithSession(key.get(), session.get()));
+}
+
+TEST(TWStoredKey, unlockSessionPrivateKey) {
+    const auto privateKeyHex = "3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266";
+    const auto privateKey = WRAPD(TWDataCreateWithHexString(WRAPS(TWStringCreateWithUTF8Bytes(privateKeyHex)).get()));
+    const auto name = WRAPS(TWStringCreateWithUTF8Bytes("name"));
+    const auto passwordString = WRAPS(TWStringCreateWithUTF8Bytes("password"));
+    const auto password = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(TWStringUTF8Bytes(passwordString.get())), TWStringSize(passwordString.get())));
+    const auto key = WRAP(TWStoredKey, TWStoredKeyImportPrivateKey(privateKey.get(), name.get(), password.get(), TWCoinTypeBitcoin));
+
+    const auto session = WRAP(TWStoredKeyUnlockSession, TWStoredKeyUnlockSessionCreate(key.get(), password.get(), 3600));
+    ASSERT_NE(session.get(), nullptr);
+
+    const auto privateKey2 = WRAPD(TWStoredKeyDecryptPrivateKeyWithSession(key.get(), session.get()));
+    ASSERT_NE(privateKey2.get(), nullptr);
+    EXPECT_EQ(hex(data(TWDataBytes(privateKey2.get()), TWDataSize(privateKey2.get()))), privateKeyHex);
+    assertStringsEqual(WRAPS(TWStoredKeyDecryptPrivateKeyEncodedWithSession(key.get(), session.get())), privateKeyHex);
+
+    const auto privateKey3 = WRAP(TWPrivateKey, TWStoredKeyPrivateKeyWithSession(key.get(), TWCoinTypeBitcoin, session.get()));
+    ASSERT_NE(privateKey3.get(), nullptr);
+    const auto pkData3 = WRAPD(TWPrivateKeyData(privateKey3.get()));
+    EXPECT_EQ(hex(data(TWDataBytes(pkData3.get()), TWDataSize(pkData3.get()))), privateKeyHex);
+
+    // not a mnemonic
+    EXPECT_EQ(WRAP(TWHDWallet, TWStoredKeyWalletWithSession(key.get(), session.get())).get(), nullptr);
+    EXPECT_TRUE(TWStoredKeyFixAddressesWithSession(key.get(), session.get()));
+}
+
+TEST(TWStoredKey, unlockSessionInvalid) {
+    const auto key = createDefaultStoredKey();
+    const auto invalidString = WRAPS(TWStringCreateWithUTF8Bytes("_THIS_IS_INVALID_PASSWORD_"));
+    const auto passwordInvalid = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(TWStringUTF8Bytes(invalidString.get())), TWStringSize(invalidString.get())));
+    EXPECT_EQ(WRAP(TWStoredKeyUnlockSession, TWStoredKeyUnlockSessionCreate(key.get(), passwordInvalid.get(), 3600)).get(), nullptr);
+
+    // session of another key
+    const auto passwordString = WRAPS(TWStringCreateWithUTF8Bytes("password"));
+    const auto password = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(TWStringUTF8Bytes(passwordString.get())), TWStringSize(passwordString.get())));
+    const auto otherKey = createDefaultStoredKey();
+    const auto session = WRAP(TWStoredKeyUnlockSession, TWStoredKeyUnlockSessionCreate(otherKey.get(), password.get(), 3600));
+    ASSERT_NE(session.get(), nullptr);
+    EXPECT_EQ(WRAPS(TWStoredKeyDecryptMnemonicWithSession(key.get(), session.get())).get(), nullptr);
+    EXPECT_EQ(WRAP(TWHDWallet, TWStoredKeyWalletWithSession(key.get(), session.get())).get(), nullptr);
+    EXPECT_FALSE(TWStoredKeyFixAddressesWithSession(key.get(), session.get()));
+}
+
+TEST(TWStoredKey, unlockSessionLockAndExpiry) {
+    const auto passwordString = WRAPS(TWStringCreateWithUTF8Bytes("password"));
+    const auto password = WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t *>(TWStringUTF8Bytes(passwordString.get())), TWStringSize(passwordString.get())));
+    const auto key = createDefaultStoredKey();
+
+    const auto session = WRAP(TWStoredKeyUnlockSession, TWStoredKeyUnlockSessionCreate(key.get(), password.get(), 3600));
+    ASSERT_NE(session.get(), nullptr);
+    TWStoredKeyUnlockSessionLock(session.get());
+    EXPECT_TRUE(TWStoredKeyUnlockSessionIsExpired(session.get()));
+    EXPECT_EQ(WRAPD(TWStoredKeyDecryptPrivateKeyWithSession(key.get(), session.get())).get(), nullptr);
+    EXPECT_EQ(WRAP(TWPrivateKey, TWStoredKeyPrivateKeyWithSession(key.get(), TWCoinTypeBitcoin, session.get())).get(), nullptr);
+
+    // a session without lifetime expires as soon as it is created
+    const auto expired = WRAP(TWStoredKeyUnlockSession, TWStoredKeyUnlockSessionCreate(key.get(), password.get(), 0));
+    ASSERT_NE(expired.get(), nullptr);
+    EXPECT_TRUE(TWStoredKeyUnlockSessionIsExpired(expired.get()));
+    EXPECT_EQ(WRAPS(TWStoredKeyDecryptMnemonicWithSession(key.get(), expired.get())).get(), nullptr);
+}
@@ -32,6 +32,7 @@
 #include <TrezorCrypto/bignum.h>
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/hmac.h>
+#include <TrezorCrypto/limb64.h>
 #include <TrezorCrypto/memzero.h>
 #include <TrezorCrypto/rand.h>
 #include <TrezorCrypto/rfc6979.h>
@@ -402,6 +403,25 @@ void point_jacobian_double(jacobian_curve_point *p, const ecdsa_curve *curve) {
   bn_fast_mod(&p->y, prime);
 }
 
+#if USE_LIMB64
+
+// [wallet-core] 4x64-bit limb arithmetic, see limb64.h
+int point_multiply(const ecdsa_curve *curve, const bignum256 *k,
+                   const curve_point *p, curve_point *res) {
+  return point_multiply_limb64(curve, k, p, res);
+}
+
+int scalar_multiply(const ecdsa_curve *curve, const bignum256 *k,
+                    curve_point *res) {
+#if USE_PRECOMPUTED_CP
+  return scalar_multiply_limb64(curve, k, res);
+#else
+  return point_multiply_limb64(curve, k, &curve->G, res);
+#endif
+}
+
+#else
+
 // res = k * p
 // returns 0 on success
 int point_multiply(const ecdsa_curve *curve, const bignum256 *k,
@@ -632,6 +652,8 @@ int scalar_multiply(const ecdsa_curve *curve, const bignum256 *k,
 
 #endif
 
+#endif  // USE_LIMB64
+
 int ecdh_multiply(const ecdsa_curve *curve, const uint8_t *priv_key,
                   const uint8_t *pub_key, uint8_t *session_key) {
   curve_point point = {0};
@@ -0,0 +1,606 @@
+/**
+ * Copyright (c) 2017 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <TrezorCrypto/limb64.h>
+
+#if USE_LIMB64
+
+#include <assert.h>
+#include <string.h>
+
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/rand.h>
+
+typedef unsigned __int128 uint128_t;
+
+// 256-bit number, least significant limb first
+typedef uint64_t fe_t[4];
+
+// Montgomery arithmetic modulo m with R = 2**256
+typedef struct {
+  const bignum256 *modulus;
+  fe_t m;
+  uint64_t minv;  // -1/m % 2**64
+  fe_t r2;        // R**2 % m
+  fe_t one;       // R % m, i.e. 1 in Montgomery form
+} mont_ctx;
+
+typedef struct {
+  fe_t x, y;
+} affine_point64;
+
+typedef struct {
+  fe_t x, y, z;
+} jacobian_point64;
+
+// Converts a normalized x < 2**256 to 64-bit limbs
+static void bn_to_limbs(const bignum256 *x, fe_t r) {
+  memset(r, 0, sizeof(fe_t));
+  for (int i = 0; i < BN_LIMBS; i++) {
+    int bit = i * BN_BITS_PER_LIMB;
+    int limb = bit / 64, shift = bit % 64;
+    r[limb] |= (uint64_t)x->val[i] << shift;
+    if (shift + BN_BITS_PER_LIMB > 64 && limb + 1 < 4) {
+      r[limb + 1] |= (uint64_t)x->val[i] >> (64 - shift);
+    }
+  }
+}
+
+static void limbs_to_bn(const fe_t a, bignum256 *r) {
+  for (int i = 0; i < BN_LIMBS; i++) {
+    int bit = i * BN_BITS_PER_LIMB;
+    int limb = bit / 64, shift = bit % 64;
+    uint64_t v = a[limb] >> shift;
+    if (shift + BN_BITS_PER_LIMB > 64 && limb + 1 < 4) {
+      v |= a[limb + 1] << (64 - shift);
+    }
+    r->val[i] = (uint32_t)v & BN_LIMB_MASK;
+  }
+}
+
+// r = a - b, returns the borrow
+static uint64_t limbs_sub(fe_t r, const fe_t a, const fe_t b) {
+  uint64_t borrow = 0;
+  for (int i = 0; i < 4; i++) {
+    uint128_t d = (uint128_t)a[i] - b[i] - borrow;
+    r[i] = (uint64_t)d;
+    borrow = (uint64_t)(d >> 64) & 1;
+  }
+  return borrow;
+}
+
+// r = mask ? a : r, mask is either 0 or all ones
+static void fe_cmov(fe_t r, const fe_t a, uint64_t mask) {
+  for (int i = 0; i < 4; i++) {
+    r[i] = (r[i] & ~mask) | (a[i] & mask);
+  }
+}
+
+// Returns all ones if a == 0, else 0
+static uint64_t fe_zero_mask(const fe_t a) {
+  uint64_t t = a[0] | a[1] | a[2] | a[3];
+  return ((t | (0 - t)) >> 63) - 1;
+}
+
+// r = (a + b) % m, assumes a, b < m
+static void fe_add(const mont_ctx *ctx, fe_t r, const fe_t a, const fe_t b) {
+  fe_t s = {0}, d = {0};
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; i++) {
+    uint128_t t = (uint128_t)a[i] + b[i] + carry;
+    s[i] = (uint64_t)t;
+    carry = (uint64_t)(t >> 64);
+  }
+  uint64_t borrow = limbs_sub(d, s, ctx->m);
+  // s >= m iff the addition carried or the subtraction did not borrow
+  fe_cmov(s, d, 0 - ((carry | (borrow ^ 1)) & 1));
+  memcpy(r, s, sizeof(fe_t));
+}
+
+// r = (a - b) % m, assumes a, b < m
+static void fe_sub(const mont_ctx *ctx, fe_t r, const fe_t a, const fe_t b) {
+  fe_t d = {0};
+  uint64_t mask = 0 - limbs_sub(d, a, b);
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; i++) {
+    uint128_t t = (uint128_t)d[i] + (ctx->m[i] & mask) + carry;
+    d[i] = (uint64_t)t;
+    carry = (uint64_t)(t >> 64);
+  }
+  memcpy(r, d, sizeof(fe_t));
+}
+
+// r = a / 2 % m, assumes a < m
+static void fe_half(const mont_ctx *ctx, fe_t r, const fe_t a) {
+  uint64_t mask = 0 - (a[0] & 1);
+  fe_t s = {0};
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; i++) {
+    uint128_t t = (uint128_t)a[i] + (ctx->m[i] & mask) + carry;
+    s[i] = (uint64_t)t;
+    carry = (uint64_t)(t >> 64);
+  }
+  for (int i = 0; i < 3; i++) {
+    r[i] = (s[i] >> 1) | (s[i + 1] << 63);
+  }
+  r[3] = (s[3] >> 1) | (carry << 63);
+}
+
+// r = -a % m if cond else a, cond is either 0 or 1
+static void fe_cnegate(const mont_ctx *ctx, uint64_t cond, fe_t a) {
+  static const fe_t zero = {0};
+  fe_t n = {0};
+  fe_sub(ctx, n, zero, a);
+  fe_cmov(a, n, 0 - cond);
+}
+
+// r = a * b / R % m (Montgomery multiplication, CIOS), assumes a, b < m
+static void fe_mul(const mont_ctx *ctx, fe_t r, const fe_t a, const fe_t b) {
+  uint64_t t[6] = {0};
+  for (int i = 0; i < 4; i++) {
+    uint64_t carry = 0;
+    for (int j = 0; j < 4; j++) {
+      uint128_t s = (uint128_t)a[j] * b[i] + t[j] + carry;
+      t[j] = (uint64_t)s;
+      carry = (uint64_t)(s >> 64);
+    }
+    uint128_t s = (uint128_t)t[4] + carry;
+    t[4] = (uint64_t)s;
+    t[5] = (uint64_t)(s >> 64);
+
+    uint64_t q = t[0] * ctx->minv;
+    s = (uint128_t)q * ctx->m[0] + t[0];
+    carry = (uint64_t)(s >> 64);
+    for (int j = 1; j < 4; j++) {
+      s = (uint128_t)q * ctx->m[j] + t[j] + carry;
+      t[j - 1] = (uint64_t)s;
+      carry = (uint64_t)(s >> 64);
+    }
+    s = (uint128_t)t[4] + carry;
+    t[3] = (uint64_t)s;
+    t[4] = t[5] + (uint64_t)(s >> 64);
+  }
+  // t < 2m, subtract m once if needed
+  fe_t d = {0};
+  uint64_t borrow = limbs_sub(d, t, ctx->m);
+  fe_cmov(t, d, 0 - ((t[4] | (borrow ^ 1)) & 1));
+  memcpy(r, t, sizeof(fe_t));
+}
+
+static void fe_sqr(const mont_ctx *ctx, fe_t r, const fe_t a) {
+  fe_mul(ctx, r, a, a);
+}
+
+// Assumes m is odd and 2**255 < m < 2**256
+static void mont_init(mont_ctx *ctx, const bignum256 *m) {
+  ctx->modulus = m;
+  bn_to_limbs(m, ctx->m);
+  assert((ctx->m[0] & 1) && (ctx->m[3] >> 63));
+
+  // Newton iteration, each step doubles the number of correct low bits
+  uint64_t inv = ctx->m[0];
+  for (int i = 0; i < 5; i++) {
+    inv *= 2 - ctx->m[0] * inv;
+  }
+  ctx->minv = 0 - inv;
+
+  // R % m = R - m, as m > R / 2
+  static const fe_t zero = {0};
+  limbs_sub(ctx->one, zero, ctx->m);
+
+  // 2 in Montgomery form, squared 8 times is 2**256 in Montgomery form
+  fe_add(ctx, ctx->r2, ctx->one, ctx->one);
+  for (int i = 0; i < 8; i++) {
+    fe_sqr(ctx, ctx->r2, ctx->r2);
+  }
+}
+
+// Assumes x is normalized and fully reduced modulo m
+static void fe_from_bn(const mont_ctx *ctx, fe_t r, const bignum256 *x) {
+  fe_t a = {0};
+  bn_to_limbs(x, a);
+  fe_mul(ctx, r, a, ctx->r2);
+  memzero(a, sizeof(a));
+}
+
+// Guarantees r is normalized and fully reduced modulo m
+static void fe_to_bn(const mont_ctx *ctx, const fe_t a, bignum256 *r) {
+  static const fe_t plain_one = {1, 0, 0, 0};
+  fe_t t = {0};
+  fe_mul(ctx, t, a, plain_one);
+  limbs_to_bn(t, r);
+  memzero(t, sizeof(t));
+}
+
+// r = 1/a % m (0 for a == 0)
+// The binary inversion of bn_inverse beats a Fermat ladder even with 64-bit
+// multiplications, so the value is converted back and forth once.
+static void fe_inverse(const mont_ctx *ctx, fe_t r, const fe_t a) {
+  bignum256 x = {0};
+  fe_to_bn(ctx, a, &x);
+  bn_inverse(&x, ctx->modulus);
+  fe_from_bn(ctx, r, &x);
+  memzero(&x, sizeof(x));
+}
+
+// r = k * a for a small public k
+static void fe_mul_small(const mont_ctx *ctx, fe_t r, const fe_t a, int k) {
+  fe_t acc = {0};
+  for (int i = 0; i < k; i++) {
+    fe_add(ctx, acc, acc, a);
+  }
+  memcpy(r, acc, sizeof(fe_t));
+}
+
+// Random z with 0 < z < prime, in Montgomery form
+static void random_z(const mont_ctx *ctx, const bignum256 *prime, fe_t z) {
+  bignum256 k = {0};
+  do {
+    for (int i = 0; i < BN_LIMBS - 1; i++) {
+      k.val[i] = random32() & BN_LIMB_MASK;
+    }
+    k.val[BN_LIMBS - 1] = random32() & ((1u << BN_BITS_LAST_LIMB) - 1);
+  } while (bn_is_zero(&k) || !bn_is_less(&k, prime));
+  fe_from_bn(ctx, z, &k);
+  memzero(&k, sizeof(k));
+}
+
+// Jacobian coordinates of p with a random z, see curve_to_jacobian
+static void affine_to_jacobian(const mont_ctx *ctx, const bignum256 *prime,
+                               const affine_point64 *p, jacobian_point64 *jp) {
+  random_z(ctx, prime, jp->z);
+  fe_t z2 = {0};
+  fe_sqr(ctx, z2, jp->z);
+  fe_mul(ctx, jp->x, p->x, z2);
+  fe_mul(ctx, z2, z2, jp->z);
+  fe_mul(ctx, jp->y, p->y, z2);
+}
+
+// Guarantees the coordinates of p are fully reduced
+static void jacobian_to_affine(const mont_ctx *ctx, const jacobian_point64 *jp,
+                               affine_point64 *p) {
+  fe_t zinv = {0}, zinv2 = {0};
+  fe_inverse(ctx, zinv, jp->z);
+  fe_sqr(ctx, zinv2, zinv);
+  fe_mul(ctx, p->x, jp->x, zinv2);
+  fe_mul(ctx, zinv2, zinv2, zinv);
+  fe_mul(ctx, p->y, jp->y, zinv2);
+}
+
+// p2 = p1 + p2, same formulas as point_jacobian_add, including the
+// constant-time handling of p1 == p2
+static void jacobian_add_affine(const mont_ctx *ctx, int a,
+                                const affine_point64 *p1,
+                                jacobian_point64 *p2) {
+  fe_t r = {0}, h = {0}, r2 = {0};
+  fe_t hcby = {0}, hsqx = {0};
+  fe_t xz = {0}, yz = {0}, az = {0};
+
+  fe_sqr(ctx, xz, p2->z);      // xz = z2^2
+  fe_mul(ctx, yz, xz, p2->z);  // yz = z2^3
+  if (a != 0) {
+    fe_sqr(ctx, az, xz);              // az = z2^4
+    fe_mul_small(ctx, az, az, -a);    // az = -a z2^4
+  }
+
+  fe_mul(ctx, xz, p1->x, xz);  // xz = x1' = x1*z2^2
+  fe_sub(ctx, h, xz, p2->x);   // h = x1' - x2
+  fe_add(ctx, xz, xz, p2->x);  // xz = x1' + x2
+  uint64_t is_doubling = fe_zero_mask(h);
+
+  fe_mul(ctx, yz, p1->y, yz);  // yz = y1' = y1*z2^3
+  fe_sub(ctx, r, yz, p2->y);   // r = y1' - y2
+  fe_add(ctx, yz, yz, p2->y);  // yz = y1' + y2
+
+  fe_sqr(ctx, r2, p2->x);
+  fe_mul_small(ctx, r2, r2, 3);
+  if (a != 0) {
+    fe_sub(ctx, r2, r2, az);  // r2 = 3 x2^2 + a z2^4
+  }
+  fe_cmov(r, r2, is_doubling);
+  fe_cmov(h, yz, is_doubling);
+
+  fe_sqr(ctx, hsqx, h);           // hsqx = h^2
+  fe_mul(ctx, hcby, hsqx, h);     // hcby = h^3
+  fe_mul(ctx, hsqx, hsqx, xz);    // hsqx = h^2 * (x1 + x2)
+  fe_mul(ctx, hcby, hcby, yz);    // hcby = h^3 * (y1 + y2)
+  fe_mul(ctx, p2->z, p2->z, h);   // z3 = h*z2
+
+  // x3 = r^2 - h^2 (x1 + x2)
+  fe_sqr(ctx, p2->x, r);
+  fe_sub(ctx, p2->x, p2->x, hsqx);
+
+  // y3 = 1/2 (r*(h^2 (x1 + x2) - 2x3) - h^3 (y1 + y2))
+  fe_sub(ctx, p2->y, hsqx, p2->x);
+  fe_sub(ctx, p2->y, p2->y, p2->x);
+  fe_mul(ctx, p2->y, p2->y, r);
+  fe_sub(ctx, p2->y, p2->y, hcby);
+  fe_half(ctx, p2->y, p2->y);
+
+  memzero(r, sizeof(r));
+  memzero(h, sizeof(h));
+  memzero(r2, sizeof(r2));
+  memzero(hcby, sizeof(hcby));
+  memzero(hsqx, sizeof(hsqx));
+  memzero(xz, sizeof(xz));
+  memzero(yz, sizeof(yz));
+}
+
+// p = 2 * p, same formulas as point_jacobian_double
+static void jacobian_double(const mont_ctx *ctx, int a, jacobian_point64 *p) {
+  fe_t az4 = {0}, m = {0}, msq = {0}, ysq = {0}, xysq = {0};
+
+  // m = (3*x^2 + a z^4) / 2
+  fe_sqr(ctx, m, p->x);
+  fe_mul_small(ctx, m, m, 3);
+  if (a != 0) {
+    fe_sqr(ctx, az4, p->z);
+    fe_sqr(ctx, az4, az4);
+    fe_mul_small(ctx, az4, az4, -a);
+    fe_sub(ctx, m, m, az4);
+  }
+  fe_half(ctx, m, m);
+
+  fe_sqr(ctx, msq, m);
+  fe_sqr(ctx, ysq, p->y);
+  fe_mul(ctx, xysq, p->x, ysq);
+
+  // z3 = yz
+  fe_mul(ctx, p->z, p->z, p->y);
+
+  // x3 = m^2 - 2*xy^2
+  fe_add(ctx, p->x, xysq, xysq);
+  fe_sub(ctx, p->x, msq, p->x);
+
+  // y3 = m*(xy^2 - x3) - y^4
+  fe_sub(ctx, p->y, xysq, p->x);
+  fe_mul(ctx, p->y, p->y, m);
+  fe_sqr(ctx, ysq, ysq);
+  fe_sub(ctx, p->y, p->y, ysq);
+
+  memzero(az4, sizeof(az4));
+  memzero(m, sizeof(m));
+  memzero(msq, sizeof(msq));
+  memzero(ysq, sizeof(ysq));
+  memzero(xysq, sizeof(xysq));
+}
+
+// Returns 1 if i == j else 0, without branching
+static uint64_t index_equal(uint32_t i, uint32_t j) {
+  return (((uint64_t)(i ^ j)) - 1) >> 63;
+}
+
+// Constant-time r = table[index] for a table of 8 points
+static void select_affine(const affine_point64 table[8], uint32_t index,
+                          affine_point64 *r) {
+  memset(r, 0, sizeof(*r));
+  for (uint32_t j = 0; j < 8; j++) {
+    uint64_t mask = 0 - index_equal(j, index);
+    for (int i = 0; i < 4; i++) {
+      r->x[i] |= table[j].x[i] & mask;
+      r->y[i] |= table[j].y[i] & mask;
+    }
+  }
+}
+
+// Writes the affine coordinates of jp into res
+static void jacobian_to_curve64(const mont_ctx *ctx, const jacobian_point64 *jp,
+                                curve_point *res) {
+  affine_point64 p = {0};
+  jacobian_to_affine(ctx, jp, &p);
+  fe_to_bn(ctx, p.x, &res->x);
+  fe_to_bn(ctx, p.y, &res->y);
+  memzero(&p, sizeof(p));
+}
+
+// a = k + 2^256 (mod order), made odd by subtracting order if k is even,
+// exactly as in point_multiply and scalar_multiply.
+// Returns 0 if k is zero.
+static uint32_t recode_scalar(const ecdsa_curve *curve, const bignum256 *k,
+                              bignum256 *a) {
+  int j = 0;
+  uint32_t is_even = (k->val[0] & 1) - 1;
+  uint32_t tmp = 1;
+  uint32_t is_non_zero = 0;
+  for (j = 0; j < 8; j++) {
+    is_non_zero |= k->val[j];
+    tmp += (BN_BASE - 1) + k->val[j] - (curve->order.val[j] & is_even);
+    a->val[j] = tmp & (BN_BASE - 1);
+    tmp >>= BN_BITS_PER_LIMB;
+  }
+  is_non_zero |= k->val[j];
+  a->val[j] = tmp + 0xffffff + k->val[j] - (curve->order.val[j] & is_even);
+  assert((a->val[0] & 1) != 0);
+  return is_non_zero;
+}
+
+#if USE_PRECOMPUTED_CP
+
+// Constant-time r = table[index] for a row of curve->cp, in Montgomery form
+static void select_cp(const mont_ctx *ctx, const curve_point table[8],
+                      uint32_t index, affine_point64 *r) {
+  bignum256 x = {0}, y = {0};
+  for (uint32_t j = 0; j < 8; j++) {
+    uint32_t mask = 0 - (uint32_t)index_equal(j, index);
+    for (int i = 0; i < BN_LIMBS; i++) {
+      x.val[i] |= table[j].x.val[i] & mask;
+      y.val[i] |= table[j].y.val[i] & mask;
+    }
+  }
+  fe_from_bn(ctx, r->x, &x);
+  fe_from_bn(ctx, r->y, &y);
+  memzero(&x, sizeof(x));
+  memzero(&y, sizeof(y));
+}
+
+int scalar_multiply_limb64(const ecdsa_curve *curve, const bignum256 *k,
+                           curve_point *res) {
+  if (!bn_is_less(k, &curve->order)) {
+    return 1;
+  }
+
+  CONFIDENTIAL bignum256 a;
+  if (!recode_scalar(curve, k, &a)) {
+    point_set_infinity(res);
+    return 0;
+  }
+
+  mont_ctx ctx = {0};
+  mont_init(&ctx, &curve->prime);
+
+  // see scalar_multiply: res = sum_{i=0..63} a[i] * 16^i * G,
+  // with curve->cp[i][j] = (2*j+1) * 16^i * G
+  CONFIDENTIAL affine_point64 selected;
+  CONFIDENTIAL jacobian_point64 jres;
+  uint32_t lowbits = a.val[0] & ((1 << 5) - 1);
+  lowbits ^= (lowbits >> 4) - 1;
+  lowbits &= 15;
+  select_cp(&ctx, curve->cp[0], lowbits >> 1, &selected);
+  affine_to_jacobian(&ctx, &curve->prime, &selected, &jres);
+  for (int i = 1; i < 64; i++) {
+    int j = 0;
+    for (j = 0; j < 8; j++) {
+      a.val[j] =
+          (a.val[j] >> 4) | ((a.val[j + 1] & 0xf) << (BN_BITS_PER_LIMB - 4));
+    }
+    a.val[j] >>= 4;
+
+    lowbits = a.val[0] & ((1 << 5) - 1);
+    lowbits ^= (lowbits >> 4) - 1;
+    lowbits &= 15;
+    fe_cnegate(&ctx, ~lowbits & 1, jres.y);
+
+    select_cp(&ctx, curve->cp[i], lowbits >> 1, &selected);
+    jacobian_add_affine(&ctx, curve->a, &selected, &jres);
+  }
+  fe_cnegate(&ctx, ~(a.val[0] >> 4) & 1, jres.y);
+  jacobian_to_curve64(&ctx, &jres, res);
+
+  memzero(&a, sizeof(a));
+  memzero(&selected, sizeof(selected));
+  memzero(&jres, sizeof(jres));
+  return 0;
+}
+
+#endif
+
+int point_multiply_limb64(const ecdsa_curve *curve, const bignum256 *k,
+                          const curve_point *p, curve_point *res) {
+  if (!bn_is_less(k, &curve->order)) {
+    return 1;
+  }
+
+  CONFIDENTIAL bignum256 a;
+  if (!recode_scalar(curve, k, &a)) {
+    point_set_infinity(res);
+    return 1;
+  }
+
+  mont_ctx ctx = {0};
+  mont_init(&ctx, &curve->prime);
+
+  // pmult[i] = (2*i+1) * p, computed in Jacobian coordinates from 2p and
+  // brought to affine coordinates with a single inversion
+  affine_point64 pmult[8] = {0};
+  jacobian_point64 jmult[8] = {0};
+  affine_point64 twice = {0};
+  fe_from_bn(&ctx, pmult[0].x, &p->x);
+  fe_from_bn(&ctx, pmult[0].y, &p->y);
+  memcpy(jmult[0].x, pmult[0].x, sizeof(fe_t));
+  memcpy(jmult[0].y, pmult[0].y, sizeof(fe_t));
+  memcpy(jmult[0].z, ctx.one, sizeof(fe_t));
+  jacobian_point64 jtwice = jmult[0];
+  jacobian_double(&ctx, curve->a, &jtwice);
+  jacobian_to_affine(&ctx, &jtwice, &twice);
+  for (int i = 1; i < 8; i++) {
+    jmult[i] = jmult[i - 1];
+    jacobian_add_affine(&ctx, curve->a, &twice, &jmult[i]);
+  }
+  fe_t prefix[8] = {0}, inverse = {0};
+  memcpy(prefix[0], jmult[0].z, sizeof(fe_t));
+  for (int i = 1; i < 8; i++) {
+    fe_mul(&ctx, prefix[i], prefix[i - 1], jmult[i].z);
+  }
+  fe_inverse(&ctx, inverse, prefix[7]);
+  for (int i = 7; i >= 0; i--) {
+    fe_t zinv = {0}, zinv2 = {0};
+    if (i > 0) {
+      fe_mul(&ctx, zinv, inverse, prefix[i - 1]);
+      fe_mul(&ctx, inverse, inverse, jmult[i].z);
+    } else {
+      memcpy(zinv, inverse, sizeof(fe_t));
+    }
+    fe_sqr(&ctx, zinv2, zinv);
+    fe_mul(&ctx, pmult[i].x, jmult[i].x, zinv2);
+    fe_mul(&ctx, zinv2, zinv2, zinv);
+    fe_mul(&ctx, pmult[i].y, jmult[i].y, zinv2);
+  }
+
+  // see point_multiply: res = sum_{i=0..63} a[i] * 16^i * p, from i = 63
+  CONFIDENTIAL affine_point64 selected;
+  CONFIDENTIAL jacobian_point64 jres;
+  const uint32_t *aptr = &a.val[8];
+  uint32_t abits = *aptr;
+  int ashift = 256 - (BN_BITS_PER_LIMB * 8) - 4;
+  uint32_t bits = abits >> ashift;
+  uint32_t sign = (bits >> 4) - 1;
+  uint32_t nsign = 0;
+  bits ^= sign;
+  bits &= 15;
+  select_affine(pmult, bits >> 1, &selected);
+  affine_to_jacobian(&ctx, &curve->prime, &selected, &jres);
+  for (int i = 62; i >= 0; i--) {
+    jacobian_double(&ctx, curve->a, &jres);
+    jacobian_double(&ctx, curve->a, &jres);
+    jacobian_double(&ctx, curve->a, &jres);
+    jacobian_double(&ctx, curve->a, &jres);
+
+    ashift -= 4;
+    if (ashift < 0) {
+      // depends only on the iteration number
+      bits = abits << (-ashift);
+      abits = *(--aptr);
+      ashift += BN_BITS_PER_LIMB;
+      bits |= abits >> ashift;
+    } else {
+      bits = abits >> ashift;
+    }
+    bits &= 31;
+    nsign = (bits >> 4) - 1;
+    bits ^= nsign;
+    bits &= 15;
+
+    fe_cnegate(&ctx, (sign ^ nsign) & 1, jres.y);
+    select_affine(pmult, bits >> 1, &selected);
+    jacobian_add_affine(&ctx, curve->a, &selected, &jres);
+    sign = nsign;
+  }
+  fe_cnegate(&ctx, sign & 1, jres.y);
+  jacobian_to_curve64(&ctx, &jres, res);
+
+  memzero(&a, sizeof(a));
+  memzero(&selected, sizeof(selected));
+  memzero(&jres, sizeof(jres));
+  memzero(&bits, sizeof(bits));
+  return 0;
+}
+
+#endif
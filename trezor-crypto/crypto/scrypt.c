@@ -41,6 +41,9 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 static void blkcpy(uint32_t *, const uint32_t *, size_t);
 static void blkxor(void *, void *, size_t);
@@ -49,6 +52,31 @@ static void blockmix_salsa8(uint32_t *, uint32_t *, uint32_t *, size_t);
 static uint64_t integerify(void *, size_t);
 static void smix(uint8_t *, size_t, uint64_t, uint32_t *, uint32_t *);
 
+#ifdef __SSE2__
+/* The blocks are aligned to a multiple of 64 bytes. */
+static void
+blkcpy(uint32_t * dest, const uint32_t * src, size_t len)
+{
+	__m128i * D = (__m128i *)dest;
+	const __m128i * S = (const __m128i *)src;
+	size_t L = len / 16;
+
+	for (size_t i = 0; i < L; i++)
+		D[i] = S[i];
+}
+
+static void
+blkxor(void * dest, void * src, size_t len)
+{
+	__m128i * D = dest;
+	__m128i * S = src;
+	size_t L = len / 16;
+	size_t i;
+
+	for (i = 0; i < L; i++)
+		D[i] = _mm_xor_si128(D[i], S[i]);
+}
+#else
 static void
 blkcpy(uint32_t * dest, const uint32_t * src, size_t len)
 {
@@ -69,7 +97,68 @@ blkxor(void * dest, void * src, size_t len)
 	for (i = 0; i < L; i++)
 		D[i] ^= S[i];
 }
+#endif
 
+#ifdef __SSE2__
+/**
+ * salsa20_8(B):
+ * Apply the salsa20/8 core to the provided block, stored in the diagonal
+ * layout set up by smix: word i of the block is word (5 * i) % 16 of the
+ * standard layout, so that each SSE2 register holds one diagonal and the
+ * column and row rounds only rotate registers.  The block must be aligned
+ * to a multiple of 16 bytes.
+ */
+static void
+salsa20_8(uint32_t B[16])
+{
+	__m128i * V = (__m128i *)B;
+	__m128i X0, X1, X2, X3;
+	__m128i T;
+	size_t i;
+
+	X0 = V[0];
+	X1 = V[1];
+	X2 = V[2];
+	X3 = V[3];
+	for (i = 0; i < 8; i += 2) {
+#define R(x,a,b) _mm_xor_si128(_mm_xor_si128((x), _mm_slli_epi32((a), (b))), _mm_srli_epi32((a), 32 - (b)))
+		/* Operate on columns. */
+		T = _mm_add_epi32(X0, X3);
+		X1 = R(X1, T, 7);
+		T = _mm_add_epi32(X1, X0);
+		X2 = R(X2, T, 9);
+		T = _mm_add_epi32(X2, X1);
+		X3 = R(X3, T, 13);
+		T = _mm_add_epi32(X3, X2);
+		X0 = R(X0, T, 18);
+
+		/* Rearrange data. */
+		X1 = _mm_shuffle_epi32(X1, 0x93);
+		X2 = _mm_shuffle_epi32(X2, 0x4E);
+		X3 = _mm_shuffle_epi32(X3, 0x39);
+
+		/* Operate on rows. */
+		T = _mm_add_epi32(X0, X1);
+		X3 = R(X3, T, 7);
+		T = _mm_add_epi32(X3, X0);
+		X2 = R(X2, T, 9);
+		T = _mm_add_epi32(X2, X3);
+		X1 = R(X1, T, 13);
+		T = _mm_add_epi32(X1, X2);
+		X0 = R(X0, T, 18);
+
+		/* Rearrange data. */
+		X1 = _mm_shuffle_epi32(X1, 0x39);
+		X2 = _mm_shuffle_epi32(X2, 0x4E);
+		X3 = _mm_shuffle_epi32(X3, 0x93);
+#undef R
+	}
+	V[0] = _mm_add_epi32(V[0], X0);
+	V[1] = _mm_add_epi32(V[1], X1);
+	V[2] = _mm_add_epi32(V[2], X2);
+	V[3] = _mm_add_epi32(V[3], X3);
+}
+#else
 /**
  * salsa20_8(B):
  * Apply the salsa20/8 core to the provided block.
@@ -113,6 +202,7 @@ salsa20_8(uint32_t B[16])
 	for (i = 0; i < 16; i++)
 		B[i] += x[i];
 }
+#endif
 
 /**
  * blockmix_salsa8(Bin, Bout, X, r):
@@ -157,7 +247,28 @@ integerify(void * B, size_t r)
 {
 	uint32_t * X = (void *)((uintptr_t)(B) + (2 * r - 1) * 64);
 
+#ifdef __SSE2__
+	/* Words 0 and 1 are words 0 and 13 in the diagonal layout. */
+	return (((uint64_t)(X[13]) << 32) + X[0]);
+#else
 	return (((uint64_t)(X[1]) << 32) + X[0]);
+#endif
+}
+
+/**
+ * word_index(k):
+ * Return the index in XY of word k of a block of B, in the layout used by
+ * salsa20_8.
+ */
+static size_t
+word_index(size_t k)
+{
+#ifdef __SSE2__
+	/* Inverse of i -> (5 * i) % 16 within each 64-byte block. */
+	return (k & ~(size_t)15) | ((13 * k) & 15);
+#else
+	return k;
+#endif
 }
 
 /**
@@ -180,7 +291,7 @@ smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY)
 
 	/* 1: X <-- B */
 	for (k = 0; k < 32 * r; k++)
-		X[k] = le32dec(&B[4 * k]);
+		X[word_index(k)] = le32dec(&B[4 * k]);
 
 	/* 2: for i = 0 to N - 1 do */
 	for (i = 0; i < N; i += 2) {
@@ -216,7 +327,129 @@ smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY)
 
 	/* 10: B' <-- X */
 	for (k = 0; k < 32 * r; k++)
-		le32enc(&B[4 * k], X[k]);
+		le32enc(&B[4 * k], X[word_index(k)]);
+}
+
+/**
+ * smix_alloc(r, N, V0, V, XY0, XY):
+ * Allocate the temporary storage V (128rN bytes) and XY (256r + 64 bytes) of
+ * smix, aligned to a multiple of 64 bytes.  V0 and XY0 receive the pointers
+ * to release with smix_free.
+ *
+ * Return 0 on success; or -1 on error
+ */
+static int
+smix_alloc(size_t r, uint64_t N, void ** V0, uint32_t ** V, void ** XY0,
+    uint32_t ** XY)
+{
+#ifdef HAVE_POSIX_MEMALIGN
+	if ((errno = posix_memalign(XY0, 64, 256 * r + 64)) != 0)
+		goto err0;
+	*XY = (uint32_t *)(*XY0);
+#ifndef MAP_ANON
+	if ((errno = posix_memalign(V0, 64, 128 * r * N)) != 0)
+		goto err1;
+	*V = (uint32_t *)(*V0);
+#endif
+#else
+	if ((*XY0 = malloc(256 * r + 64 + 63)) == NULL)
+		goto err0;
+	*XY = (uint32_t *)(((uintptr_t)(*XY0) + 63) & ~ (uintptr_t)(63));
+#ifndef MAP_ANON
+	if ((*V0 = malloc(128 * r * N + 63)) == NULL)
+		goto err1;
+	*V = (uint32_t *)(((uintptr_t)(*V0) + 63) & ~ (uintptr_t)(63));
+#endif
+#endif
+#ifdef MAP_ANON
+	if ((*V0 = mmap(NULL, 128 * r * N, PROT_READ | PROT_WRITE,
+#ifdef MAP_NOCORE
+	    MAP_ANON | MAP_PRIVATE | MAP_NOCORE,
+#else
+	    MAP_ANON | MAP_PRIVATE,
+#endif
+	    -1, 0)) == MAP_FAILED)
+		goto err1;
+	*V = (uint32_t *)(*V0);
+#endif
+	return (0);
+
+err1:
+	free(*XY0);
+err0:
+	return (-1);
+}
+
+/**
+ * smix_free(r, N, V0, XY0):
+ * Release the storage allocated by smix_alloc.
+ *
+ * Return 0 on success; or -1 on error
+ */
+static int
+smix_free(size_t r, uint64_t N, void * V0, void * XY0)
+{
+	int result = 0;
+
+#ifdef MAP_ANON
+	if (munmap(V0, 128 * r * N))
+		result = -1;
+#else
+	(void)r;
+	(void)N;
+	free(V0);
+#endif
+	free(XY0);
+	return (result);
+}
+
+/**
+ * check_parameters(N, r, p):
+ * Check the scrypt cost parameters, setting errno if they are invalid.
+ *
+ * Return 0 if they are valid; or -1 otherwise
+ */
+static int
+check_parameters(uint64_t N, uint32_t r, uint32_t p)
+{
+	if ((uint64_t)(r) * (uint64_t)(p) >= (1 << 30)) {
+		errno = EFBIG;
+		return (-1);
+	}
+	if (r == 0 || p == 0) {
+		errno = EINVAL;
+		return (-1);
+	}
+	if (((N & (N - 1)) != 0) || (N < 2)) {
+		errno = EINVAL;
+		return (-1);
+	}
+	if ((r > SIZE_MAX / 128 / p) ||
+#if SIZE_MAX / 256 <= UINT32_MAX
+	    (r > SIZE_MAX / 256) ||
+#endif
+	    (N > SIZE_MAX / 128 / r)) {
+		errno = ENOMEM;
+		return (-1);
+	}
+	return (0);
+}
+
+int
+scrypt_smix(uint8_t * B, uint32_t r, uint64_t N)
+{
+	void * V0, * XY0;
+	uint32_t * V;
+	uint32_t * XY;
+
+	if (check_parameters(N, r, 1))
+		return (-1);
+	if (smix_alloc(r, N, &V0, &V, &XY0, &XY))
+		return (-1);
+
+	smix(B, r, N, V, XY);
+
+	return (smix_free(r, N, V0, XY0));
 }
 
 /**
@@ -246,64 +479,21 @@ scrypt(const uint8_t * passwd, size_t passwdlen,
 		goto err0;
 	}
 #endif
-	if ((uint64_t)(r) * (uint64_t)(p) >= (1 << 30)) {
-		errno = EFBIG;
+	if (check_parameters(N, r, p))
 		goto err0;
-	}
-	if (r == 0 || p == 0) {
-		errno = EINVAL;
-		goto err0;
-	}
-	if (((N & (N - 1)) != 0) || (N < 2)) {
-		errno = EINVAL;
-		goto err0;
-	}
-	if ((r > SIZE_MAX / 128 / p) ||
-#if SIZE_MAX / 256 <= UINT32_MAX
-	    (r > SIZE_MAX / 256) ||
-#endif
-	    (N > SIZE_MAX / 128 / r)) {
-		errno = ENOMEM;
-		goto err0;
-	}
 
 	/* Allocate memory. */
 #ifdef HAVE_POSIX_MEMALIGN
 	if ((errno = posix_memalign(&B0, 64, 128 * r * p)) != 0)
 		goto err0;
 	B = (uint8_t *)(B0);
-	if ((errno = posix_memalign(&XY0, 64, 256 * r + 64)) != 0)
-		goto err1;
-	XY = (uint32_t *)(XY0);
-#ifndef MAP_ANON
-	if ((errno = posix_memalign(&V0, 64, 128 * r * N)) != 0)
-		goto err2;
-	V = (uint32_t *)(V0);
-#endif
 #else
 	if ((B0 = malloc(128 * r * p + 63)) == NULL)
 		goto err0;
 	B = (uint8_t *)(((uintptr_t)(B0) + 63) & ~ (uintptr_t)(63));
-	if ((XY0 = malloc(256 * r + 64 + 63)) == NULL)
-		goto err1;
-	XY = (uint32_t *)(((uintptr_t)(XY0) + 63) & ~ (uintptr_t)(63));
-#ifndef MAP_ANON
-	if ((V0 = malloc(128 * r * N + 63)) == NULL)
-		goto err2;
-	V = (uint32_t *)(((uintptr_t)(V0) + 63) & ~ (uintptr_t)(63));
-#endif
-#endif
-#ifdef MAP_ANON
-	if ((V0 = mmap(NULL, 128 * r * N, PROT_READ | PROT_WRITE,
-#ifdef MAP_NOCORE
-	    MAP_ANON | MAP_PRIVATE | MAP_NOCORE,
-#else
-	    MAP_ANON | MAP_PRIVATE,
-#endif
-	    -1, 0)) == MAP_FAILED)
-		goto err2;
-	V = (uint32_t *)(V0);
 #endif
+	if (smix_alloc(r, N, &V0, &V, &XY0, &XY))
+		goto err1;
 
 	/* 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen) */
 	pbkdf2_hmac_sha256(passwd, passwdlen, salt, saltlen, 1, B, p * 128 * r);
@@ -318,20 +508,13 @@ scrypt(const uint8_t * passwd, size_t passwdlen,
 	pbkdf2_hmac_sha256(passwd, passwdlen, B, p * 128 * r, 1, buf, buflen);
 
 	/* Free memory. */
-#ifdef MAP_ANON
-	if (munmap(V0, 128 * r * N))
-		goto err2;
-#else
-	free(V0);
-#endif
-	free(XY0);
+	if (smix_free(r, N, V0, XY0))
+		goto err1;
 	free(B0);
 
 	/* Success! */
 	return (0);
 
-err2:
-	free(XY0);
 err1:
 	free(B0);
 err0:
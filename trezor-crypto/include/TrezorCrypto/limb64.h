@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2017 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __LIMB64_H__
+#define __LIMB64_H__
+
+// [wallet-core] 4x64-bit limb field arithmetic for elliptic curve point
+// multiplication on 64-bit hosts.
+//
+// bignum256 uses 9x29-bit limbs, sized for 32-bit MCUs. With USE_LIMB64 the
+// hot paths of ecdsa.c (scalar_multiply, point_multiply) convert their
+// operands once to 4x64-bit limbs in Montgomery form and use 64x64->128
+// multiplications. Inputs and outputs stay bignum256, results are identical.
+// Supports any field prime with 2**255 < p < 2**256, which covers secp256k1
+// and nist256p1.
+// Apart from the inversions, which use bn_inverse as before, all operations
+// have constant control flow and memory access with regard to secret data.
+
+#include <TrezorCrypto/bignum.h>
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/options.h>
+
+#if USE_LIMB64
+
+#if !defined(__SIZEOF_INT128__)
+#error "USE_LIMB64 requires a compiler with 128-bit integer support"
+#endif
+
+// Same contract as scalar_multiply, using the precomputed table curve->cp
+int scalar_multiply_limb64(const ecdsa_curve *curve, const bignum256 *k,
+                           curve_point *res);
+
+// Same contract as point_multiply
+int point_multiply_limb64(const ecdsa_curve *curve, const bignum256 *k,
+                          const curve_point *p, curve_point *res);
+
+#endif
+
+#endif
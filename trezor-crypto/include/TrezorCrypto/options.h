@@ -41,6 +41,11 @@
 #define USE_INVERSE_FAST 1
 #endif
 
+// use 4x64-bit limb field arithmetic for point multiplication, see limb64.h
+#ifndef USE_LIMB64
+#define USE_LIMB64 0 // [wallet-core]
+#endif
+
 // support for printing bignum256 structures via printf
 #ifndef USE_BN_PRINT
 #define USE_BN_PRINT 0
@@ -65,7 +70,7 @@
 
 // implement BIP39 caching
 #ifndef USE_BIP39_CACHE
-#define USE_BIP39_CACHE 1
+#define USE_BIP39_CACHE 0 // [wallet-core] replaced by the thread-safe TW::SeedCache
 #define BIP39_CACHE_SIZE 4
 #endif
 
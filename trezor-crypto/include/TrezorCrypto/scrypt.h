@@ -56,6 +56,16 @@ extern "C"{
 int scrypt(const uint8_t *, size_t, const uint8_t *, size_t, uint64_t,
     uint32_t, uint32_t, /*@out@*/ uint8_t *, size_t);
 
+/**
+ * scrypt_smix(B, r, N):
+ * Compute B = SMix_r(B, N) for one of the p lanes of scrypt, where B is the
+ * 128 * r bytes block B_i produced by the first PBKDF2 step.  Lanes do not
+ * depend on each other, so they can be computed concurrently; each call
+ * allocates its own 128 * r * N bytes of working memory.
+ * Return 0 on success; or -1 on error.
+ */
+int scrypt_smix(uint8_t *, uint32_t, uint64_t);
+
 #ifdef __cplusplus
 }
 #endif